@@ -0,0 +1,204 @@
+/*
+    File        aggregateindex.hpp
+    Author      Heiko Klausing (h.klausing at gmx dot de)
+    Created     2026-10-17
+
+    Note        Aggregate index (min/max/sum/count) over the buffer index of
+                a ring buffer. The buffer is split into leaves of _NLEAF
+                elements, a segment tree holds the aggregates of the leaves.
+                The values are integers (e.g. 1/100 °C), no float is used.
+    Feature list
+        - the values are read by a user function with the buffer index
+        - update(slot) has to be called after a buffer element is written,
+          the leaf of the element is recalculated (_NLEAF reads) and the
+          tree is updated in O(log n)
+        - the elements must be written in buffer index order starting at 0,
+          like the RingBuffer does; overwritten elements (wrapped buffer)
+          are handled by the leaf recalculation
+        - query(first, last) returns the aggregate of the buffer index range
+          [first, last) in O(_NLEAF + log n), the caller has to split a
+          wrapped range into two queries
+        - the tree is allocated at runtime, the RAM size is about
+          capacity / _NLEAF * 32 bytes
+
+    Usage:  int32_t readValue(size_t slot) { return buffer[slot].temperature; }
+            AggregateIndex<16> index(&readValue);
+            index.resize(1000);
+            ...
+            buffer[slot] = value;
+            index.update(slot);
+            aggregate_t result = index.query(10, 200);
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+
+// aggregated values of a range
+typedef struct
+{
+    int32_t     min;            // minimum value
+    int32_t     max;            // maximum value
+    int32_t     sum;            // sum of all values
+    uint32_t    count;          // amount of values, 0: min/max are not valid
+} aggregate_t;
+
+// combines two aggregates
+inline aggregate_t mergeAggregate(const aggregate_t &a, const aggregate_t &b)
+{
+    if(!a.count)
+        return b;
+    if(!b.count)
+        return a;
+    aggregate_t result;
+    result.min = a.min < b.min ? a.min : b.min;
+    result.max = a.max > b.max ? a.max : b.max;
+    result.sum = a.sum + b.sum;
+    result.count = a.count + b.count;
+    return result;
+}
+
+
+template <size_t _NLEAF>
+class AggregateIndex
+{
+public:
+    // returns the value of a buffer index
+    typedef int32_t (*valueReader_t)(size_t slot);
+
+private:
+    /* data */
+    valueReader_t   m_reader;       // value source
+    aggregate_t     *m_tree;        // segment tree, m_tree[1] is the root
+    size_t          m_capacity;     // amount of buffer elements
+    size_t          m_leaves;       // amount of leaves in the tree (power of two)
+    size_t          m_used;         // amount of written buffer elements
+
+    // NOTE: disable constructor, copy constructor and assignment operator
+    AggregateIndex(void) = delete;
+    AggregateIndex(const AggregateIndex&) = delete;
+    AggregateIndex& operator=(const AggregateIndex&) & = delete;
+
+public:
+    AggregateIndex(valueReader_t reader)
+        : m_reader(reader)
+        , m_tree(nullptr)
+        , m_capacity(0)
+        , m_leaves(0)
+        , m_used(0)
+    {
+        static_assert(_NLEAF > 0, "leaf size must be > 0");
+    }
+
+    ~AggregateIndex()
+    {
+        delete[] m_tree;
+    }
+
+    // allocates the tree for a buffer of capacity elements, the index is
+    // cleared; returns false if the memory is not available
+    bool resize(size_t capacity)
+    {
+        delete[] m_tree;
+        m_tree = nullptr;
+        m_capacity = 0;
+        m_leaves = 1;
+        while(m_leaves * _NLEAF < capacity)
+            m_leaves <<= 1;
+        if(capacity)
+            m_tree = new (std::nothrow) aggregate_t[2 * m_leaves];
+        if(!m_tree)
+            return !capacity;
+        m_capacity = capacity;
+        clear();
+        return true;
+    }
+
+    // clears the index, has to be called if the buffer is cleared
+    void clear()
+    {
+        m_used = 0;
+        for(size_t i = 0; i < 2 * m_leaves && m_tree; i++)
+            m_tree[i] = aggregate_t{0, 0, 0, 0};
+    }
+
+    // RAM size of the tree
+    size_t memorySize()
+    {
+        return m_tree ? 2 * m_leaves * sizeof(aggregate_t) : 0;
+    }
+
+    // has to be called after the buffer element slot was written
+    void update(size_t slot)
+    {
+        if(slot >= m_capacity)
+            return;
+        if(slot >= m_used)
+            m_used = slot + 1;
+
+        size_t leaf = slot / _NLEAF;
+        size_t node = m_leaves + leaf;
+        m_tree[node] = scan(leaf * _NLEAF, (leaf + 1) * _NLEAF);
+
+        // update the path to the root
+        for(node >>= 1; node; node >>= 1)
+            m_tree[node] = mergeAggregate(m_tree[2 * node], m_tree[2 * node + 1]);
+    }
+
+    // aggregate of the buffer index range [first, last)
+    aggregate_t query(size_t first, size_t last)
+    {
+        aggregate_t result = {0, 0, 0, 0};
+        if(last > m_used)
+            last = m_used;
+        if(first >= last)
+            return result;
+
+        size_t first_leaf = (first + _NLEAF - 1) / _NLEAF;    // first complete leaf
+        size_t last_leaf = last / _NLEAF;                       // behind the last complete leaf
+        if(first_leaf >= last_leaf) {
+            // range is inside of one or two leaves
+            return scan(first, last);
+        }
+
+        // partial leaves at the range borders ..
+        result = mergeAggregate(scan(first, first_leaf * _NLEAF), scan(last_leaf * _NLEAF, last));
+
+        // .. and complete leaves by the tree
+        size_t lo = first_leaf + m_leaves;
+        size_t hi = last_leaf + m_leaves;
+        while(lo < hi) {
+            if(lo & 1)
+                result = mergeAggregate(result, m_tree[lo++]);
+            if(hi & 1)
+                result = mergeAggregate(result, m_tree[--hi]);
+            lo >>= 1;
+            hi >>= 1;
+        }
+        return result;
+    }
+
+private:
+    // aggregate of the buffer index range [first, last) by reading the values
+    aggregate_t scan(size_t first, size_t last)
+    {
+        aggregate_t result = {0, 0, 0, 0};
+        if(last > m_used)
+            last = m_used;
+        for(size_t slot = first; slot < last; slot++) {
+            int32_t value = m_reader(slot);
+            if(!result.count) {
+                result.min = value;
+                result.max = value;
+            }
+            result.min = value < result.min ? value : result.min;
+            result.max = value > result.max ? value : result.max;
+            result.sum += value;
+            result.count++;
+        }
+        return result;
+    }
+};
@@ -0,0 +1,511 @@
+/*
+ * File         src/archive.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Date partitioned archive of the measurement values on LittleFS.
+ */
+
+#include <LittleFS.h>
+#include <TimeLib.h>
+#include <coredecls.h>
+
+#include "archive.h"
+#include "macros.h"
+
+
+// converts a measurement value to the archive format
+static archiveValue_t toArchiveValue(const measValue_t &value)
+{
+    archiveValue_t result;
+    result.timestamp = (uint32_t)value.timestamp;
+    result.temperature = value.temperature;
+    return result;
+}
+
+// start time of the day of a timestamp
+static time_t dayStart(time_t timestamp)
+{
+    return timestamp - (timestamp % SECS_PER_DAY);
+}
+
+
+Archive::Archive()
+    : m_ready{false}
+    , m_open_day{0}
+    , m_sealed_days{0}
+    , m_deleted_files{0}
+{
+}
+
+Archive::~Archive() {}
+
+bool Archive::begin(void)
+{
+    // the file system is already mounted by the flash log, begin() only checks it
+    if (!LittleFS.begin())
+    {
+        Serial.println(F("ERROR: LittleFS not available, no archive!"));
+        return false;
+    }
+    LittleFS.mkdir(ARCHIVE_DIRECTORY);
+
+    // remove files of an interrupted seal or compaction
+    Dir dir = LittleFS.openDir(ARCHIVE_DIRECTORY);
+    while (dir.next())
+    {
+        if (dir.fileName().endsWith(".tmp"))
+        {
+            LittleFS.remove(String(ARCHIVE_DIRECTORY "/") + dir.fileName());
+        }
+    }
+    m_ready = true;
+
+    if (g_ringbuffer.size())
+    {
+        // seal the finished days of the buffer that are not archived, e.g. the
+        // logger was switched off at midnight; the first day of a full buffer
+        // is not complete
+        time_t first = dayStart(g_ringbuffer.readFirst().timestamp);
+        m_open_day = dayStart(g_ringbuffer.readLast().timestamp);
+        if (g_ringbuffer.isFull())
+        {
+            first += SECS_PER_DAY;
+        }
+        for (time_t date = first; date < m_open_day; date += SECS_PER_DAY)
+        {
+            sealDay(date);
+        }
+        compactFinishedMonths();
+        applyRetention(m_open_day);
+    }
+    return true;
+}
+
+void Archive::update(const measValue_t &value)
+{
+    time_t date = dayStart(value.timestamp);
+    if (!m_open_day)
+    {
+        m_open_day = date;
+    }
+    else if (date > m_open_day)
+    {
+        // the open day is finished, all values are in the measurement buffer
+        sealDay(m_open_day);
+        m_open_day = date;
+        compactFinishedMonths();
+        applyRetention(date);
+    }
+}
+
+bool Archive::openDay(time_t date, archiveReader_t &reader)
+{
+    reader.read = 0;
+    if (!m_ready || !findDay(dayStart(date), reader.file, reader.day))
+    {
+        return false;
+    }
+    return reader.file.seek(reader.day.offset);
+}
+
+uint16_t Archive::readValues(archiveReader_t &reader, archiveValue_t *values, uint16_t count)
+{
+    if (count > reader.day.count - reader.read)
+    {
+        count = reader.day.count - reader.read;
+    }
+    if (!count)
+    {
+        return 0;
+    }
+    count = reader.file.read((uint8_t *)values, count * sizeof(archiveValue_t)) / sizeof(archiveValue_t);
+    reader.read += count;
+    return count;
+}
+
+uint16_t Archive::readDays(dayHandler_t handler)
+{
+    uint16_t result = 0;
+    if (!m_ready)
+    {
+        return 0;
+    }
+
+    archiveDay_t days[31];
+    Dir dir = LittleFS.openDir(ARCHIVE_DIRECTORY);
+    while (dir.next())
+    {
+        if (!dir.fileName().endsWith(".arc"))
+        {
+            continue;
+        }
+        File file = dir.openFile("r");
+        uint16_t count;
+        if (file && readIndex(file, days, count, 31))
+        {
+            for (uint16_t i = 0; i < count; i++)
+            {
+                handler(days[i]);
+            }
+            result += count;
+        }
+        file.close();
+        yield();
+    }
+    return result;
+}
+
+uint32_t Archive::getSealedDays(void)
+{
+    return m_sealed_days;
+}
+
+uint32_t Archive::getDeletedFiles(void)
+{
+    return m_deleted_files;
+}
+
+/*****************************************************************************
+ * private methods
+ *****************************************************************************/
+
+String Archive::dayName(time_t date)
+{
+    // the buffer takes the max. length of the int fields, too
+    char name[64];
+    struct tm ts = *gmtime(&date);
+    snprintf(name, sizeof(name), "%s/%04d-%02d-%02d.arc", ARCHIVE_DIRECTORY, ts.tm_year + 1900, ts.tm_mon + 1, ts.tm_mday);
+    return String(name);
+}
+
+String Archive::monthName(uint16_t year, uint8_t month)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "%s/%04u-%02u.arc", ARCHIVE_DIRECTORY, year, month);
+    return String(name);
+}
+
+bool Archive::findDay(time_t date, File &file, archiveDay_t &day)
+{
+    archiveDay_t days[31];
+    uint16_t count;
+
+    // a not compacted day file ..
+    file = LittleFS.open(dayName(date), "r");
+    if (!file)
+    {
+        // .. or the month file
+        struct tm ts = *gmtime(&date);
+        file = LittleFS.open(monthName(ts.tm_year + 1900, ts.tm_mon + 1), "r");
+    }
+    if (file && readIndex(file, days, count, 31))
+    {
+        for (uint16_t i = 0; i < count; i++)
+        {
+            if ((time_t)days[i].date == date)
+            {
+                day = days[i];
+                return true;
+            }
+        }
+    }
+    file.close();
+    return false;
+}
+
+bool Archive::readIndex(File &file, archiveDay_t *days, uint16_t &count, uint16_t max_count)
+{
+    file_header_t header;
+    count = 0;
+    if (!file.seek(0)
+        || file.read((uint8_t *)&header, sizeof(header)) != sizeof(header)
+        || header.magic != ARCHIVE_MAGIC
+        || header.value_size != sizeof(archiveValue_t)
+        || header.days > max_count)
+    {
+        return false;
+    }
+    if (file.read((uint8_t *)days, header.days * sizeof(archiveDay_t)) != header.days * sizeof(archiveDay_t))
+    {
+        return false;
+    }
+    count = header.days;
+    return true;
+}
+
+bool Archive::copyValues(File &source, const archiveDay_t &day, File &target)
+{
+    // the values are copied in chunks, the CRC is checked; without a target
+    // the day is only checked
+    archiveValue_t values[ARCHIVE_CHUNK_VALUES];
+    uint32_t crc = 0xffffffff;
+    if (!source.seek(day.offset))
+    {
+        return false;
+    }
+    for (size_t i = 0; i < day.count; i += ARCHIVE_CHUNK_VALUES)
+    {
+        size_t size = min(day.count - i, ARCHIVE_CHUNK_VALUES) * sizeof(archiveValue_t);
+        if (source.read((uint8_t *)values, size) != size)
+        {
+            return false;
+        }
+        crc = crc32(values, size, crc);
+        if (target && target.write((const uint8_t *)values, size) != size)
+        {
+            return false;
+        }
+    }
+    return crc == day.crc;
+}
+
+bool Archive::sealDay(time_t date)
+{
+    size_t first = findMeasValue(date);
+    size_t last = findMeasValue(date + SECS_PER_DAY);
+    File file;
+    archiveDay_t day;
+    if (!m_ready || first >= last || findDay(date, file, day))
+    {
+        // nothing to seal or the day is already archived
+        file.close();
+        return true;
+    }
+
+    // index element of the day
+    file_header_t header = {ARCHIVE_MAGIC, sizeof(archiveValue_t), 1};
+    int32_t sum = 0;
+    day.date = date;
+    day.offset = sizeof(file_header_t) + sizeof(archiveDay_t);
+    day.count = last - first > 0xffff ? 0xffff : last - first;
+    day.crc = 0xffffffff;
+    MeasBuffer_t::iterator it(&g_ringbuffer, first);
+    for (uint16_t i = 0; i < day.count; i++, ++it)
+    {
+        archiveValue_t value = toArchiveValue(*it);
+        if (!i)
+        {
+            day.min = value.temperature;
+            day.max = value.temperature;
+        }
+        day.min = value.temperature < day.min ? value.temperature : day.min;
+        day.max = value.temperature > day.max ? value.temperature : day.max;
+        sum += value.temperature;
+        day.crc = crc32(&value, sizeof(value), day.crc);
+    }
+    day.avg = (int16_t)(sum / day.count);
+
+    // write a temporary file, the day file appears complete or not at all
+    String name = dayName(date);
+    String tmp_name = name.substring(0, name.length() - 4) + ".tmp";
+    file = LittleFS.open(tmp_name, "w");
+    bool written = file
+                   && file.write((const uint8_t *)&header, sizeof(header)) == sizeof(header)
+                   && file.write((const uint8_t *)&day, sizeof(day)) == sizeof(day);
+    archiveValue_t values[ARCHIVE_CHUNK_VALUES];
+    it = MeasBuffer_t::iterator(&g_ringbuffer, first);
+    for (size_t i = 0; written && i < day.count; i += ARCHIVE_CHUNK_VALUES)
+    {
+        size_t count = min(day.count - i, ARCHIVE_CHUNK_VALUES);
+        for (size_t v = 0; v < count; v++, ++it)
+        {
+            values[v] = toArchiveValue(*it);
+        }
+        written = file.write((const uint8_t *)values, count * sizeof(archiveValue_t)) == count * sizeof(archiveValue_t);
+    }
+    file.close();
+    if (!written || !LittleFS.rename(tmp_name, name))
+    {
+        Serial.println(F("ERROR: archive write failed!"));
+        LittleFS.remove(tmp_name);
+        return false;
+    }
+    m_sealed_days++;
+    DEBUG_PRINTF2("archive: %s sealed, %u values\n", name.c_str(), day.count);
+    return true;
+}
+
+void Archive::compactFinishedMonths(void)
+{
+    // compact the months that have day files and are not the month of the open day
+    struct tm open = *gmtime(&m_open_day);
+    bool compacted = true;
+    while (compacted)
+    {
+        int file_year, file_month, file_day;
+        bool found = false;
+        Dir dir = LittleFS.openDir(ARCHIVE_DIRECTORY);
+        while (!found && dir.next())
+        {
+            found = sscanf(dir.fileName().c_str(), "%4d-%2d-%2d.arc", &file_year, &file_month, &file_day) == 3
+                    && (file_year != open.tm_year + 1900 || file_month != open.tm_mon + 1);
+        }
+        // stop if a compaction fails, the day files stay readable
+        compacted = found && compact(file_year, file_month);
+    }
+}
+
+bool Archive::compact(uint16_t year, uint8_t month)
+{
+    // index of the month file and of the day files, source 0 is the month file
+    archiveDay_t days[31];
+    uint8_t source[31];
+    uint16_t count = 0;
+    String name = monthName(year, month);
+    File month_file = LittleFS.open(name, "r");
+    memset(source, 0, sizeof(source));
+    if (month_file)
+    {
+        readIndex(month_file, days, count, 31);
+    }
+    uint16_t month_days = count;
+
+    // first day of the month
+    tmElements_t tm;
+    tm.Second = 0;
+    tm.Minute = 0;
+    tm.Hour = 0;
+    tm.Day = 1;
+    tm.Month = month;
+    tm.Year = CalendarYrToTm(year);
+    for (time_t date = makeTime(tm); gmtime(&date)->tm_mon + 1 == month; date += SECS_PER_DAY)
+    {
+        File file;
+        archiveDay_t day;
+        file = LittleFS.open(dayName(date), "r");
+        uint16_t day_count;
+        if (!file || !readIndex(file, &day, day_count, 1) || !day_count)
+        {
+            continue;
+        }
+        file.close();
+        bool duplicate = false;
+        for (uint16_t i = 0; i < month_days; i++)
+        {
+            duplicate |= days[i].date == day.date;
+        }
+        if (!duplicate && count < 31)
+        {
+            // sorted insert
+            uint16_t pos = count++;
+            for (; pos && days[pos - 1].date > day.date; pos--)
+            {
+                days[pos] = days[pos - 1];
+                source[pos] = source[pos - 1];
+            }
+            days[pos] = day;
+            source[pos] = gmtime(&date)->tm_mday;
+        }
+    }
+
+    // the new month file gets the days with valid values only
+    File none;
+    uint16_t valid = 0;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        File file = source[i] ? LittleFS.open(dayName(days[i].date), "r") : month_file;
+        if (copyValues(file, days[i], none))
+        {
+            days[valid] = days[i];
+            source[valid] = source[i];
+            valid++;
+        }
+        else
+        {
+            Serial.printf("ERROR: archive day %s is corrupt!\n", dayName(days[i].date).c_str());
+        }
+        if (source[i])
+        {
+            file.close();
+        }
+    }
+
+    String tmp_name = name.substring(0, name.length() - 4) + ".tmp";
+    File target = LittleFS.open(tmp_name, "w");
+    if (!target)
+    {
+        Serial.println(F("ERROR: archive write failed!"));
+        month_file.close();
+        return false;
+    }
+    file_header_t header = {ARCHIVE_MAGIC, sizeof(archiveValue_t), valid};
+    bool written = target.write((const uint8_t *)&header, sizeof(header)) == sizeof(header);
+
+    // index with the file positions in the month file ..
+    uint32_t offset = sizeof(file_header_t) + valid * sizeof(archiveDay_t);
+    for (uint16_t i = 0; written && i < valid; i++)
+    {
+        archiveDay_t day = days[i];
+        day.offset = offset;
+        offset += day.count * sizeof(archiveValue_t);
+        written = target.write((const uint8_t *)&day, sizeof(day)) == sizeof(day);
+    }
+    // .. and the values
+    for (uint16_t i = 0; written && i < valid; i++)
+    {
+        File file = source[i] ? LittleFS.open(dayName(days[i].date), "r") : month_file;
+        written = copyValues(file, days[i], target);
+        if (source[i])
+        {
+            file.close();
+        }
+        yield();
+    }
+    target.close();
+    month_file.close();
+
+    // the rename replaces the old month file, the day files are removed only
+    // if the month file is complete
+    if (!written || !LittleFS.rename(tmp_name, name))
+    {
+        Serial.println(F("ERROR: archive write failed!"));
+        LittleFS.remove(tmp_name);
+        return false;
+    }
+    for (time_t date = makeTime(tm); gmtime(&date)->tm_mon + 1 == month; date += SECS_PER_DAY)
+    {
+        LittleFS.remove(dayName(date));
+    }
+    Serial.printf("archive: %s compacted, %u days\n", name.c_str(), valid);
+    return true;
+}
+
+void Archive::applyRetention(time_t date)
+{
+    struct tm ts = *gmtime(&date);
+    int current = (ts.tm_year + 1900) * 12 + ts.tm_mon;
+
+    while (true)
+    {
+        // oldest archive file and the free file system space
+        FSInfo info;
+        LittleFS.info(info);
+        String oldest;
+        int oldest_month = current;
+        Dir dir = LittleFS.openDir(ARCHIVE_DIRECTORY);
+        while (dir.next())
+        {
+            int file_year, file_month;
+            if (sscanf(dir.fileName().c_str(), "%4d-%2d", &file_year, &file_month) == 2
+                && file_year * 12 + file_month - 1 < oldest_month)
+            {
+                oldest_month = file_year * 12 + file_month - 1;
+                oldest = dir.fileName();
+            }
+        }
+
+        if (oldest.isEmpty()
+            || (oldest_month > current - ARCHIVE_RETENTION_MONTHS
+                && info.totalBytes - info.usedBytes >= ARCHIVE_MIN_FREE_SPACE))
+        {
+            break;
+        }
+        LittleFS.remove(String(ARCHIVE_DIRECTORY "/") + oldest);
+        m_deleted_files++;
+        Serial.printf("archive: %s deleted\n", oldest.c_str());
+    }
+}
+
+
+// archive of the measurement values
+Archive g_archive;
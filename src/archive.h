@@ -0,0 +1,152 @@
+/*
+ * File         src/archive.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Date partitioned archive of the measurement values on LittleFS.
+ *              - a finished day is sealed from the measurement buffer into an
+ *                immutable day file "YYYY-MM-DD.arc"
+ *              - the day files of a finished month are compacted into one
+ *                month file "YYYY-MM.arc", one file system block per day is
+ *                saved
+ *              - both file types start with a header and an index of the
+ *                contained days (date, offset, count, min/avg/max, CRC), a
+ *                day is found without reading the values
+ *              - month files older than ARCHIVE_RETENTION_MONTHS are deleted,
+ *                the oldest files are deleted if the file system is too full
+ *              - the values are read in chunks, a day is never loaded
+ *                completely into the RAM
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+
+#include <functional>
+
+#include "settings.hpp"
+#include "measbuffer.hpp"
+
+
+// archived measurement value, temperature in 1/100 °C
+typedef struct __attribute__((packed))
+{
+    uint32_t timestamp;     // time of the value
+    int16_t temperature;    // temperature in 1/100 °C
+} archiveValue_t;
+
+// index element of an archived day
+typedef struct __attribute__((packed))
+{
+    uint32_t date;          // start time of the day
+    uint32_t offset;        // file position of the first value
+    uint16_t count;         // amount of values
+    int16_t min;            // minimum temperature of the day in 1/100 °C
+    int16_t avg;            // average temperature of the day in 1/100 °C
+    int16_t max;            // maximum temperature of the day in 1/100 °C
+    uint32_t crc;           // CRC32 of the values
+} archiveDay_t;
+
+// open archived day, see Archive::openDay()
+typedef struct
+{
+    File file;              // day or month file
+    archiveDay_t day;       // index element of the day
+    uint16_t read;          // amount of read values
+} archiveReader_t;
+
+
+class Archive
+{
+public:
+    // handler for the index elements of the archived days
+    typedef std::function<void(const archiveDay_t &day)> dayHandler_t;
+
+private:
+    static const uint32_t ARCHIVE_MAGIC = 0x41524331; // "ARC1"
+
+    // file header, followed by 'days' index elements and the values
+    typedef struct __attribute__((packed))
+    {
+        uint32_t magic;         // file identification
+        uint16_t value_size;    // size of a value, detects format changes
+        uint16_t days;          // amount of index elements
+    } file_header_t;
+
+    /* data */
+    bool m_ready;               // file system is mounted
+    time_t m_open_day;          // start time of the day that is not sealed
+    uint32_t m_sealed_days;     // amount of sealed days since start
+    uint32_t m_deleted_files;   // amount of deleted files since start
+
+    String dayName(time_t date);
+    String monthName(uint16_t year, uint8_t month);
+    bool findDay(time_t date, File &file, archiveDay_t &day);
+    bool readIndex(File &file, archiveDay_t *days, uint16_t &count, uint16_t max_count);
+    bool copyValues(File &source, const archiveDay_t &day, File &target);
+    bool sealDay(time_t date);
+    void compactFinishedMonths(void);
+    bool compact(uint16_t year, uint8_t month);
+    void applyRetention(time_t date);
+
+public:
+    Archive();
+    ~Archive();
+
+    /**
+     * @brief Prepares the archive directory and seals the finished days of
+     * the measurement buffer that are not archived, has to be called after
+     * the measurement buffer is restored
+     *
+     * @return true archive is usable
+     * @return false file system is not available
+     */
+    bool begin(void);
+
+    /**
+     * @brief Has to be called for each new measurement value, a finished day
+     * is sealed, compacted and the retention is applied
+     *
+     * @param value new measurement value
+     */
+    void update(const measValue_t &value);
+
+    /**
+     * @brief Opens an archived day to read the values
+     *
+     * @param date time inside of the day
+     * @param reader reader of the day
+     * @return true day was found
+     * @return false day is not archived
+     */
+    bool openDay(time_t date, archiveReader_t &reader);
+
+    /**
+     * @brief Reads the next values of an opened day
+     *
+     * @param reader reader of the day
+     * @param values buffer for the values
+     * @param count size of the buffer
+     * @return uint16_t amount of read values, 0 at the end of the day
+     */
+    uint16_t readValues(archiveReader_t &reader, archiveValue_t *values, uint16_t count);
+
+    /**
+     * @brief Calls the handler for each archived day, only the index
+     * elements are read
+     *
+     * @param handler is called for each archived day
+     * @return uint16_t amount of archived days
+     */
+    uint16_t readDays(dayHandler_t handler);
+
+    /// amount of sealed days since start
+    uint32_t getSealedDays(void);
+
+    /// amount of files deleted by the retention since start
+    uint32_t getDeletedFiles(void);
+};
+
+
+// archive of the measurement values
+extern Archive g_archive;
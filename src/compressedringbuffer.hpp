@@ -0,0 +1,446 @@
+/*
+    File        compressedringbuffer.hpp
+    Author      Heiko Klausing (h.klausing at gmx dot de)
+    Created     2026-10-17
+
+    Note        Ring buffer for time series values that stores the data
+                compressed in blocks (Gorilla like encoding). The interface
+                follows the RingBuffer in miniringbuffer.hpp.
+    Feature list
+        - data type defined by user, the type must have the members
+          'timestamp' (time_t) and 'temperature' (int16_t, 1/100 °C)
+        - the data is stored in _NBLOCKS blocks with _NBYTES bytes each
+        - timestamps are stored as delta-of-delta values, for equidistant
+          values a single bit is required
+        - temperatures are stored as delta to the previous value
+        - the first value of a block is stored uncompressed, each block
+          can be decoded without the other blocks
+        - if all blocks are used the oldest block is dropped, this removes
+          all values of the block at once
+        - content returns an estimation of the amount of storable elements
+        - size returns the amount of buffered elements
+        - readFirst/readLast return a reference to an internal decode
+          buffer, the reference is valid until the next read call
+        - sequential reading with readFirst(0), readFirst(1), ... decodes
+          each element only once
+        - forward iterators from the oldest to the newest element, usable
+          with range-for, each step decodes the next element
+        - lowerBound searches the first element of a timestamp, only the
+          block of the element is decoded
+
+    Encoding per element (after the first element of a block)
+        timestamp, zigzag value z of delta-of-delta:
+            '0'                 z == 0
+            '10'   + 7 bit      z < 2^7
+            '110'  + 12 bit     z < 2^12
+            '111'  + 32 bit     else
+        temperature, zigzag value z of delta:
+            '0'                 z == 0
+            '10'   + 6 bit      z < 2^6
+            '110'  + 10 bit     z < 2^10
+            '111'  + 16 bit     else
+
+    Usage:  CompressedRingBuffer<measValue_t, 64, 256> ringbuffer(measValue_t{0, 0});
+            ringbuffer.add(value);
+            for(size_t i=0; i < ringbuffer.size(); i++)
+                Serial.println(ringbuffer.readFirst(i).temperature);
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <iterator>
+
+
+template <typename _T, size_t _NBLOCKS, size_t _NBYTES>
+class CompressedRingBuffer
+{
+private:
+    /* Limits */
+    /// worst case size of a single encoded element in bit
+    static const uint32_t MAX_ELEMENT_BITS = (3 + 32) + (3 + 16);
+
+    typedef struct
+    {
+        uint32_t first_timestamp;   // timestamp of the first element
+        int16_t  first_temperature; // temperature of the first element
+        uint16_t count;             // amount of elements in this block
+        uint16_t bits;              // amount of used bits in data
+        uint8_t  data[_NBYTES];     // encoded elements
+    } block_t;
+
+    // decoder/encoder state of an element stream
+    typedef struct
+    {
+        uint32_t bitpos;            // read position in block data
+        uint32_t timestamp;         // last timestamp
+        int32_t  delta;             // last timestamp delta
+        int32_t  temperature;       // last quantized temperature
+    } stream_t;
+
+    /* data */
+    block_t     m_blocks[_NBLOCKS]; // buffer for data
+    size_t      m_first;            // index of the oldest block
+    size_t      m_used;             // amount of used blocks
+    size_t      m_size;             // amount of stored elements
+    stream_t    m_write;            // encoder state of the newest block
+
+    // read cache, allows sequential reads without decoding from block start
+    bool        m_cache_valid;      // m_read holds a decoded element
+    uint32_t    m_generation;       // incremented if blocks are dropped
+    uint32_t    m_cache_generation; // generation of the read cache
+    size_t      m_cache_offset;     // element offset of the cached value
+    size_t      m_cache_block;      // block index of the cached value
+    size_t      m_cache_index;      // element index in the cached block
+    stream_t    m_read;             // decoder state of the cached value
+    _T          m_value;            // decoded value
+
+    // NOTE: disable constructor, copy constructor and assignment operator
+    CompressedRingBuffer(void) = delete;
+    CompressedRingBuffer(const CompressedRingBuffer&) = delete;
+    CompressedRingBuffer& operator=(const CompressedRingBuffer&) & = delete;
+
+public:
+    // forward iterator, offset 0 is the oldest element
+    class iterator
+    {
+    private:
+        CompressedRingBuffer    *m_ring;
+        size_t                  m_offset;
+
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef _T          value_type;
+        typedef ptrdiff_t   difference_type;
+        typedef const _T*   pointer;
+        typedef const _T&   reference;
+
+        iterator() : m_ring(nullptr), m_offset(0) {}
+        iterator(CompressedRingBuffer *ring, size_t offset) : m_ring(ring), m_offset(offset) {}
+
+        reference operator*() const { return m_ring->readFirst(m_offset); }
+        pointer operator->() const { return &**this; }
+
+        iterator& operator++() { m_offset++; return *this; }
+        iterator operator++(int) { iterator it(*this); m_offset++; return it; }
+
+        bool operator==(const iterator &other) const { return m_offset == other.m_offset; }
+        bool operator!=(const iterator &other) const { return m_offset != other.m_offset; }
+
+        // offset of the element, usable with readFirst()
+        size_t offset() const { return m_offset; }
+    };
+
+    CompressedRingBuffer(_T dummy)
+        : m_first(0)
+        , m_used(0)
+        , m_size(0)
+        , m_cache_valid(false)
+        , m_generation(0)
+        , m_cache_generation(0)
+        , m_cache_offset(0)
+        , m_cache_block(0)
+        , m_cache_index(0)
+        , m_value(dummy)
+    {
+        static_assert(_NBLOCKS > 1, "at least two blocks are required");
+        static_assert(_NBYTES * 8 >= MAX_ELEMENT_BITS && _NBYTES * 8 < 0xffff, "block size must be in range 7..8191");
+    };
+
+    ~CompressedRingBuffer(){};
+
+    // no element written to the buffer
+    bool isEmpty()
+    {
+        return !m_size;
+    };
+
+    // Returns true if all blocks are in use, the next block change will
+    // drop the oldest block
+    bool isFull()
+    {
+        return m_used == _NBLOCKS;
+    };
+
+    // clears the buffer and all control elements
+    void clear()
+    {
+        m_first = 0;
+        m_used = 0;
+        m_size = 0;
+        m_generation++;
+        m_cache_valid = false;
+    }
+
+    // returns the estimated amount of storable elements, based on the
+    // compression rate of the stored elements
+    size_t content()
+    {
+        size_t bits = 0;
+        for(size_t i = 0; i < m_used; i++) {
+            bits += m_blocks[blockIndex(i)].bits;
+        }
+        if(m_size < 2 || bits == 0) {
+            // no compression rate known, expect the worst case
+            return _NBLOCKS * (_NBYTES * 8 / MAX_ELEMENT_BITS);
+        }
+        return (size_t)((uint64_t)m_size * _NBLOCKS * _NBYTES * 8 / bits);
+    }
+
+    // returns the amount of stored buffer elements
+    size_t size()
+    {
+        return m_size;
+    }
+
+    // add the next element to the buffer
+    void add(const _T data)
+    {
+        uint32_t timestamp = (uint32_t)data.timestamp;
+        int32_t temperature = data.temperature;
+
+        if(m_used) {
+            block_t &block = m_blocks[blockIndex(m_used - 1)];
+            int32_t delta = (int32_t)(timestamp - m_write.timestamp);
+            uint32_t zz_time = zigzag(delta - m_write.delta);
+            uint32_t zz_temp = zigzag(temperature - m_write.temperature);
+            uint32_t bits = timeBits(zz_time) + temperatureBits(zz_temp);
+
+            if(block.count < 0xffff && block.bits + bits <= _NBYTES * 8) {
+                // element fits to the current block
+                encodeTimestamp(block, zz_time);
+                encodeTemperature(block, zz_temp);
+                block.count++;
+                m_write.timestamp = timestamp;
+                m_write.delta = delta;
+                m_write.temperature = temperature;
+                m_size++;
+                return;
+            }
+        }
+
+        // start a new block, drop the oldest one if no block is free
+        if(m_used == _NBLOCKS) {
+            m_size -= m_blocks[m_first].count;
+            m_first = (m_first + 1) % _NBLOCKS;
+            m_used--;
+            m_generation++;
+        }
+        block_t &block = m_blocks[blockIndex(m_used)];
+        m_used++;
+        block.first_timestamp = timestamp;
+        block.first_temperature = (int16_t)temperature;
+        block.count = 1;
+        block.bits = 0;
+        m_write.timestamp = timestamp;
+        m_write.delta = 0;
+        m_write.temperature = (int16_t)temperature;
+        m_size++;
+    }
+
+    // read values from the newest to be oldest
+    // offest = 0 -> last element
+    // offest = 1 -> element before last element
+    // offset = ...
+    const _T& readLast(size_t offset=0)
+    {
+        if(!m_size)
+            return m_value;
+        size_t offsetValue = offset % m_size;
+        return readFirst(m_size - 1 - offsetValue);
+    }
+
+    // read elements from the oldest to the newest
+    const _T& readFirst(size_t offset=0)
+    {
+        if(!m_size)
+            return m_value;
+        size_t offsetValue = offset % m_size;
+
+        bool cached = m_cache_valid && m_cache_generation == m_generation;
+        if(cached && offsetValue == m_cache_offset + 1
+            && m_cache_index + 1 < m_blocks[m_cache_block].count) {
+            // next element of the same block
+            decodeNext(m_blocks[m_cache_block]);
+            m_cache_index++;
+        }
+        else if(!cached || offsetValue != m_cache_offset) {
+            // search the block of the element ..
+            size_t block_offset = offsetValue;
+            size_t block_id = 0;
+            while(block_offset >= m_blocks[blockIndex(block_id)].count) {
+                block_offset -= m_blocks[blockIndex(block_id)].count;
+                block_id++;
+            }
+            // .. and decode the block up to the element
+            m_cache_block = blockIndex(block_id);
+            decodeStart(m_blocks[m_cache_block]);
+            for(m_cache_index = 0; m_cache_index < block_offset; m_cache_index++) {
+                decodeNext(m_blocks[m_cache_block]);
+            }
+        }
+        m_cache_offset = offsetValue;
+        m_cache_generation = m_generation;
+        m_cache_valid = true;
+
+        m_value.timestamp = (time_t)m_read.timestamp;
+        m_value.temperature = (int16_t)m_read.temperature;
+        return m_value;
+    }
+
+    // returns the offset of the first element with a timestamp >= timestamp,
+    // size() if all elements are older; the timestamps must be ascending
+    size_t lowerBound(time_t timestamp)
+    {
+        uint32_t value = (uint32_t)timestamp;
+        size_t offset = 0;
+        size_t block_id = 0;
+
+        // skip all blocks that end before the timestamp
+        while(block_id + 1 < m_used && m_blocks[blockIndex(block_id + 1)].first_timestamp <= value) {
+            offset += m_blocks[blockIndex(block_id)].count;
+            block_id++;
+        }
+        // search the element in the block
+        while(offset < m_size && (uint32_t)readFirst(offset).timestamp < value) {
+            offset++;
+        }
+        return offset;
+    }
+
+    // iterator to the oldest element
+    iterator begin()
+    {
+        return iterator(this, 0);
+    }
+
+    // iterator behind the newest element
+    iterator end()
+    {
+        return iterator(this, m_size);
+    }
+
+private:
+    size_t blockIndex(size_t block_id)
+    {
+        return (m_first + block_id) % _NBLOCKS;
+    }
+
+    static uint32_t zigzag(int32_t value)
+    {
+        return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+    }
+
+    static int32_t unzigzag(uint32_t value)
+    {
+        return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+    }
+
+    static uint32_t timeBits(uint32_t zz)
+    {
+        if(zz == 0)
+            return 1;
+        if(zz < (1UL << 7))
+            return 2 + 7;
+        if(zz < (1UL << 12))
+            return 3 + 12;
+        return 3 + 32;
+    }
+
+    static uint32_t temperatureBits(uint32_t zz)
+    {
+        if(zz == 0)
+            return 1;
+        if(zz < (1UL << 6))
+            return 2 + 6;
+        if(zz < (1UL << 10))
+            return 3 + 10;
+        return 3 + 16;
+    }
+
+    static void writeBits(block_t &block, uint32_t value, uint8_t count)
+    {
+        while(count--) {
+            uint16_t byte = block.bits >> 3;
+            uint8_t mask = 0x80 >> (block.bits & 7);
+            if(value & (1UL << count))
+                block.data[byte] |= mask;
+            else
+                block.data[byte] &= ~mask;
+            block.bits++;
+        }
+    }
+
+    uint32_t readBits(const block_t &block, uint8_t count)
+    {
+        uint32_t value = 0;
+        while(count--) {
+            value <<= 1;
+            if(block.data[m_read.bitpos >> 3] & (0x80 >> (m_read.bitpos & 7)))
+                value |= 1;
+            m_read.bitpos++;
+        }
+        return value;
+    }
+
+    void encodeTimestamp(block_t &block, uint32_t zz)
+    {
+        if(zz == 0) {
+            writeBits(block, 0b0, 1);
+        } else if(zz < (1UL << 7)) {
+            writeBits(block, 0b10, 2);
+            writeBits(block, zz, 7);
+        } else if(zz < (1UL << 12)) {
+            writeBits(block, 0b110, 3);
+            writeBits(block, zz, 12);
+        } else {
+            writeBits(block, 0b111, 3);
+            writeBits(block, zz, 32);
+        }
+    }
+
+    void encodeTemperature(block_t &block, uint32_t zz)
+    {
+        if(zz == 0) {
+            writeBits(block, 0b0, 1);
+        } else if(zz < (1UL << 6)) {
+            writeBits(block, 0b10, 2);
+            writeBits(block, zz, 6);
+        } else if(zz < (1UL << 10)) {
+            writeBits(block, 0b110, 3);
+            writeBits(block, zz, 10);
+        } else {
+            writeBits(block, 0b111, 3);
+            writeBits(block, zz, 16);
+        }
+    }
+
+    // reads the prefix code of an element field and returns the bit count of the value
+    uint8_t readPrefix(const block_t &block, uint8_t bits1, uint8_t bits2, uint8_t bits3)
+    {
+        if(!readBits(block, 1))
+            return 0;
+        if(!readBits(block, 1))
+            return bits1;
+        if(!readBits(block, 1))
+            return bits2;
+        return bits3;
+    }
+
+    void decodeStart(const block_t &block)
+    {
+        m_read.bitpos = 0;
+        m_read.timestamp = block.first_timestamp;
+        m_read.delta = 0;
+        m_read.temperature = block.first_temperature;
+    }
+
+    void decodeNext(const block_t &block)
+    {
+        m_read.delta += unzigzag(readBits(block, readPrefix(block, 7, 12, 32)));
+        m_read.timestamp += m_read.delta;
+        m_read.temperature += unzigzag(readBits(block, readPrefix(block, 6, 10, 16)));
+    }
+};
@@ -12,6 +12,7 @@
 //#include "../../MyWiFiAccess.h"
 #include "parameter.hpp"
 #include "settingshandler.h"
+#include "measbuffer.hpp"
 
 // define connect WiFi state variable
 connect_wifi_state_t wifi_server_state = {0, false};
@@ -53,6 +54,7 @@ void connectWiFi()
     case InputStatus::Write:
         saveConfig();
         // reset
+        saveMeasBuffer();
         ESP.restart();
         break;
     default:
@@ -71,6 +73,7 @@ void connectWiFi()
 
     if(restart_counter < millis()){
       Serial.println(F("\nERROR: connect timeout, try restart!"));
+      saveMeasBuffer();
       ESP.restart();
     }
   }
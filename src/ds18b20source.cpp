@@ -0,0 +1,96 @@
+/*
+ * File         src/ds18b20source.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Sensor source of the DS18B20 sensors on the 1-wire bus.
+ */
+
+#include "ds18b20source.h"
+
+
+DS18B20Source::DS18B20Source(uint8_t pin)
+{
+    // Setup a oneWire instance to communicate with any OneWire devices
+    m_onewire = new OneWire(pin);
+
+    // Pass our oneWire reference to Dallas Temperature sensor
+    m_ds18b20 = new DallasTemperature(m_onewire);
+}
+
+DS18B20Source::~DS18B20Source() {}
+
+uint8_t DS18B20Source::begin(SerialCode_t *codes, uint8_t max_count)
+{
+    m_ds18b20->begin();
+    // the conversion end is checked by the Measurement
+    m_ds18b20->setWaitForConversion(false);
+
+    // get serial codes of the used DS18B20, the bus is searched only once
+    uint8_t count = m_ds18b20->getDeviceCount();
+    uint8_t found = 0;
+    for (uint8_t i = 0; i < count && found < max_count; i++)
+    {
+        if (m_ds18b20->getAddress(codes[found], i))
+        {
+            found++;
+        }
+    }
+    return found;
+}
+
+void DS18B20Source::startConversion(void)
+{
+    // start the conversion of all sensors at the same time (skip ROM, Convert T),
+    // the strong pull up is required in parasite power mode
+    m_onewire->reset();
+    m_onewire->skip();
+    m_onewire->write(0x44, m_ds18b20->isParasitePowerMode());
+}
+
+bool DS18B20Source::isConversionComplete(void)
+{
+    return m_ds18b20->isConversionComplete();
+}
+
+bool DS18B20Source::isParasitePowerMode(void)
+{
+    return m_ds18b20->isParasitePowerMode();
+}
+
+uint32_t DS18B20Source::getConversionWait(uint8_t resolution)
+{
+    return m_ds18b20->millisToWaitForConversion(resolution);
+}
+
+bool DS18B20Source::readScratchPad(const uint8_t *code, uint8_t *scratchpad)
+{
+    return m_ds18b20->readScratchPad(code, scratchpad);
+}
+
+void DS18B20Source::writeScratchPad(const uint8_t *code, uint8_t th, uint8_t tl, uint8_t config)
+{
+    m_onewire->reset();
+    m_onewire->select(code);
+    m_onewire->write(0x4E); // write scratchpad
+    m_onewire->write(th);
+    m_onewire->write(tl);
+    m_onewire->write(config);
+    m_onewire->reset();
+}
+
+uint8_t DS18B20Source::alarmSearch(SerialCode_t *codes, uint8_t max_count)
+{
+    // one search pass per sensor with an alarm, a single short pass without alarm
+    uint8_t found = 0;
+    m_ds18b20->resetAlarmSearch();
+    while (found < max_count && m_ds18b20->alarmSearch(codes[found]))
+    {
+        found++;
+    }
+    return found;
+}
+
+const char *DS18B20Source::getName(void)
+{
+    return "DS18B20";
+}
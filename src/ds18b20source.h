@@ -0,0 +1,41 @@
+/*
+ * File         src/ds18b20source.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Sensor source of the DS18B20 sensors on the 1-wire bus.
+ *              The conversion of all sensors is started with one skip ROM
+ *              Convert T command, the sensors are read by their ROM code.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <OneWire.h>
+#include <DallasTemperature.h>
+
+#include "sensorsource.h"
+
+
+class DS18B20Source : public SensorSource
+{
+private:
+    // Setup a oneWire instance to communicate with any OneWire devices
+    OneWire *m_onewire;
+
+    // Pass our oneWire reference to Dallas Temperature sensor
+    DallasTemperature *m_ds18b20;
+
+public:
+    DS18B20Source(uint8_t pin);
+    ~DS18B20Source();
+
+    uint8_t begin(SerialCode_t *codes, uint8_t max_count) override;
+    void startConversion(void) override;
+    bool isConversionComplete(void) override;
+    bool isParasitePowerMode(void) override;
+    uint32_t getConversionWait(uint8_t resolution) override;
+    bool readScratchPad(const uint8_t *code, uint8_t *scratchpad) override;
+    void writeScratchPad(const uint8_t *code, uint8_t th, uint8_t tl, uint8_t config) override;
+    uint8_t alarmSearch(SerialCode_t *codes, uint8_t max_count) override;
+    const char *getName(void) override;
+};
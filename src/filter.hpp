@@ -0,0 +1,316 @@
+/*
+ * File         src/filter.hpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Streaming filters of the sample path, composed at compile time.
+ *              The values are fixed point integers (see fixedpoint.hpp), the
+ *              stages use no float.
+ *              A stage has a method bool process(int32_t in, int32_t &out), it
+ *              returns false if no value is delivered (decimation), and a
+ *              static method name(). The stages are plain data without
+ *              constructors and heap memory, a zero initialized stage is an
+ *              empty filter.
+ *              Stages:
+ *              - MedianFilter<N>      sliding median of the last N values;
+ *                                     the window is kept sorted, an update
+ *                                     moves at most N values, no sort
+ *              - HampelFilter<N,K,M>  replaces a value by the median if it
+ *                                     differs more than K/10 * 1.4826 * MAD
+ *                                     (min. M in units of the values) from
+ *                                     the median
+ *              - EmaFilter<A>         exponential smoothing, alpha A/1000
+ *              - DecimateFilter<N>    mean of N values, one value per N
+ *                                     values (oversampling: 4^n values of a
+ *                                     dithered signal add n bits)
+ *              FilterChain<Stages...> runs the stages in sequence, the CPU
+ *              cycles of each stage are summed up per chain type.
+ *
+ *    Usage:    FilterChain<HampelFilter<5, 30, 32>, EmaFilter<300>> filter = {};
+ *              int32_t value;
+ *              if (filter.process(raw, value))
+ *                  add(value);
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#include "fixedpoint.hpp"
+
+
+// CPU cost of a filter stage
+typedef struct
+{
+    uint32_t cycles;        // sum of the CPU cycles
+    uint32_t calls;         // amount of calls
+} filterCost_t;
+
+// CPU cycle counter for the cost of the stages, 0 if not available
+inline uint32_t filterCycles(void)
+{
+#ifdef ARDUINO_ARCH_ESP8266
+    return ESP.getCycleCount();
+#else
+    return 0;
+#endif
+}
+
+
+template <size_t _NSIZE>
+class MedianFilter
+{
+    static_assert(_NSIZE >= 1 && _NSIZE <= 255, "median window has to be 1..255");
+
+protected:
+    int32_t m_window[_NSIZE];   // values in arrival order (ring)
+    int32_t m_sorted[_NSIZE];   // values sorted ascending
+    uint8_t m_count;            // amount of values in the window
+    uint8_t m_pos;              // position of the oldest value in the ring
+
+    // replaces the oldest value of the window by a new value
+    void insert(int32_t value)
+    {
+        uint8_t i;
+        if (m_count < _NSIZE)
+        {
+            m_window[m_count] = value;
+            i = m_count++;
+        }
+        else
+        {
+            // remove the oldest value from the sorted values
+            int32_t oldest = m_window[m_pos];
+            m_window[m_pos] = value;
+            m_pos = m_pos + 1u < _NSIZE ? m_pos + 1 : 0;
+            i = 0;
+            while (m_sorted[i] != oldest)
+            {
+                i++;
+            }
+            for (; i + 1u < _NSIZE; i++)
+            {
+                m_sorted[i] = m_sorted[i + 1];
+            }
+        }
+        // insert the new value, the last element is free
+        while (i > 0 && m_sorted[i - 1] > value)
+        {
+            m_sorted[i] = m_sorted[i - 1];
+            i--;
+        }
+        m_sorted[i] = value;
+    }
+
+    // median of the window
+    int32_t median(void)
+    {
+        return m_count & 1 ? m_sorted[m_count / 2] : (m_sorted[m_count / 2 - 1] + m_sorted[m_count / 2]) / 2;
+    }
+
+public:
+    static const char *name(void)
+    {
+        return "median";
+    }
+
+    bool process(int32_t in, int32_t &out)
+    {
+        insert(in);
+        out = median();
+        return true;
+    }
+};
+
+
+template <size_t _NSIZE, uint16_t _K_TENTHS, uint16_t _MIN_LIMIT>
+class HampelFilter : public MedianFilter<_NSIZE>
+{
+public:
+    static const char *name(void)
+    {
+        return "hampel";
+    }
+
+    bool process(int32_t in, int32_t &out)
+    {
+        this->insert(in);
+        int32_t median = this->median();
+
+        // median absolute deviation, the deviations of the sorted values are
+        // falling to the median and rising from it: merge of two sorted lists
+        int lower = this->m_count / 2;
+        int upper = lower + 1;
+        if (!(this->m_count & 1))
+        {
+            lower--;
+        }
+        int32_t mad = 0;
+        for (uint8_t n = 0; n <= (this->m_count - 1) / 2; n++)
+        {
+            int32_t down = lower >= 0 ? median - this->m_sorted[lower] : INT32_MAX;
+            int32_t up = upper < this->m_count ? this->m_sorted[upper] - median : INT32_MAX;
+            if (down <= up)
+            {
+                mad = down;
+                lower--;
+            }
+            else
+            {
+                mad = up;
+                upper++;
+            }
+        }
+
+        // a quantized stable value has a MAD of 0, the min. threshold keeps small changes
+        int32_t limit = (int32_t)((int64_t)mad * _K_TENTHS * 14826 / 100000);
+        limit = limit > _MIN_LIMIT ? limit : _MIN_LIMIT;
+        out = abs(in - median) > limit ? median : in;
+        return true;
+    }
+};
+
+
+template <uint16_t _ALPHA_PERMILLE>
+class EmaFilter
+{
+    static_assert(_ALPHA_PERMILLE > 0 && _ALPHA_PERMILLE <= 1000, "alpha has to be 1..1000");
+
+private:
+    // fraction bits of the smoothed value, a small change is not lost by the rounding
+    static const uint8_t FRACTION_BITS = 4;
+
+    int32_t m_value;            // smoothed value << FRACTION_BITS
+    bool m_started;             // the first value was processed
+
+public:
+    static const char *name(void)
+    {
+        return "ema";
+    }
+
+    bool process(int32_t in, int32_t &out)
+    {
+        int32_t value = in * (1 << FRACTION_BITS);
+        m_value = m_started ? m_value + (value - m_value) * _ALPHA_PERMILLE / 1000 : value;
+        m_started = true;
+        out = (m_value + (1 << (FRACTION_BITS - 1))) >> FRACTION_BITS;
+        return true;
+    }
+};
+
+
+template <uint16_t _NSIZE>
+class DecimateFilter
+{
+    static_assert(_NSIZE >= 1, "decimation factor has to be >= 1");
+
+private:
+    int32_t m_sum;              // sum of the collected values
+    uint16_t m_count;           // amount of collected values
+
+public:
+    static const char *name(void)
+    {
+        return "decimate";
+    }
+
+    bool process(int32_t in, int32_t &out)
+    {
+        m_sum += in;
+        if (++m_count < _NSIZE)
+        {
+            return false;
+        }
+        // rounded mean, the decimated value keeps the fraction bits of the scale
+        out = divRound(m_sum, _NSIZE);
+        m_sum = 0;
+        m_count = 0;
+        return true;
+    }
+};
+
+
+// stages of a chain from stage _INDEX, see FilterChain
+template <size_t _INDEX, typename... _STAGES>
+class FilterStages;
+
+template <size_t _INDEX>
+class FilterStages<_INDEX>
+{
+public:
+    bool process(int32_t in, int32_t &out)
+    {
+        out = in;
+        return true;
+    }
+
+    static const filterCost_t *cost(size_t)
+    {
+        return nullptr;
+    }
+
+    static const char *name(size_t)
+    {
+        return nullptr;
+    }
+};
+
+template <size_t _INDEX, typename _STAGE, typename... _REST>
+class FilterStages<_INDEX, _STAGE, _REST...>
+{
+private:
+    _STAGE m_stage;
+    FilterStages<_INDEX + 1, _REST...> m_rest;
+    static filterCost_t s_cost;
+
+public:
+    bool process(int32_t in, int32_t &out)
+    {
+        uint32_t start = filterCycles();
+        int32_t value;
+        bool ready = m_stage.process(in, value);
+        s_cost.cycles += filterCycles() - start;
+        s_cost.calls++;
+        return ready && m_rest.process(value, out);
+    }
+
+    static const filterCost_t *cost(size_t stage)
+    {
+        return stage == _INDEX ? &s_cost : FilterStages<_INDEX + 1, _REST...>::cost(stage);
+    }
+
+    static const char *name(size_t stage)
+    {
+        return stage == _INDEX ? _STAGE::name() : FilterStages<_INDEX + 1, _REST...>::name(stage);
+    }
+};
+
+template <size_t _INDEX, typename _STAGE, typename... _REST>
+filterCost_t FilterStages<_INDEX, _STAGE, _REST...>::s_cost;
+
+
+template <typename... _STAGES>
+class FilterChain : public FilterStages<0, _STAGES...>
+{
+public:
+    /// amount of stages
+    static constexpr size_t STAGES = sizeof...(_STAGES);
+
+    /**
+     * @brief Returns the CPU cost of a stage, summed up for all chains of
+     * this type
+     *
+     * @param stage stage number 0..STAGES-1
+     * @return const filterCost_t* cost, nullptr for an unknown stage
+     */
+    static const filterCost_t *getCost(size_t stage)
+    {
+        return FilterStages<0, _STAGES...>::cost(stage);
+    }
+
+    /// name of a stage, nullptr for an unknown stage
+    static const char *getName(size_t stage)
+    {
+        return FilterStages<0, _STAGES...>::name(stage);
+    }
+};
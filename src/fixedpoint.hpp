@@ -0,0 +1,116 @@
+/*
+ * File         src/fixedpoint.hpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Fixed point temperatures, the ESP8266 has no FPU.
+ *              The sample path (filter, store window, governor) uses 1/128 °C,
+ *              the raw DS18B20 value (1/16 °C) shifted by 3 bits; the extra
+ *              bits keep the fraction of filtered and averaged values.
+ *              The stored values (measurement buffer, rollups, archive) use
+ *              1/100 °C in an int16_t and are formatted without float.
+ *
+ *    Usage:    int16_t centi = fixedToCenti(rawToFixed(raw));
+ *              char buf[TEMP_FORMAT_SIZE];
+ *              Serial.println(formatTemp(buf, centi, 2));     // "21.56"
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+
+/// scale of the sample path, 1/128 °C
+constexpr int32_t TEMP_FIXED_SCALE = 128;
+/// scale of the stored values, 1/100 °C
+constexpr int32_t TEMP_CENTI_SCALE = 100;
+/// buffer size of a formatted temperature, an int32_t value with sign, point and the terminating 0
+constexpr size_t TEMP_FORMAT_SIZE = 16;
+
+// divides with rounding to the nearest integer, divisor > 0
+inline int32_t divRound(int32_t value, int32_t divisor)
+{
+    return value >= 0 ? (value + divisor / 2) / divisor : -((-value + divisor / 2) / divisor);
+}
+
+// converts a raw DS18B20 value (1/16 °C) to the sample path scale
+inline int32_t rawToFixed(int16_t raw)
+{
+    return (int32_t)raw * (TEMP_FIXED_SCALE / 16);
+}
+
+// converts a temperature constant [°C] to the sample path scale, for settings only
+constexpr int32_t celsiusToFixed(float celsius)
+{
+    return (int32_t)(celsius * TEMP_FIXED_SCALE + (celsius < 0 ? -0.5f : 0.5f));
+}
+
+// converts a sample path value to 1/100 °C, limited to int16_t
+inline int16_t fixedToCenti(int32_t value)
+{
+    int32_t centi = divRound(value * TEMP_CENTI_SCALE, TEMP_FIXED_SCALE);
+    return centi > INT16_MAX ? INT16_MAX : centi < INT16_MIN ? INT16_MIN : (int16_t)centi;
+}
+
+// converts 1/100 °C to the sample path scale
+inline int32_t centiToFixed(int32_t centi)
+{
+    return divRound(centi * TEMP_FIXED_SCALE, TEMP_CENTI_SCALE);
+}
+
+// integer square root, rounded down
+inline uint32_t isqrt(uint64_t value)
+{
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > value)
+    {
+        bit >>= 2;
+    }
+    while (bit)
+    {
+        if (value >= root + bit)
+        {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)root;
+}
+
+/**
+ * @brief Formats a temperature in 1/100 °C as decimal number without float,
+ * the value is rounded to the decimals
+ *
+ * @param buf buffer with at least TEMP_FORMAT_SIZE bytes
+ * @param centi temperature [1/100 °C]
+ * @param decimals amount of decimals 0..2
+ * @return char* buf, usable as sprintf() argument
+ */
+inline char *formatTemp(char *buf, int32_t centi, uint8_t decimals)
+{
+    static const int32_t divisors[] = {100, 10, 1};
+    int32_t value = divRound(centi, divisors[decimals]);
+    uint32_t digits = value < 0 ? -value : value;
+    char *pos = buf + TEMP_FORMAT_SIZE - 1;
+    *pos = '\0';
+    // digits from the right, the integer part has at least one digit
+    for (uint8_t i = 0; i <= decimals || digits; i++)
+    {
+        if (i == decimals && decimals)
+        {
+            *--pos = '.';
+        }
+        *--pos = '0' + digits % 10;
+        digits /= 10;
+    }
+    if (value < 0)
+    {
+        *--pos = '-';
+    }
+    return (char *)memmove(buf, pos, buf + TEMP_FORMAT_SIZE - pos);
+}
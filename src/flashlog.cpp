@@ -0,0 +1,258 @@
+/*
+ * File         src/flashlog.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Append only log of the measurement values on LittleFS.
+ */
+
+#include <LittleFS.h>
+#include <coredecls.h>
+
+#include "flashlog.h"
+#include "macros.h"
+
+
+FlashLog::FlashLog()
+    : m_saved_values{0}
+    , m_ready{false}
+    , m_sequence{0}
+    , m_segment{0}
+    , m_segment_pages{0}
+    , m_page_writes{0}
+    , m_recovery_time{0}
+    , m_restored_values{0}
+{
+    m_page.header.count = 0;
+}
+
+FlashLog::~FlashLog() {}
+
+bool FlashLog::begin(void)
+{
+    if (!LittleFS.begin())
+    {
+        Serial.println(F("ERROR: LittleFS not available, no flash log!"));
+        return false;
+    }
+    LittleFS.mkdir(FLASHLOG_DIRECTORY);
+
+    // the segment with the highest sequence number is the current one
+    page_t page;
+    bool found = false;
+    for (uint8_t segment = 0; segment < FLASHLOG_SEGMENTS; segment++)
+    {
+        File file = LittleFS.open(segmentName(segment), "r");
+        if (!file)
+            continue;
+        uint16_t pages = file.size() / sizeof(page_t);
+        // the last valid page has the highest sequence number of the segment
+        uint16_t valid_pages = findLastPage(file, pages, page);
+        if (valid_pages && (!found || page.header.sequence >= m_sequence))
+        {
+            found = true;
+            m_sequence = page.header.sequence + 1;
+            m_segment = segment;
+            m_segment_pages = pages;
+            m_page.header.count = 0;
+            m_saved_values = 0;
+            if (valid_pages < pages || file.size() % sizeof(page_t))
+            {
+                // interrupted page write, continue with the next segment
+                m_segment_pages = FLASHLOG_SEGMENT_PAGES;
+            }
+            else if (page.header.count < FLASHLOG_PAGE_VALUES)
+            {
+                // the partial page of the last flush() is completed
+                m_page = page;
+                m_saved_values = page.header.count;
+            }
+        }
+        file.close();
+    }
+
+    m_ready = true;
+    DEBUG_PRINTF3("flash log: segment %u, pages %u, sequence %u\n", m_segment, m_segment_pages, m_sequence);
+    return true;
+}
+
+uint32_t FlashLog::restore(restoreHandler_t handler)
+{
+    uint32_t start = millis();
+    m_restored_values = 0;
+    if (!m_ready)
+        return 0;
+
+    // the segment behind the current one is the oldest one
+    page_t page;
+    uint32_t next_sequence = 0;
+    for (uint8_t i = 1; i <= FLASHLOG_SEGMENTS; i++)
+    {
+        uint8_t segment = (m_segment + i) % FLASHLOG_SEGMENTS;
+        File file = LittleFS.open(segmentName(segment), "r");
+        if (!file)
+            continue;
+        while (readPage(file, page))
+        {
+            // ignore pages of an older write circle
+            if (page.header.sequence < next_sequence)
+                continue;
+            next_sequence = page.header.sequence + 1;
+            for (uint16_t v = 0; v < page.header.count; v++)
+            {
+                handler(page.values[v]);
+                m_restored_values++;
+            }
+        }
+        file.close();
+        yield();
+    }
+
+    m_recovery_time = millis() - start;
+    Serial.printf("flash log: %u values restored in %u ms\n", m_restored_values, m_recovery_time);
+    return m_restored_values;
+}
+
+void FlashLog::add(const measValue_t &value)
+{
+    m_page.values[m_page.header.count++] = value;
+    if (m_page.header.count == FLASHLOG_PAGE_VALUES)
+    {
+        writePage();
+    }
+}
+
+void FlashLog::flush(void)
+{
+    if (m_page.header.count > m_saved_values)
+    {
+        writePage();
+    }
+}
+
+uint32_t FlashLog::getPageWrites(void)
+{
+    return m_page_writes;
+}
+
+uint32_t FlashLog::getRecoveryTime(void)
+{
+    return m_recovery_time;
+}
+
+uint32_t FlashLog::getRestoredValues(void)
+{
+    return m_restored_values;
+}
+
+/*****************************************************************************
+ * private methods
+ *****************************************************************************/
+
+String FlashLog::segmentName(uint8_t segment)
+{
+    char name[32];
+    sprintf(name, "%s/%02u.log", FLASHLOG_DIRECTORY, segment);
+    return String(name);
+}
+
+bool FlashLog::readPage(File &file, page_t &page)
+{
+    // read pages until a valid page or the file end is found
+    while (file.read((uint8_t *)&page, sizeof(page_t)) == sizeof(page_t))
+    {
+        if (isValidPage(page))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint16_t FlashLog::findLastPage(File &file, uint16_t pages, page_t &page)
+{
+    // a torn page write leaves an invalid page at the segment end, the
+    // pages before are still valid
+    for (uint16_t valid_pages = pages; valid_pages; valid_pages--)
+    {
+        if (file.seek((valid_pages - 1) * sizeof(page_t))
+            && file.read((uint8_t *)&page, sizeof(page_t)) == sizeof(page_t)
+            && isValidPage(page))
+        {
+            return valid_pages;
+        }
+    }
+    return 0;
+}
+
+bool FlashLog::isValidPage(page_t &page)
+{
+    return page.header.magic == PAGE_MAGIC
+           && page.header.value_size == sizeof(measValue_t)
+           && page.header.count <= FLASHLOG_PAGE_VALUES
+           && page.header.crc == pageCrc(page);
+}
+
+uint32_t FlashLog::pageCrc(page_t &page)
+{
+    uint32_t crc = page.header.crc;
+    page.header.crc = 0;
+    uint32_t result = crc32(&page, sizeof(page_header_t) + page.header.count * sizeof(measValue_t));
+    page.header.crc = crc;
+    return result;
+}
+
+void FlashLog::writePage(void)
+{
+    if (!m_ready)
+    {
+        m_page.header.count = 0;
+        return;
+    }
+
+    // a saved partial page is replaced with its sequence number, the last page of the segment
+    const char *mode = "r+";
+    if (!m_saved_values)
+    {
+        // start the next segment if the current one is full, the oldest segment is overwritten
+        mode = "a";
+        if (m_segment_pages >= FLASHLOG_SEGMENT_PAGES)
+        {
+            m_segment = (m_segment + 1) % FLASHLOG_SEGMENTS;
+            m_segment_pages = 0;
+            mode = "w";
+        }
+        m_page.header.sequence = m_sequence++;
+    }
+
+    m_page.header.magic = PAGE_MAGIC;
+    m_page.header.value_size = sizeof(measValue_t);
+    m_page.header.crc = 0;
+    m_page.header.crc = pageCrc(m_page);
+
+    File file = LittleFS.open(segmentName(m_segment), mode);
+    if (file && (!m_saved_values || file.seek((m_segment_pages - 1) * sizeof(page_t))))
+    {
+        // always write a complete page, the page position is fixed in the file
+        file.write((const uint8_t *)&m_page, sizeof(page_t));
+        file.close();
+        m_segment_pages += m_saved_values ? 0 : 1;
+        m_page_writes++;
+        m_saved_values = m_page.header.count;
+    }
+    else
+    {
+        Serial.println(F("ERROR: flash log write failed!"));
+        m_saved_values = 0;
+        m_page.header.count = 0;
+    }
+    // a full page is closed, the next values start the next page
+    if (m_page.header.count == FLASHLOG_PAGE_VALUES)
+    {
+        m_saved_values = 0;
+        m_page.header.count = 0;
+    }
+}
+
+
+// flash log of the measurement values
+FlashLog g_flashlog;
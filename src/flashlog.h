@@ -0,0 +1,118 @@
+/*
+ * File         src/flashlog.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Append only log of the measurement values on LittleFS.
+ *              The values are collected in RAM and written as pages of
+ *              FLASHLOG_PAGE_VALUES values, each page has a sequence
+ *              number and a CRC (16 byte header + 30 * 18 byte values =
+ *              556 byte). The pages are written to FLASHLOG_SEGMENTS files
+ *              in a circle, a full file is continued with the next file,
+ *              the oldest file is overwritten.
+ *              A partial page (flush() before a restart) is written again
+ *              in place until it is full, a restart does not use up a page
+ *              of the segment.
+ *              At start the valid pages are read in sequence order and the
+ *              measurement buffer is rebuilt, a torn last page of a segment
+ *              is skipped.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+
+#include "settings.hpp"
+#include "measbuffer.hpp"
+
+
+class FlashLog
+{
+public:
+    // handler for restored values
+    typedef void (*restoreHandler_t)(const measValue_t &value);
+
+private:
+    static const uint32_t PAGE_MAGIC = 0x4c4f4731; // "LOG1"
+
+    // page header
+    typedef struct
+    {
+        uint32_t magic;         // page identification
+        uint32_t sequence;      // page number, increments with each page
+        uint16_t count;         // amount of values in this page
+        uint16_t value_size;    // size of a value, detects format changes
+        uint32_t crc;           // CRC32 of the header (crc = 0) and the values
+    } page_header_t;
+
+    typedef struct
+    {
+        page_header_t header;
+        measValue_t values[FLASHLOG_PAGE_VALUES];
+    } page_t;
+
+    /* data */
+    page_t m_page;              // page in RAM, collects the next values
+    uint16_t m_saved_values;    // values of m_page in the flash, > 0: the page is written again in place
+    bool m_ready;               // file system is mounted
+    uint32_t m_sequence;        // sequence number of the next page
+    uint8_t m_segment;          // current segment file
+    uint16_t m_segment_pages;   // amount of pages in the current segment
+    uint32_t m_page_writes;     // amount of page writes since start
+    uint32_t m_recovery_time;   // time [ms] to restore the values
+    uint32_t m_restored_values; // amount of restored values
+
+    String segmentName(uint8_t segment);
+    bool readPage(File &file, page_t &page);
+    uint16_t findLastPage(File &file, uint16_t pages, page_t &page);
+    bool isValidPage(page_t &page);
+    uint32_t pageCrc(page_t &page);
+    void writePage(void);
+
+public:
+    FlashLog();
+    ~FlashLog();
+
+    /**
+     * @brief Mounts the file system and searches the write position
+     *
+     * @return true log is usable
+     * @return false file system is not available
+     */
+    bool begin(void);
+
+    /**
+     * @brief Reads all valid values from the oldest to the newest
+     *
+     * @param handler is called for each value
+     * @return uint32_t amount of restored values
+     */
+    uint32_t restore(restoreHandler_t handler);
+
+    /**
+     * @brief Adds a value, a full page is written to the flash
+     *
+     * @param value measurement value
+     */
+    void add(const measValue_t &value);
+
+    /**
+     * @brief Writes the collected values as partial page, has to be called
+     * before a restart; the page is completed in place by the next values,
+     * also after the restart
+     */
+    void flush(void);
+
+    /// amount of page writes since start
+    uint32_t getPageWrites(void);
+
+    /// time [ms] used to restore the values
+    uint32_t getRecoveryTime(void);
+
+    /// amount of values restored at start
+    uint32_t getRestoredValues(void);
+};
+
+
+// flash log of the measurement values
+extern FlashLog g_flashlog;
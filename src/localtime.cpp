@@ -55,6 +55,14 @@ bool Localtime::updateTimer()
 }
 
 
+void Localtime::setSnapshotTime(time_t utc_time)
+{
+	setTime(utc_time);
+	m_updated = true;
+	m_next_sync = now() + 60;
+}
+
+
 void Localtime::setTimeZone(TimeChangeRule std_time)
 {
     if(m_timezone_defined == TZ_NOT_DEFINED) {
@@ -149,6 +149,13 @@ public:
      */
     bool updateTimer();
 
+    /*
+     * Sets the system timer by a saved UTC time (warm restart), the time is
+     * handled as valid and a NTP update is done at the next updateTimer()
+     * call after one minute
+     */
+    void setSnapshotTime(time_t utc_time);
+
     /*
      * If local time is activated that epoch value of local time will be returned
      */
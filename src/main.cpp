@@ -18,8 +18,11 @@
 #include "measbuffer.hpp"
 #include "wifiserver.hpp"
 #include "settingshandler.h"
+#include "rtcsnapshot.h"
+#include "sampler.h"
 #ifdef ARDUINO_OTA_ENABLE
 #include "ArduinoOTA.h"
+#include <LittleFS.h>
 #endif
 
 /*
@@ -115,39 +118,78 @@ void setup()
         (TimeChangeRule){"CET", Last, Sun, Oct, 3, 60}    // Central European Standard Time
     );
 
-    for (int i = 0; i < 10; i++)
+    // enumerate the sensors, the buffers are sized by the sensor count
+    g_temp_meas.begin();
+
+    // prepare the measurement buffer, restore the values of the last run
+    if (!initMeasBuffer())
     {
-        if (!g_lt.updateTimer())
+        // a fragmented heap is free again after a restart
+        Serial.println(F("ERROR: measurement buffer not available, try restart!"));
+        delay(5000);
+        ESP.restart();
+    }
+    restoreMeasBuffer();
+
+    g_timer_values.store_interval = MEASURMENT_DOMAIN * 1000;        // [ms]
+    g_timer_values.meas_interval = TIME_MEASUREMENT_DISTANCE * 1000; // [ms]
+
+    // a controlled restart continues with the time and timers of the RTC snapshot
+    time_t snapshot_time;
+    if (g_rtc_snapshot.restore(snapshot_time))
+    {
+        g_lt.setSnapshotTime(snapshot_time);
+        Serial.println(F("Warm start, NTP update is done later"));
+    }
+    else
+    {
+        for (int i = 0; i < 10; i++)
+        {
+            if (!g_lt.updateTimer())
+            {
+                delay(500);
+                Serial.print(".");
+            }
+            else
+            {
+                break;
+            }
+        }
+        if (!g_lt.status())
         {
-            delay(500);
-            Serial.print(".");
+            // NTP server was not found try restart
+            Serial.println(F("\nERROR: NTP connect not possible, try restart!"));
+            delay(5000);
+            saveMeasBuffer();
+            ESP.restart();
         }
         else
         {
-            break;
+            Serial.println(" - NTP ok");
         }
+
+        // force immediately temperature store
+        g_timer_values.next_store_temp = millis() + 35000; // wait to get some scans for average
+        g_timer_values.next_meas_temp = 0;
+        g_timer_values.start_timestamp = g_lt.localNow(); // Temperature logger start time
     }
-    if (!g_lt.status())
+
+    // correct temperature value
+    g_temp_meas.setCorrection(getTempCorrection()); // reduce temperature by one degree
+    for (uint8_t sensor = 1; sensor < g_temp_meas.getSensorCount(); sensor++)
     {
-        // NTP server was not found try restart
-        Serial.println(F("\nERROR: NTP connect not possible, try restart!"));
-        delay(5000);
-        ESP.restart();
+        g_temp_meas.setCorrection(getSensorCorrection(sensor), sensor);
     }
-    else
+
+    // alarm thresholds of the sensors, written to the scratchpads by the next conversion
+    for (uint8_t sensor = 0; sensor < g_temp_meas.getSensorCount(); sensor++)
     {
-        Serial.println(" - NTP ok");
+        int8_t low = 0;
+        int8_t high = 0;
+        bool enabled = getSensorAlarm(sensor, low, high);
+        g_temp_meas.setAlarm(enabled, low, high, sensor);
     }
-
-    // force immediately temperature store
-    g_timer_values.next_store_temp = millis() + 35000;        // wait to get some scans for average
-    g_timer_values.store_interval = MEASURMENT_DOMAIN * 1000; // [ms]
-    g_timer_values.next_meas_temp = 0;
-    g_timer_values.meas_interval = TIME_MEASUREMENT_DISTANCE * 1000; // [ms]
-    g_timer_values.start_timestamp = g_lt.localNow();                // Temperature logger start time
-
-    // correct temperature value
-    g_temp_meas.setCorrection(getTempCorrection()); // reduce temperature by one degree
+    g_temp_meas.setAlarmWatch(isAlarmWatch(), g_timer_values.store_interval);
 
 #ifdef ARDUINO_OTA_ENABLE
     // OTA
@@ -171,10 +213,16 @@ void setup()
         else // U_SPIFFS
             type = "filesystem";
 
-        // NOTE: if updating SPIFFS this would be the place to unmount SPIFFS using SPIFFS.end()
+        // store the measurement values before the update, the file system
+        // is unmounted for a file system update
+        saveMeasBuffer();
+        if (ArduinoOTA.getCommand() != U_FLASH)
+            LittleFS.end();
         Serial.println("Start updating " + type);
     });
     ArduinoOTA.onEnd([]() {
+        // the restart follows directly, the snapshot time is still valid
+        g_rtc_snapshot.save(true);
         Serial.println("\nEnd");
     });
     ArduinoOTA.onProgress([](unsigned int progress, unsigned int total) {
@@ -195,6 +243,9 @@ void setup()
     });
     ArduinoOTA.begin();
 #endif
+
+    // the sensors are sampled by a timer from now on
+    g_sampler.begin(g_temp_meas.getMeasInterval());
 }
 
 /******************************************************************************
@@ -216,6 +267,7 @@ void loop()
     case InputStatus::Write:
         saveConfig();
         // reset
+        saveMeasBuffer();
         ESP.restart();
         break;
     default:
@@ -235,39 +287,41 @@ void loop()
         // get current timer value for this loop run
         g_timer_values.now = millis();
 
-        // temperature measurement; for average calculation
+        // time and DNS update
         if (g_timer_values.next_meas_temp < g_timer_values.now)
         {
-            activityLed.ledOn();
-
             g_timer_values.next_meas_temp = g_timer_values.now + g_timer_values.meas_interval;
             //DEBUG_PRINTLN("meas");
 
             g_lt.updateTimer();
             MDNS.update();
+        }
 
-            // start next measurement
-            g_temp_meas.meas();
+        // the source prepares the next conversion outside of the timer context
+        g_temp_meas.readAhead();
 
+        // add the samples of the timer driven sampling to the averages
+        if (g_sampler.getQueueSize())
+        {
+            activityLed.ledOn();
+            g_sampler.process();
             activityLed.ledOff();
         }
 
-        // temperature store (store to ringbuffer)
-        if (g_timer_values.next_store_temp < g_timer_values.now || g_ringbuffer.size() == 0)
+        // temperature store (store to ringbuffer), an empty buffer gets the first processed sample
+        if (g_timer_values.next_store_temp < g_timer_values.now || isFirstMeasWindow())
         {
             activityLed.ledOn();
 
             // set value for nect
             g_timer_values.next_store_temp = g_timer_values.now + g_timer_values.store_interval;
-            g_measvalue.temperature = g_temp_meas.getValue();
-            g_measvalue.timestamp = g_lt.localNow();
-            g_ringbuffer.add(g_measvalue);
+            g_measvalue = storeMeasWindow(g_lt.localNow());
 
-            Serial.printf("%s, Measured temp. : %f °C , counter:%u\n",
+            char temp[TEMP_FORMAT_SIZE];
+            Serial.printf("%s, Measured temp. : %s °C , counter:%u\n",
                           convertEpochToIso8601(g_measvalue.timestamp).c_str(),
-                          g_measvalue.temperature,
+                          formatTemp(temp, g_measvalue.temperature, 2),
                           g_ringbuffer.size());
-            g_temp_meas.restartAverage();
 
             activityLed.ledOff();
         }
@@ -8,70 +8,678 @@
 #include "meas.h"
 #include "macros.h"
 #include "settings.hpp"
+#if defined(MEAS_SOURCE_SYNTHETIC)
+#include "syntheticsource.h"
+#elif defined(MEAS_SOURCE_TRACE)
+#include "tracesource.h"
+#else
+#include "ds18b20source.h"
+#endif
 
-Measurement::Measurement(uint8_t pin)
-    : m_average_collector{0.0}
-    , m_average_counter{0}
-    , m_correction{0.0}
-    , m_last_scan_value{0.0}
-    , m_serialcode{0}
+
+// governor levels, resolution and sampling interval
+static const struct
 {
-    /*
-     * DS18B20 as temperature sensor
-     */
+    uint8_t resolution;     // sensor resolution [bit]
+    uint32_t interval;      // sampling interval [ms]
+    const char *name;       // name for the info page
+} governor_levels[] = {
+    {12, TIME_MEASUREMENT_DISTANCE * 1000 / 3, "fast"},    // GovernorLevel_t::FAST
+    {12, TIME_MEASUREMENT_DISTANCE * 1000, "normal"},      // GovernorLevel_t::NORMAL
+    {12, TIME_MEASUREMENT_DISTANCE * 1000 * 2, "stable"},  // GovernorLevel_t::STABLE
+    {11, TIME_MEASUREMENT_DISTANCE * 1000 * 4, "idle"},    // GovernorLevel_t::IDLE
+};
 
-    // Setup a oneWire instance to communicate with any OneWire devices
-    m_onewire = new OneWire(pin);
+Measurement::Measurement(SensorSource &source)
+    : m_sensor_count{1}
+    , m_state{MeasState_t::IDLE}
+    , m_conversion_start{0}
+    , m_conversion_wait{0}
+    , m_conversion_time{0}
+    , m_max_conversion_time{0}
+    , m_max_block_time{0}
+    , m_bus_time{0}
+    , m_max_bus_time{0}
+    , m_crc_errors{0}
+    , m_level{GovernorLevel_t::NORMAL}
+    , m_resolution{12}
+    , m_new_resolution{12}
+    , m_write_config{false}
+    , m_stable_samples{0}
+    , m_rate{0}
+    , m_last_read{0}
+    , m_level_changes{0}
+    , m_busy_time{0}
+    , m_alarm_watch{false}
+    , m_full_read_interval{0}
+    , m_last_full_read{0}
+    , m_alarm_searches{0}
+    , m_source{&source}
+{
+    memset(m_sensor, 0, sizeof(m_sensor));
+    memset(m_latency_histogram, 0, sizeof(m_latency_histogram));
+}
 
-    // Pass our oneWire reference to Dallas Temperature sensor
-    m_ds18b20 = new DallasTemperature(m_onewire);
+Measurement::~Measurement() {}
 
-    m_ds18b20->begin();
+void Measurement::begin(void)
+{
+    // get serial codes of the used sensors, the bus is searched only once
+    SerialCode_t codes[MEAS_MAX_SENSORS];
+    m_sensor_count = m_source->begin(codes, MEAS_MAX_SENSORS);
+    for (uint8_t i = 0; i < m_sensor_count; i++)
+    {
+        memcpy(m_sensor[i].serialcode, codes[i], sizeof(SerialCode_t));
+        setAlarm(false, 0, 0, i);
+    }
+    // sensor 0 is always used, a missing sensor delivers the disconnect value
+    if (!m_sensor_count)
+    {
+        m_sensor_count = 1;
+    }
 
-    // get serial code of the used DS18B20
-    m_ds18b20->getAddress(m_serialcode, m_device_ID);
+    // the sensors start with the resolution of the normal level
+    m_resolution = 0;
+    applyLevel(GovernorLevel_t::NORMAL);
+    m_level_changes = 0;
 }
 
-Measurement::~Measurement() {}
+void Measurement::readAhead(void)
+{
+    m_source->readAhead();
+}
 
 void Measurement::meas(void)
 {
-    // get temperature value
-    m_ds18b20->requestTemperatures();
-    m_last_scan_value = m_ds18b20->getTempCByIndex(m_device_ID) + m_correction;
-    m_average_collector += m_last_scan_value;
-    m_average_counter++;
-    DEBUG_PRINTF3("current:%f, collector:%f, counter:%d\n", m_last_scan_value, m_average_collector, m_average_counter);
+    if (m_state != MeasState_t::IDLE)
+    {
+        // the last conversion is not finished
+        return;
+    }
+    uint32_t start = micros();
+
+    // a resolution of the governor or new alarm thresholds are written between two conversions
+    if (m_new_resolution != m_resolution || m_write_config)
+    {
+        m_write_config = false;
+        writeConfig(m_new_resolution);
+        m_resolution = m_new_resolution;
+        m_conversion_wait = m_source->getConversionWait(m_resolution);
+    }
+
+    // start the conversion of all sensors at the same time
+    m_source->startConversion();
+    m_conversion_start = millis();
+    m_state = MeasState_t::CONVERTING;
+    m_bus_time = micros() - start;
+
+    updateBlockTime(start);
+}
+
+bool Measurement::readSample(sample_t &sample)
+{
+    if (m_state != MeasState_t::CONVERTING)
+    {
+        return false;
+    }
+    uint32_t start = micros();
+    uint32_t elapsed = millis() - m_conversion_start;
+
+    // in parasite power mode the bus cannot be polled, the max. conversion time is used;
+    // after twice the max. conversion time the value is read anyway
+    if (elapsed < 2 * m_conversion_wait
+        && (m_source->isParasitePowerMode() ? elapsed < m_conversion_wait : !m_source->isConversionComplete()))
+    {
+        updateBlockTime(start);
+        return false;
+    }
+    m_conversion_time = elapsed;
+    m_max_conversion_time = elapsed > m_max_conversion_time ? elapsed : m_max_conversion_time;
+    uint32_t bin = elapsed / MEAS_LATENCY_BIN_WIDTH;
+    m_latency_histogram[bin < MEAS_LATENCY_BINS ? bin : MEAS_LATENCY_BINS - 1]++;
+    m_state = MeasState_t::IDLE;
+
+    // get temperature values, the sensors are addressed by the cached ROM code
+    uint32_t read_start = micros();
+    sample.time = millis();
+    sample.valid = 0;
+    sample.alarm = 0;
+    sample.conversion_time = m_conversion_time;
+    sample.alarm_search = m_alarm_watch && m_last_full_read && sample.time - m_last_full_read < m_full_read_interval;
+    if (sample.alarm_search)
+    {
+        readAlarmSensors(sample);
+    }
+    else
+    {
+        m_last_full_read = sample.time ? sample.time : 1;
+        for (uint8_t i = 0; i < m_sensor_count; i++)
+        {
+            if (readSensor(m_sensor[i], sample.raw[i]))
+            {
+                sample.valid |= 1 << i;
+            }
+            else
+            {
+                // the sample is missing in the average
+                m_sensor[i].health.read_errors++;
+            }
+        }
+    }
+    m_bus_time += micros() - read_start;
+    m_max_bus_time = m_bus_time > m_max_bus_time ? m_bus_time : m_max_bus_time;
+    sample.bus_time = m_bus_time;
+
+    updateBlockTime(start);
+    return true;
+}
+
+void Measurement::processSample(const sample_t &sample)
+{
+    int32_t rate = 0;
+    int32_t deviation = 0;
+    for (uint8_t i = 0; i < m_sensor_count; i++)
+    {
+        sensor_t &sensor = m_sensor[i];
+        if (sample.alarm_search && !(sample.alarm & (1 << i)))
+        {
+            // the sensor did not answer the alarm search
+            updateAlarm(i, false);
+        }
+        if (!(sample.valid & (1 << i)))
+        {
+            continue;
+        }
+        if (isErrorValue(sensor, sample.raw[i]))
+        {
+            // error code of the sensor, e.g. the power on value after a brown out
+            sensor.window.rejected++;
+            sensor.health.rejected++;
+            continue;
+        }
+        // alarm condition of the DS18B20, the integer part of the temperature is compared
+        int16_t integer = sample.raw[i] >> 4;
+        updateAlarm(i, sensor.alarm.enabled && (integer <= sensor.alarm.low || integer >= sensor.alarm.high));
+        int32_t value;
+        if (!sensor.filter.process(rawToFixed(sample.raw[i]) + sensor.correction, value))
+        {
+            // collected by a decimation stage
+            continue;
+        }
+        // highest rate of change of all sensors [1/128 °C/min], the time since
+        // the last value of the sensor, a sensor can skip samples (dropout,
+        // error value, decimation)
+        if (sensor.last_scan_time && sample.time > sensor.last_scan_time)
+        {
+            int32_t sensor_rate = (uint32_t)abs(value - sensor.last_scan_value) * 60000 / (sample.time - sensor.last_scan_time);
+            rate = sensor_rate > rate ? sensor_rate : rate;
+        }
+        // highest deviation from the reference of the stable band
+        int32_t sensor_deviation = abs(value - sensor.reference);
+        deviation = sensor_deviation > deviation ? sensor_deviation : deviation;
+        sensor.last_scan_value = value;
+        sensor.last_scan_time = sample.time;
+        addWindowValue(sensor.window, sensor.last_scan_value);
+    }
+    m_busy_time += sample.conversion_time + sample.bus_time / 1000;
+
+    // adapt resolution and interval for the next conversion, the alarm watch
+    // mode has a fixed interval
+    if (m_last_read && !m_alarm_watch)
+    {
+        governor(rate, deviation);
+    }
+    m_last_read = sample.time;
+    DEBUG_PRINTF4("current:%d, mean:%d, valid:%u, conversion:%u ms\n", fixedToCenti(m_sensor[0].last_scan_value), getValue(), m_sensor[0].window.valid, sample.conversion_time);
+}
+
+bool Measurement::isBusy(void)
+{
+    return m_state != MeasState_t::IDLE;
+}
+
+uint32_t Measurement::getConversionWait(void)
+{
+    return m_conversion_wait;
+}
+
+uint32_t Measurement::getConversionTime(void)
+{
+    return m_conversion_time;
+}
+
+uint32_t Measurement::getMaxConversionTime(void)
+{
+    return m_max_conversion_time;
+}
+
+uint32_t Measurement::getMaxBlockTime(void)
+{
+    return m_max_block_time;
+}
+
+uint32_t Measurement::getBusTime(void)
+{
+    return m_bus_time;
+}
+
+uint32_t Measurement::getMaxBusTime(void)
+{
+    return m_max_bus_time;
+}
+
+uint32_t Measurement::getCrcErrors(void)
+{
+    return m_crc_errors;
+}
+
+uint32_t Measurement::getReadErrors(uint8_t sensor)
+{
+    return m_sensor[sensor].health.read_errors;
+}
+
+uint32_t Measurement::getMeasInterval(void)
+{
+    return m_alarm_watch ? ALARM_WATCH_INTERVAL : governor_levels[(int)m_level].interval;
+}
+
+GovernorLevel_t Measurement::getGovernorLevel(void)
+{
+    return m_level;
+}
+
+const char *Measurement::getGovernorLevelName(void)
+{
+    return governor_levels[(int)m_level].name;
+}
+
+uint8_t Measurement::getResolution(void)
+{
+    return m_resolution;
+}
+
+float Measurement::getRateOfChange(void)
+{
+    return (float)m_rate / TEMP_FIXED_SCALE;
+}
+
+uint32_t Measurement::getLevelChanges(void)
+{
+    return m_level_changes;
+}
+
+float Measurement::getDutyCycle(void)
+{
+    uint32_t uptime = millis();
+    return uptime ? 100.0 * m_busy_time / uptime : 0.0;
+}
+
+uint8_t Measurement::getSensorCount(void)
+{
+    return m_sensor_count;
+}
+
+const char *Measurement::getSourceName(void)
+{
+    return m_source->getName();
 }
 
-float Measurement::getValue(void)
+int Measurement::findSensor(const String &serial_code)
 {
-    if (m_average_collector)
-        return m_average_collector / m_average_counter;
-    return m_last_scan_value;
+    for (uint8_t i = 0; i < m_sensor_count; i++)
+    {
+        if (serial_code.equalsIgnoreCase(getSerialCode(i)))
+        {
+            return i;
+        }
+    }
+    return -1;
 }
 
-void Measurement::restartAverage(void)
+int16_t Measurement::getValue(uint8_t sensor)
 {
-    m_average_collector = 0.0;
-    m_average_counter = 0;
+    // a mean of 0.0 °C is a valid value, the amount of samples is checked
+    const windowStats_t &window = m_sensor[sensor].window;
+    if (window.valid)
+        return fixedToCenti(window.first + divRound(window.sum, window.valid));
+    return fixedToCenti(m_sensor[sensor].last_scan_value);
 }
 
-void Measurement::setCorrection(const float correction)
+measQuality_t Measurement::getQuality(uint8_t sensor)
 {
-    m_correction = correction;
+    const windowStats_t &window = m_sensor[sensor].window;
+    measQuality_t quality = {0, 0, 0, 0, 0};
+    if (window.valid)
+    {
+        // variance of the deviations from the first sample [(1/128 °C)^2]
+        uint64_t variance = 0;
+        if (window.valid > 1)
+        {
+            int64_t sum = window.sum;
+            variance = (window.sum_squares - (uint64_t)(sum * sum / window.valid)) / (window.valid - 1);
+        }
+        quality.min = fixedToCenti(window.min);
+        quality.max = fixedToCenti(window.max);
+        // (1/128 °C)^2 -> (1/100 °C)^2, 10000 / 16384 = 625 / 1024
+        uint32_t stddev = isqrt(variance * 625 / 1024);
+        quality.stddev = stddev > UINT16_MAX ? UINT16_MAX : stddev;
+    }
+    quality.valid = window.valid > 255 ? 255 : window.valid;
+    quality.rejected = window.rejected > 255 ? 255 : window.rejected;
+    return quality;
 }
 
-const char *Measurement::getSerialCode(void)
+uint16_t Measurement::getWindowSamples(uint8_t sensor)
+{
+    return m_sensor[sensor].window.valid;
+}
+
+uint32_t Measurement::getRejectedSamples(uint8_t sensor)
+{
+    return m_sensor[sensor].health.rejected;
+}
+
+const sensorHealth_t &Measurement::getHealth(uint8_t sensor)
+{
+    return m_sensor[sensor].health;
+}
+
+uint32_t Measurement::getLatencyHistogram(uint8_t bin)
+{
+    return bin < MEAS_LATENCY_BINS ? m_latency_histogram[bin] : 0;
+}
+
+void Measurement::restartAverage(uint8_t sensor)
+{
+    memset(&m_sensor[sensor].window, 0, sizeof(windowStats_t));
+}
+
+void Measurement::setCorrection(const float correction, uint8_t sensor)
+{
+    m_sensor[sensor].correction = lroundf(correction * TEMP_FIXED_SCALE);
+}
+
+void Measurement::setAlarm(bool enabled, int8_t low, int8_t high, uint8_t sensor)
+{
+    sensorAlarm_t &alarm = m_sensor[sensor].alarm;
+    alarm.enabled = enabled;
+    alarm.low = enabled ? low : INT8_MIN;
+    alarm.high = enabled ? high : INT8_MAX;
+    alarm.active = false;
+    m_write_config = true;
+}
+
+const sensorAlarm_t &Measurement::getAlarm(uint8_t sensor)
+{
+    return m_sensor[sensor].alarm;
+}
+
+void Measurement::setAlarmWatch(bool enable, uint32_t full_read_interval)
+{
+    m_alarm_watch = enable;
+    // one sample interval earlier, each store interval gets at least one full read
+    m_full_read_interval = full_read_interval > ALARM_WATCH_INTERVAL ? full_read_interval - ALARM_WATCH_INTERVAL : 0;
+    m_last_full_read = 0;
+    if (enable)
+    {
+        // full reads with 12 bit
+        applyLevel(GovernorLevel_t::NORMAL);
+    }
+}
+
+bool Measurement::isAlarmWatch(void)
+{
+    return m_alarm_watch;
+}
+
+uint32_t Measurement::getAlarmSearches(void)
+{
+    return m_alarm_searches;
+}
+
+const char *Measurement::getSerialCode(uint8_t sensor)
 {
     static char serial_code[SERIAL_CODE_SIZE];
+    const uint8_t *code = m_sensor[sensor].serialcode;
     sprintf(serial_code, "%02x%02x%02x%02x%02x%02x%02x%02x"
-            , m_serialcode[0], m_serialcode[1]
-            , m_serialcode[2], m_serialcode[3]
-            , m_serialcode[4], m_serialcode[5]
-            , m_serialcode[6], m_serialcode[7]);
+            , code[0], code[1]
+            , code[2], code[3]
+            , code[4], code[5]
+            , code[6], code[7]);
     return serial_code;
 }
 
-// temperature measurement via OneWire and DS18B20
-Measurement g_temp_meas(ONE_WIRE_PIN);
+void Measurement::getAverageState(averageState_t &state)
+{
+    state.window = m_sensor[0].window;
+    state.last_scan_value = m_sensor[0].last_scan_value;
+}
+
+void Measurement::setAverageState(const averageState_t &state)
+{
+    m_sensor[0].window = state.window;
+    m_sensor[0].last_scan_value = state.last_scan_value;
+}
+
+/*****************************************************************************
+ * private methods
+ *****************************************************************************/
+
+void Measurement::updateBlockTime(uint32_t start)
+{
+    uint32_t block_time = micros() - start;
+    m_max_block_time = block_time > m_max_block_time ? block_time : m_max_block_time;
+}
+
+bool Measurement::readSensor(sensor_t &sensor, int16_t &raw)
+{
+    sensorHealth_t &health = sensor.health;
+    uint8_t scratchpad[9];
+    for (uint8_t retry = 0; retry <= MEAS_READ_RETRIES; retry++)
+    {
+        if (retry)
+        {
+            health.retries++;
+        }
+        // no presence pulse or an all zero scratchpad (valid CRC) is a missing sensor
+        if (!m_source->readScratchPad(sensor.serialcode, scratchpad)
+            || (scratchpad[0] | scratchpad[1] | scratchpad[4] | scratchpad[8]) == 0)
+        {
+            health.disconnects++;
+            continue;
+        }
+        if (SensorSource::crc8(scratchpad, 8) != scratchpad[8])
+        {
+            m_crc_errors++;
+            health.crc_errors++;
+            continue;
+        }
+        // 1/16 °C, the low bits are undefined with a resolution below 12 bit
+        uint8_t resolution = 9 + ((scratchpad[4] >> 5) & 0x03);
+        raw = (int16_t)((scratchpad[1] << 8) | scratchpad[0]);
+        raw &= ~((1 << (12 - resolution)) - 1);
+        health.reads++;
+        health.last_good = millis();
+        // a sensor reset (brown out) restores TH/TL and the resolution from its EEPROM
+        if ((int8_t)scratchpad[2] != sensor.alarm.high || (int8_t)scratchpad[3] != sensor.alarm.low
+            || resolution != m_resolution)
+        {
+            m_write_config = true;
+        }
+        checkStuckValue(health, raw);
+        return true;
+    }
+    return false;
+}
+
+void Measurement::readAlarmSensors(sample_t &sample)
+{
+    // only the sensors with an alarm flag answer the search, they are read
+    SerialCode_t codes[MEAS_MAX_SENSORS];
+    uint8_t count = m_source->alarmSearch(codes, MEAS_MAX_SENSORS);
+    m_alarm_searches++;
+    for (uint8_t n = 0; n < count; n++)
+    {
+        for (uint8_t i = 0; i < m_sensor_count; i++)
+        {
+            if (memcmp(codes[n], m_sensor[i].serialcode, sizeof(SerialCode_t)))
+            {
+                continue;
+            }
+            sample.alarm |= 1 << i;
+            if (readSensor(m_sensor[i], sample.raw[i]))
+            {
+                sample.valid |= 1 << i;
+            }
+            else
+            {
+                m_sensor[i].health.read_errors++;
+            }
+            break;
+        }
+    }
+}
+
+void Measurement::updateAlarm(uint8_t sensor, bool active)
+{
+    sensorAlarm_t &alarm = m_sensor[sensor].alarm;
+    if (active && !alarm.active)
+    {
+        alarm.events++;
+        alarm.last_event = millis() ? millis() : 1;
+        Serial.printf("alarm: sensor %s outside of %d..%d °C\n", getSerialCode(sensor), alarm.low, alarm.high);
+    }
+    alarm.active = active;
+}
+
+void Measurement::checkStuckValue(sensorHealth_t &health, int16_t raw)
+{
+    if (health.reads > 1 && raw == health.last_raw)
+    {
+        if (health.same_samples < MEAS_STUCK_SAMPLES && ++health.same_samples == MEAS_STUCK_SAMPLES)
+        {
+            health.stuck = true;
+            health.stuck_events++;
+        }
+        return;
+    }
+    health.last_raw = raw;
+    health.same_samples = 0;
+    health.stuck = false;
+}
+
+bool Measurement::isErrorValue(sensor_t &sensor, int16_t raw)
+{
+    // outside of the measuring range (1/16 °C), e.g. the disconnect value -127 °C
+    if (raw < -55 * 16 || raw > 125 * 16)
+    {
+        return true;
+    }
+    // the power on value is rejected if it is a jump, a real 85 °C is reached slowly;
+    // the first sample of a sensor has no previous value and is rejected, too
+    if (raw == 85 * 16
+        && abs(rawToFixed(raw) + sensor.correction - sensor.last_scan_value) > celsiusToFixed(MEAS_POWER_ON_JUMP))
+    {
+        sensor.health.power_on++;
+        return true;
+    }
+    return false;
+}
+
+void Measurement::addWindowValue(windowStats_t &window, int32_t value)
+{
+    // the deviations from the first sample keep the sums small
+    if (!window.valid)
+    {
+        window.first = value;
+        window.min = value;
+        window.max = value;
+    }
+    window.valid++;
+    int32_t delta = value - window.first;
+    window.sum += delta;
+    window.sum_squares += (uint64_t)((int64_t)delta * delta);
+    window.min = value < window.min ? value : window.min;
+    window.max = value > window.max ? value : window.max;
+}
+
+void Measurement::governor(int32_t rate, int32_t deviation)
+{
+    GovernorLevel_t level = m_level;
+    bool new_reference = true;
+    m_rate = rate;
+
+    if (rate >= celsiusToFixed(GOVERNOR_FAST_RATE))
+    {
+        // fast change, sample as fast as possible
+        level = GovernorLevel_t::FAST;
+    }
+    else if (deviation < celsiusToFixed(GOVERNOR_STABLE_BAND))
+    {
+        // stable temperature, use the next slower level after some samples;
+        // the band is used instead of the rate, one LSB noise is no change
+        new_reference = false;
+        if (++m_stable_samples >= GOVERNOR_STABLE_SAMPLES)
+        {
+            if (level != GovernorLevel_t::IDLE)
+            {
+                level = (GovernorLevel_t)((int)level + 1);
+            }
+            new_reference = true;
+        }
+    }
+    else
+    {
+        // moderate change
+        level = GovernorLevel_t::NORMAL;
+    }
+
+    if (new_reference)
+    {
+        // start a new stable band at the current values
+        m_stable_samples = 0;
+        for (uint8_t i = 0; i < m_sensor_count; i++)
+        {
+            m_sensor[i].reference = m_sensor[i].last_scan_value;
+        }
+    }
+
+    if (level != m_level)
+    {
+        DEBUG_PRINTF2("governor: %s, rate %d/128 °C/min\n", governor_levels[(int)level].name, rate);
+        applyLevel(level);
+    }
+}
+
+void Measurement::applyLevel(GovernorLevel_t level)
+{
+    m_level = level;
+    m_level_changes++;
+    // the resolution is written by meas(), no conversion is running at that time
+    m_new_resolution = governor_levels[(int)level].resolution;
+}
+
+void Measurement::writeConfig(uint8_t resolution)
+{
+    // the configuration is written to the scratchpad only, the sensor EEPROM
+    // is not written (limited write cycles); TH/TL are the alarm thresholds
+    for (uint8_t i = 0; i < m_sensor_count; i++)
+    {
+        const sensorAlarm_t &alarm = m_sensor[i].alarm;
+        m_source->writeScratchPad(m_sensor[i].serialcode, (uint8_t)alarm.high, (uint8_t)alarm.low,
+                                  ((resolution - 9) << 5) | 0x1F);
+    }
+}
+
+// source of the temperature values
+#if defined(MEAS_SOURCE_SYNTHETIC)
+static SyntheticSource g_sensor_source(MEAS_SYNTHETIC_SENSORS, MEAS_SYNTHETIC_BASE, MEAS_SYNTHETIC_NOISE,
+                                      MEAS_SYNTHETIC_DRIFT, MEAS_SYNTHETIC_DROPOUT);
+#elif defined(MEAS_SOURCE_TRACE)
+static TraceSource g_sensor_source(MEAS_TRACE_FILE);
+#else
+static DS18B20Source g_sensor_source(ONE_WIRE_PIN);
+#endif
+
+// temperature measurement via the sensor source
+Measurement g_temp_meas(g_sensor_source);
@@ -8,49 +8,385 @@
 #pragma once
 
 #include <Arduino.h>
-#include <OneWire.h>
-#include <DallasTemperature.h>
 
-typedef uint8_t SerialCode_t[8];
+#include "settings.hpp"
+#include "sensorsource.h"
+#include "filter.hpp"
+#include "fixedpoint.hpp"
 
+// statistics of the samples of a store window, temperatures in 1/128 °C;
+// the sums of the deviations from the first sample are exact, a large
+// offset does not cancel the variance like with float sums
+typedef struct
+{
+    uint16_t valid;         // amount of valid samples
+    uint16_t rejected;      // amount of rejected samples (sensor error codes)
+    int16_t first;          // first valid sample, reference of the sums
+    int16_t min;            // lowest valid sample
+    int16_t max;            // highest valid sample
+    int32_t sum;            // sum of the deviations from the first sample
+    uint64_t sum_squares;   // sum of the squared deviations from the first sample
+} windowStats_t;
+
+// quality of a stored measurement value, temperatures in 1/100 °C
+typedef struct
+{
+    int16_t min;            // lowest sample of the store window
+    int16_t max;            // highest sample of the store window
+    uint16_t stddev;        // standard deviation of the samples
+    uint8_t valid;          // amount of valid samples, limited to 255
+    uint8_t rejected;       // amount of rejected samples, limited to 255
+} measQuality_t;
+
+// health counters of a sensor since start
+typedef struct
+{
+    uint32_t reads;         // amount of successful scratchpad reads
+    uint32_t read_errors;   // amount of failed reads (all retries failed)
+    uint32_t crc_errors;    // amount of scratchpad reads with a CRC error
+    uint32_t retries;       // amount of repeated scratchpad reads
+    uint32_t disconnects;   // amount of reads without presence pulse or with an empty scratchpad (-127 °C)
+    uint32_t power_on;      // amount of rejected 85 °C power on values
+    uint32_t rejected;      // amount of rejected samples (power on value and out of range)
+    uint32_t stuck_events;  // amount of detected stuck values
+    uint32_t last_good;     // millis() of the last successful read, 0: no read
+    uint16_t same_samples;  // amount of identical raw values in sequence
+    int16_t last_raw;       // last raw value [1/16 °C]
+    bool stuck;             // the raw value did not change for MEAS_STUCK_SAMPLES samples
+} sensorHealth_t;
+
+// alarm state of a sensor, the thresholds are written to the TH/TL registers
+// and compare the integer part of the uncorrected temperature
+typedef struct
+{
+    int8_t low;             // alarm if the temperature <= low (TL) [°C]
+    int8_t high;            // alarm if the temperature >= high (TH) [°C]
+    bool enabled;           // thresholds are defined
+    bool active;            // the last check found an alarm
+    uint32_t events;        // amount of alarms since start (start of an active state)
+    uint32_t last_event;    // millis() of the last alarm start, 0: no alarm
+} sensorAlarm_t;
 
+// state of the average calculation, saved over a warm restart
+typedef struct
+{
+    windowStats_t window;   // statistics of the current store window
+    int32_t last_scan_value; // last scanned value [1/128 °C]
+} averageState_t;
+
+// raw values of one conversion of all sensors, handed from the sampler to loop()
+typedef struct
+{
+    uint32_t time;                  // millis() of the read
+    uint32_t conversion_time;       // time of the conversion [ms]
+    uint32_t bus_time;              // bus time of the convert command and the reads [us]
+    uint16_t valid;                 // bit n: sensor n was read
+    uint16_t alarm;                 // bit n: sensor n was found by the alarm search
+    bool alarm_search;              // sample of an alarm search, only the sensors with an alarm were read
+    int16_t raw[MEAS_MAX_SENSORS];  // temperature [1/16 °C], undefined bits of the resolution are 0
+} sample_t;
+
+static_assert(MEAS_MAX_SENSORS <= 16, "the valid mask of sample_t is too small");
+
+// stages of the sample filter, see filter.hpp; e.g. for a 9 bit sensor with a short interval:
+// FilterChain<HampelFilter<...>, DecimateFilter<FILTER_DECIMATE>>, or smoothing by EmaFilter<FILTER_EMA_ALPHA>
+typedef FilterChain<HampelFilter<FILTER_MEDIAN_WINDOW, FILTER_HAMPEL_K, FILTER_HAMPEL_MIN * TEMP_FIXED_SCALE / TEMP_CENTI_SCALE>> SampleFilter_t;
+
+// state of the DS18B20 conversion, meas() starts it, readSample() checks it
+enum class MeasState_t
+{
+    IDLE,       // no conversion active
+    CONVERTING  // conversion started, waiting for the result
+};
+
+// sampling level of the governor, from the fastest to the slowest sampling;
+// a stable temperature is sampled less often and with a lower resolution, a
+// fast change switches to FAST immediately
+enum class GovernorLevel_t
+{
+    FAST,       // fast changing temperature, 12 bit, short interval
+    NORMAL,     // 12 bit, TIME_MEASUREMENT_DISTANCE
+    STABLE,     // stable temperature, 12 bit, longer interval
+    IDLE        // very stable temperature, 11 bit, longest interval
+};
+
+
+// all DS18B20 of the 1-wire bus or a simulation, see SensorSource; the sensors
+// are enumerated once by begin() and read by their cached ROM code, sensor 0
+// is the first sensor of the bus search and the primary sensor of the logger;
+// the sample path uses fixed point values of 1/128 °C without float
 class Measurement
 {
 private:
-    /// 1-wire device ID    
-    const uint8_t m_device_ID = 0;
+    // state of a sensor
+    typedef struct
+    {
+        SerialCode_t serialcode;    // ROM code of the sensor
+        windowStats_t window;       // statistics of the current store window
+        int32_t correction;         // measured temperature value correction [1/128 °C]
+        int32_t last_scan_value;    // last filtered value [1/128 °C]
+        uint32_t last_scan_time;    // millis() of the sample of last_scan_value, 0: no value
+        sensorHealth_t health;      // health counters of the sensor
+        int32_t reference;          // governor: reference value of the stable band [1/128 °C]
+        SampleFilter_t filter;      // sample filter, state of the stages
+        sensorAlarm_t alarm;        // alarm thresholds and state
+    } sensor_t;
 
     /* data */
-    float m_average_collector;
-    int m_average_counter;
-    float m_correction; // measured temperature value correction
-    float m_last_scan_value;
+    sensor_t m_sensor[MEAS_MAX_SENSORS];
+    uint8_t m_sensor_count;         // amount of found sensors
+
+    /* conversion state machine */
+    MeasState_t m_state;
+    uint32_t m_conversion_start;    // millis() of the conversion start
+    uint32_t m_conversion_wait;     // max. conversion time of the resolution [ms]
+    uint32_t m_conversion_time;     // time of the last conversion [ms]
+    uint32_t m_max_conversion_time; // max. time of a conversion [ms]
+    uint32_t m_max_block_time;      // max. time of a meas()/readSample() call [us]
+    uint32_t m_bus_time;            // bus time of the last cycle, convert command and reads [us]
+    uint32_t m_max_bus_time;        // max. bus time of a cycle [us]
+    uint32_t m_crc_errors;          // amount of scratchpad reads with a CRC error
+    uint32_t m_latency_histogram[MEAS_LATENCY_BINS]; // amount of conversions per conversion time bin
+
+    /* governor */
+    GovernorLevel_t m_level;        // current sampling level
+    uint8_t m_resolution;           // current sensor resolution [bit]
+    volatile uint8_t m_new_resolution; // resolution of the governor, written by the next meas()
+    volatile bool m_write_config;   // TH/TL changed or lost by a sensor reset, written by the next meas()
+    uint8_t m_stable_samples;       // amount of stable samples in sequence
+    int32_t m_rate;                 // last rate of change [1/128 °C/min]
+    uint32_t m_last_read;           // millis() of the last scratchpad read
+    uint32_t m_level_changes;       // amount of level changes since start
+    uint32_t m_busy_time;           // sum of conversion and bus times since start [ms]
 
-    /// Address of the first device
-    SerialCode_t m_serialcode;
+    /* alarm watch */
+    bool m_alarm_watch;             // a tick runs an alarm search, all sensors are read at the full read interval
+    uint32_t m_full_read_interval;  // interval of the full reads in the alarm watch mode [ms]
+    uint32_t m_last_full_read;      // millis() of the last full read, 0: no read
+    uint32_t m_alarm_searches;      // amount of alarm searches since start
 
-    // Setup a oneWire instance to communicate with any OneWire devices
-    OneWire *m_onewire;
+    // source of the temperature values, DS18B20 or a simulation
+    SensorSource *m_source;
 
-    // Pass our oneWire reference to Dallas Temperature sensor
-    DallasTemperature *m_ds18b20;
+    void updateBlockTime(uint32_t start);
+    bool readSensor(sensor_t &sensor, int16_t &raw);
+    void readAlarmSensors(sample_t &sample);
+    void updateAlarm(uint8_t sensor, bool active);
+    void checkStuckValue(sensorHealth_t &health, int16_t raw);
+    bool isErrorValue(sensor_t &sensor, int16_t raw);
+    void addWindowValue(windowStats_t &window, int32_t value);
+    void governor(int32_t rate, int32_t deviation);
+    void applyLevel(GovernorLevel_t level);
+    void writeConfig(uint8_t resolution);
 
 public:
-    Measurement(uint8_t pin);
+    /**
+     * @brief Construct a new Measurement object, the source is not accessed
+     * before begin()
+     *
+     * @param source source of the temperature values
+     */
+    Measurement(SensorSource &source);
 
     ~Measurement();
 
+    /**
+     * @brief Enumerates the sensors of the source once and sets their
+     * resolution; has to be called in setup() before the sensor count is used
+     */
+    void begin(void);
+
+    /**
+     * @brief Lets the source prepare the values of the next conversion, has
+     * to be called in loop(); a trace is read here and not in the timer context
+     */
+    void readAhead(void);
+
+    /**
+     * @brief Starts a temperature conversion of all sensors with one skip ROM
+     * Convert T command, the call returns immediately; is called by the Sampler
+     */
     void meas(void);
 
-    float getValue(void);
+    /**
+     * @brief Checks the running conversion and reads the scratchpads of all
+     * sensors (CRC checked, with retries) if it is finished, see
+     * setAlarmWatch() for the alarm watch mode; is called by the Sampler
+     *
+     * @param sample buffer for the raw values
+     * @return true the conversion was finished and the sensors were read
+     * @return false no conversion finished
+     */
+    bool readSample(sample_t &sample);
+
+    /**
+     * @brief Adds the values of a sample to the averages and runs the
+     * governor; is called in loop(). The error codes of the DS18B20
+     * (disconnected, 85 °C power on value) are rejected and counted, the
+     * valid samples pass SampleFilter_t (single spikes are removed) and are
+     * accumulated as integer sums (mean, variance, min, max).
+     *
+     * @param sample raw values of a conversion
+     */
+    void processSample(const sample_t &sample);
+
+    /// true if a conversion is running
+    bool isBusy(void);
+
+    /// max. conversion time of the current resolution [ms]
+    uint32_t getConversionWait(void);
+
+    /// time of the last conversion [ms]
+    uint32_t getConversionTime(void);
+
+    /// max. time of a conversion since start [ms]
+    uint32_t getMaxConversionTime(void);
+
+    /// max. time of a meas() or readSample() call [us]
+    uint32_t getMaxBlockTime(void);
+
+    /// bus time of the last cycle (convert command and all scratchpad reads) [us]
+    uint32_t getBusTime(void);
+
+    /// max. bus time of a cycle since start [us]
+    uint32_t getMaxBusTime(void);
+
+    /// amount of scratchpad reads with a CRC error since start
+    uint32_t getCrcErrors(void);
+
+    /// amount of failed reads of a sensor (all retries failed) since start
+    uint32_t getReadErrors(uint8_t sensor = 0);
+
+    /// sampling interval of the governor [ms]
+    uint32_t getMeasInterval(void);
+
+    /// current governor level
+    GovernorLevel_t getGovernorLevel(void);
+
+    /// name of the current governor level
+    const char *getGovernorLevelName(void);
+
+    /// current sensor resolution [bit]
+    uint8_t getResolution(void);
+
+    /// last rate of change of the temperature [°C/min]
+    float getRateOfChange(void);
+
+    /// amount of governor level changes since start
+    uint32_t getLevelChanges(void);
+
+    /// part of the time the sensors are converting or the bus is used [%]
+    float getDutyCycle(void);
+
+    /// amount of sensors on the bus, minimum 1
+    uint8_t getSensorCount(void);
+
+    /// name of the sensor source
+    const char *getSourceName(void);
+
+    /**
+     * @brief Returns the sensor number of a ROM code
+     *
+     * @param serial_code ROM code as hex string, see getSerialCode()
+     * @return int sensor number, -1 if the sensor is unknown
+     */
+    int findSensor(const String &serial_code);
+
+    /**
+     * @brief Returns the mean of the valid samples of the store window, the
+     * last scanned value if the window has no valid sample
+     *
+     * @param sensor sensor number
+     * @return int16_t temperature [1/100 °C]
+     */
+    int16_t getValue(uint8_t sensor = 0);
+
+    /**
+     * @brief Returns the quality of the store window for the stored value
+     *
+     * @param sensor sensor number
+     * @return measQuality_t min/max/standard deviation and sample counts
+     */
+    measQuality_t getQuality(uint8_t sensor = 0);
+
+    /// amount of valid samples in the store window, 0: getValue() has no measured value yet
+    uint16_t getWindowSamples(uint8_t sensor = 0);
+
+    /// amount of rejected samples (sensor error codes) since start
+    uint32_t getRejectedSamples(uint8_t sensor = 0);
+
+    /// health counters of a sensor since start
+    const sensorHealth_t &getHealth(uint8_t sensor = 0);
+
+    /**
+     * @brief Returns a bin of the conversion time histogram, bin i counts the
+     * conversions of i * MEAS_LATENCY_BIN_WIDTH .. (i + 1) * MEAS_LATENCY_BIN_WIDTH - 1 ms,
+     * the last bin counts all longer conversions
+     *
+     * @param bin bin number 0..MEAS_LATENCY_BINS-1
+     * @return uint32_t amount of conversions since start
+     */
+    uint32_t getLatencyHistogram(uint8_t bin);
+
+    void restartAverage(uint8_t sensor = 0);
+
+    /**
+     * @brief Sets the correction value of a sensor, it is added to each sample
+     *
+     * @param correction correction value [°C]
+     * @param sensor sensor number
+     */
+    void setCorrection(const float correction, uint8_t sensor = 0);
+
+    /**
+     * @brief Sets the alarm thresholds of a sensor, they are written to the
+     * TH/TL registers before the next conversion
+     *
+     * @param enabled false: no alarm, the registers get the limits 127/-128 °C
+     * @param low alarm if the temperature <= low [°C]
+     * @param high alarm if the temperature >= high [°C]
+     * @param sensor sensor number
+     */
+    void setAlarm(bool enabled, int8_t low, int8_t high, uint8_t sensor = 0);
+
+    /// alarm thresholds and state of a sensor
+    const sensorAlarm_t &getAlarm(uint8_t sensor = 0);
+
+    /**
+     * @brief Enables the alarm watch mode: a tick runs the conversion and an
+     * alarm search, only the sensors with an alarm are read; all sensors are
+     * read at the full read interval. The governor is not used, the sampling
+     * interval is ALARM_WATCH_INTERVAL. On a bus with several sensors an
+     * excursion is found within one tick with a fraction of the bus traffic.
+     *
+     * @param enable true: alarm watch mode, false: all sensors are read each tick
+     * @param full_read_interval interval of the full reads [ms], e.g. the store interval
+     */
+    void setAlarmWatch(bool enable, uint32_t full_read_interval);
+
+    /// true if the alarm watch mode is enabled
+    bool isAlarmWatch(void);
+
+    /// amount of alarm searches since start
+    uint32_t getAlarmSearches(void);
 
-    void restartAverage(void);
+    const char* getSerialCode(uint8_t sensor = 0);
 
-    void setCorrection(const float correction);
+    /**
+     * @brief Reads the state of the average calculation of the primary sensor
+     *
+     * @param state buffer for the state
+     */
+    void getAverageState(averageState_t &state);
 
-    const char* getSerialCode(void);
+    /**
+     * @brief Continues the average calculation of the primary sensor with a saved state
+     *
+     * @param state saved state
+     */
+    void setAverageState(const averageState_t &state);
 };
 
 
-// temperature measurement via OneWire and DS18B20
+// temperature measurement via the sensor source
 extern Measurement g_temp_meas;
@@ -5,10 +5,396 @@
  * Note         handles the measurement buffer
  */
 
+#include <algorithm>
+
 #include "settings.hpp"
 #include "measbuffer.hpp"
+#include "flashlog.h"
+#include "archive.h"
+#include "meas.h"
+#include "rtcsnapshot.h"
+#include "rollupstore.h"
+#include "parameter.hpp"
+#include "timehelper.h"
+
+
+measValue_t g_measvalue = {0, 0};
+
+MeasBuffer_t g_ringbuffer(g_measvalue);
+
+#ifndef MEASBUFFER_COMPRESSED
+// value source of the aggregate index
+static int32_t readMeasSlot(size_t slot)
+{
+    return g_ringbuffer.readSlot(slot).temperature;
+}
+
+AggregateIndex<AGGREGATE_LEAF_SIZE> g_meas_index(&readMeasSlot);
+#endif
+
+RollupTier<ROLLUP_HOURLY_SIZE> g_rollup_hourly(60 * 60);
+RollupTier<ROLLUP_DAILY_SIZE> g_rollup_daily(60 * 60 * 24);
+
+
+// buffers of the additional sensors, index 0 is not used
+static SensorBuffer_t *g_sensor_buffer[MEAS_MAX_SENSORS];
+
+// deadband mode: last skipped value of each sensor, timestamp 0: no value
+static measValue_t g_skipped_value[MEAS_MAX_SENSORS];
+static uint32_t g_skipped_values = 0;
+// amount of values added to the buffer of each sensor, see getFirstValueNumber()
+static uint32_t g_added_values[MEAS_MAX_SENSORS];
+// the buffer was restored, the file system is mounted, see saveMeasBuffer()
+static bool g_measbuffer_restored = false;
+
+
+// allocates a heap buffer, a smaller buffer is used if the allocation fails
+static size_t allocateBuffer(SensorBuffer_t &buffer, size_t capacity, size_t min_capacity)
+{
+    capacity = constrain(capacity, min_capacity, RINGBUFFER_MAX_SIZE);
+    while (!buffer.resize(capacity) && capacity > min_capacity)
+    {
+        capacity = capacity * 3 / 4 > min_capacity ? capacity * 3 / 4 : min_capacity;
+    }
+    return buffer.content();
+}
+
+bool initMeasBuffer(void)
+{
+    uint8_t sensors = g_temp_meas.getSensorCount();
+    size_t block = ESP.getMaxFreeBlockSize();
+    size_t budget = block > MEASBUFFER_HEAP_RESERVE ? block - MEASBUFFER_HEAP_RESERVE : 0;
+
+#ifndef MEASBUFFER_COMPRESSED
+    // heap per value: the value and its part of the aggregate index, the
+    // index tree has up to 4 nodes per leaf; all sensors get the same capacity
+    const size_t value_size = sizeof(measValue_t) + 4 * sizeof(aggregate_t) / AGGREGATE_LEAF_SIZE;
+    size_t capacity = budget / (value_size + (sensors - 1) * sizeof(measValue_t));
+
+    if (!allocateBuffer(g_ringbuffer, capacity, RINGBUFFER_MIN_SIZE))
+    {
+        // a buffer without memory is not used, the caller restarts
+        Serial.println(F("ERROR: no memory for the measurement buffer!"));
+        return false;
+    }
+
+    // allocate the aggregate index for the buffer size
+    if (!g_meas_index.resize(g_ringbuffer.content()))
+    {
+        Serial.println(F("ERROR: no memory for the aggregate index!"));
+    }
+#else
+    // the compressed buffer of sensor 0 is not part of the heap
+    size_t capacity = sensors > 1 ? budget / ((sensors - 1) * sizeof(measValue_t)) : 0;
+#endif
+
+    for (uint8_t sensor = 1; sensor < sensors; sensor++)
+    {
+        g_sensor_buffer[sensor] = new (std::nothrow) SensorBuffer_t(g_measvalue);
+        if (!g_sensor_buffer[sensor] || !allocateBuffer(*g_sensor_buffer[sensor], capacity, 0))
+        {
+            Serial.printf("ERROR: no memory for the buffer of sensor %u!\n", sensor);
+        }
+    }
+    Serial.printf("measurement buffer: %u values, %u sensors, free heap block %u byte\n",
+                  g_ringbuffer.content(), sensors, block);
+    return true;
+}
+
+size_t getMeasBufferMemory(void)
+{
+#ifdef MEASBUFFER_COMPRESSED
+    size_t memory = sizeof(g_ringbuffer);
+#else
+    size_t memory = g_ringbuffer.content() * sizeof(measValue_t) + g_meas_index.memorySize();
+#endif
+    for (uint8_t sensor = 1; sensor < MEAS_MAX_SENSORS; sensor++)
+    {
+        if (g_sensor_buffer[sensor])
+        {
+            memory += g_sensor_buffer[sensor]->content() * sizeof(measValue_t);
+        }
+    }
+    return memory;
+}
+
+SensorBuffer_t *getSensorBuffer(uint8_t sensor)
+{
+    return sensor && sensor < MEAS_MAX_SENSORS ? g_sensor_buffer[sensor] : nullptr;
+}
+
+void storeSensorValue(uint8_t sensor, const measValue_t &value)
+{
+    SensorBuffer_t *buffer = getSensorBuffer(sensor);
+    if (buffer && buffer->add(value))
+    {
+        g_added_values[sensor]++;
+    }
+}
+
+uint32_t getFirstValueNumber(uint8_t sensor)
+{
+    SensorBuffer_t *buffer = getSensorBuffer(sensor);
+    size_t size = sensor ? (buffer ? buffer->size() : 0) : g_ringbuffer.size();
+    return sensor < MEAS_MAX_SENSORS ? g_added_values[sensor] - (uint32_t)size : 0;
+}
+
+size_t findSensorValue(uint8_t sensor, time_t timestamp)
+{
+    SensorBuffer_t *buffer = getSensorBuffer(sensor);
+    if (!buffer)
+    {
+        return 0;
+    }
+    return std::lower_bound(buffer->begin(), buffer->end(), timestamp,
+                            [](const measValue_t &value, time_t time) { return value.timestamp < time; })
+        .offset();
+}
+
+// adds a value to the buffer and to the indexes, returns true if a day of
+// the rollup tiers was closed
+static bool addMeasValue(const measValue_t &value)
+{
+#ifndef MEASBUFFER_COMPRESSED
+    if (g_ringbuffer.add(value))
+    {
+        g_meas_index.update(g_ringbuffer.slot(g_ringbuffer.size() - 1));
+        g_added_values[0]++;
+    }
+#else
+    g_ringbuffer.add(value);
+    g_added_values[0]++;
+#endif
+
+    // the saved rollup tiers contain the older values of the flash log
+    if (value.timestamp <= g_rollup_store.getLastValue())
+    {
+        return false;
+    }
+    g_rollup_store.update(value.timestamp);
+
+    // update the rollup tiers, a closed hour is the input of the day tier
+    bool day_closed = false;
+    if (g_rollup_hourly.add(value.timestamp, value.temperature))
+    {
+        day_closed = g_rollup_daily.add(g_rollup_hourly.readLast(), g_rollup_hourly.closedCount());
+    }
+    // the day is closed by the first value of the next day, not by the close of its first hour
+    return g_rollup_daily.close(value.timestamp) || day_closed;
+}
+
+// handler of the flash log restore
+static void restoreMeasValue(const measValue_t &value)
+{
+    addMeasValue(value);
+}
+
+void storeMeasValue(const measValue_t &value)
+{
+    if (addMeasValue(value))
+    {
+        g_rollup_store.save();
+    }
+    g_flashlog.add(value);
+    g_archive.update(value);
+}
+
+// stores a value of a sensor without deadband check
+static void storeSensorOrMeasValue(uint8_t sensor, const measValue_t &value)
+{
+    if (sensor == 0)
+    {
+        storeMeasValue(value);
+    }
+    else
+    {
+        storeSensorValue(sensor, value);
+    }
+}
+
+bool storeWindowValue(uint8_t sensor, const measValue_t &value)
+{
+    int32_t deadband = lroundf(getStoreDeadband() * TEMP_CENTI_SCALE);
+    SensorBuffer_t *buffer = getSensorBuffer(sensor);
+    size_t size = sensor ? (buffer ? buffer->size() : 0) : g_ringbuffer.size();
+    measValue_t &skipped = g_skipped_value[sensor];
+
+    if (deadband > 0 && size > 0)
+    {
+        const measValue_t &last = sensor ? buffer->readLast() : g_ringbuffer.readLast();
+        if (abs(value.temperature - last.temperature) < deadband)
+        {
+            if (value.timestamp - last.timestamp < (time_t)getStoreHeartbeat())
+            {
+                // unchanged value, it is stored only if the next value is changed
+                skipped = value;
+                g_skipped_values++;
+                return false;
+            }
+        }
+        else if (skipped.timestamp)
+        {
+            // the end of the constant period keeps the step shape in the graph
+            storeSensorOrMeasValue(sensor, skipped);
+        }
+    }
+    skipped.timestamp = 0;
+    storeSensorOrMeasValue(sensor, value);
+    return true;
+}
+
+measValue_t storeMeasWindow(time_t timestamp)
+{
+    measValue_t value = {timestamp, g_temp_meas.getValue(), g_temp_meas.getQuality()};
+    storeWindowValue(0, value);
+    g_temp_meas.restartAverage();
+
+    // additional sensors use the same timestamp
+    for (uint8_t sensor = 1; sensor < g_temp_meas.getSensorCount(); sensor++)
+    {
+        // an empty buffer waits for the first processed sample of the sensor
+        SensorBuffer_t *buffer = getSensorBuffer(sensor);
+        if (buffer && buffer->isEmpty() && !g_temp_meas.getWindowSamples(sensor))
+        {
+            continue;
+        }
+        measValue_t sensor_value = {timestamp, g_temp_meas.getValue(sensor), g_temp_meas.getQuality(sensor)};
+        storeWindowValue(sensor, sensor_value);
+        g_temp_meas.restartAverage(sensor);
+    }
+    g_rtc_snapshot.save(false);
+    return value;
+}
+
+bool isFirstMeasWindow(void)
+{
+    return g_ringbuffer.size() == 0 && g_temp_meas.getWindowSamples() > 0;
+}
+
+uint32_t getSkippedValues(void)
+{
+    return g_skipped_values;
+}
+
+float getMeasValueSpacing(void)
+{
+    if (g_ringbuffer.size() < 2)
+    {
+        return g_timer_values.store_interval / 1000.0;
+    }
+    return (float)(g_ringbuffer.readLast().timestamp - g_ringbuffer.readFirst().timestamp) / (g_ringbuffer.size() - 1);
+}
+
+void restoreMeasBuffer(void)
+{
+    // the long term history is saved separately, the flash log adds the newer values
+    g_rollup_store.load();
+    if (g_flashlog.begin())
+    {
+        g_flashlog.restore(&restoreMeasValue);
+    }
+    g_archive.begin();
+    g_measbuffer_restored = true;
+}
+
+bool isMeasBufferRestored(void)
+{
+    return g_measbuffer_restored;
+}
+
+void saveMeasBuffer(void)
+{
+    // a restart before the restore (e.g. WiFi timeout in setup()) keeps the
+    // RTC snapshot of the last run, the file system is not mounted yet
+    if (!g_measbuffer_restored)
+    {
+        return;
+    }
+    g_flashlog.flush();
+    g_rollup_store.save();
+    g_rtc_snapshot.save(true);
+}
+
+size_t findMeasValue(time_t timestamp)
+{
+#ifdef MEASBUFFER_COMPRESSED
+    return g_ringbuffer.lowerBound(timestamp);
+#else
+    // binary search with the invariant value[first - 1] < timestamp <= value[last],
+    // std::lower_bound requires ascending values, it is not defined for the
+    // repeated hour at the end of the daylight saving time
+    size_t first = 0;
+    size_t last = g_ringbuffer.size();
+    while (first < last)
+    {
+        size_t middle = first + (last - first) / 2;
+        if (g_ringbuffer.readFirst(middle).timestamp < timestamp)
+        {
+            first = middle + 1;
+        }
+        else
+        {
+            last = middle;
+        }
+    }
+    return first;
+#endif
+}
 
+aggregate_t getMeasStatistics(time_t from, time_t to)
+{
+    size_t first = from ? findMeasValue(from) : 0;
+    size_t last = to ? findMeasValue(to + 1) : g_ringbuffer.size();
+    aggregate_t result = {0, 0, 0, 0};
+    if (first >= last)
+    {
+        return result;
+    }
 
-measValue_t g_measvalue = {0, 0.0};
+#ifdef MEASBUFFER_COMPRESSED
+    // no index available, scan the values
+    MeasBuffer_t::iterator end(&g_ringbuffer, last);
+    for (MeasBuffer_t::iterator it(&g_ringbuffer, first); it != end; ++it)
+    {
+        aggregate_t value = {it->temperature, it->temperature, it->temperature, 1};
+        result = mergeAggregate(result, value);
+    }
+#else
+    // split the window at the buffer end
+    size_t first_slot = g_ringbuffer.slot(first);
+    size_t last_slot = first_slot + (last - first);
+    if (last_slot <= g_ringbuffer.content())
+    {
+        result = g_meas_index.query(first_slot, last_slot);
+    }
+    else
+    {
+        result = mergeAggregate(g_meas_index.query(first_slot, g_ringbuffer.content()),
+                                g_meas_index.query(0, last_slot - g_ringbuffer.content()));
+    }
+#endif
+    return result;
+}
 
-RingBuffer<measValue_t, RINGBUFFER_SIZE> g_ringbuffer(g_measvalue);
+aggregate_t getSensorStatistics(uint8_t sensor, time_t from, time_t to)
+{
+    if (sensor == 0)
+    {
+        return getMeasStatistics(from, to);
+    }
+    aggregate_t result = {0, 0, 0, 0};
+    SensorBuffer_t *buffer = getSensorBuffer(sensor);
+    if (!buffer)
+    {
+        return result;
+    }
+    size_t first = from ? findSensorValue(sensor, from) : 0;
+    size_t last = to ? findSensorValue(sensor, to + 1) : buffer->size();
+    for (size_t i = first; i < last; i++)
+    {
+        const measValue_t &value = buffer->readFirst(i);
+        aggregate_t element = {value.temperature, value.temperature, value.temperature, 1};
+        result = mergeAggregate(result, element);
+    }
+    return result;
+}
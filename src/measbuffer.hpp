@@ -9,17 +9,198 @@
 
 #include "localtime.h"
 #include "settings.hpp"
+#include "meas.h"
 
 #include "miniringbuffer.hpp"
+#include "compressedringbuffer.hpp"
+#include "rollup.hpp"
+#include "aggregateindex.hpp"
 
 
 // Rinbuffer
 // static const size_t RINGBUFFER_SIZE = 10 /*per hour*/ * 24 * 14/*days*/;
-typedef struct {
+// packed, the padding of the 64 bit timestamp would use the saved bytes again
+typedef struct __attribute__((packed)) {
     time_t timestamp;
-    float temperature;
+    int16_t temperature;    // mean of the store window [1/100 °C]
+    measQuality_t quality;  // min/max/standard deviation and sample counts of the store window
 } measValue_t;
 
 extern measValue_t g_measvalue;
 
-extern RingBuffer<measValue_t, RINGBUFFER_SIZE> g_ringbuffer;
+#ifdef MEASBUFFER_COMPRESSED
+/// Amount of compressed blocks (12 byte header per block), uses the RAM size of the 14 days buffer
+/// with 8 byte values (32 bit time, temperature), the quality fields are not stored compressed
+constexpr size_t COMPRESSED_BLOCK_COUNT = RINGBUFFER_SIZE * 8 / (COMPRESSED_BLOCK_SIZE + 12);
+typedef CompressedRingBuffer<measValue_t, COMPRESSED_BLOCK_COUNT, COMPRESSED_BLOCK_SIZE> MeasBuffer_t;
+#else
+typedef RingBuffer<measValue_t, RINGBUFFER_MAX_SIZE, OverflowOverwrite, HeapStorage> MeasBuffer_t;
+#endif
+
+extern MeasBuffer_t g_ringbuffer;
+
+// measurement buffer of the additional sensors, RAM only
+typedef RingBuffer<measValue_t, RINGBUFFER_MAX_SIZE, OverflowOverwrite, HeapStorage> SensorBuffer_t;
+
+#ifndef MEASBUFFER_COMPRESSED
+/// Amount of measurement values per leaf of the aggregate index
+constexpr size_t AGGREGATE_LEAF_SIZE = 16;
+// min/max/sum index of the measurement buffer
+extern AggregateIndex<AGGREGATE_LEAF_SIZE> g_meas_index;
+#endif
+
+// Rollup tiers for the long term history
+extern RollupTier<ROLLUP_HOURLY_SIZE> g_rollup_hourly;
+extern RollupTier<ROLLUP_DAILY_SIZE> g_rollup_daily;
+
+/**
+ * @brief Initializes the measurement buffers and the indexes, has to be
+ *        called in setup(); the largest free heap block minus
+ *        MEASBUFFER_HEAP_RESERVE is shared by the buffers of all sensors
+ *
+ * @return true buffers are allocated
+ * @return false no memory for RINGBUFFER_MIN_SIZE values of sensor 0
+ */
+bool initMeasBuffer(void);
+
+/**
+ * @brief Returns the RAM size of the measurement buffers and the index
+ *
+ * @return size_t size in bytes
+ */
+size_t getMeasBufferMemory(void);
+
+/**
+ * @brief Returns the buffer of an additional sensor
+ *
+ * @param sensor sensor number 1.., sensor 0 uses g_ringbuffer
+ * @return SensorBuffer_t* buffer, nullptr if the sensor has no buffer
+ */
+SensorBuffer_t *getSensorBuffer(uint8_t sensor);
+
+/**
+ * @brief Stores a measurement value of an additional sensor
+ *
+ * @param sensor sensor number 1..
+ * @param value averaged measurement value
+ */
+void storeSensorValue(uint8_t sensor, const measValue_t &value);
+
+/**
+ * @brief Binary search of a timestamp in the buffer of an additional sensor
+ *
+ * @param sensor sensor number 1..
+ * @param timestamp searched time
+ * @return size_t offset of the first value with a timestamp >= timestamp
+ */
+size_t findSensorValue(uint8_t sensor, time_t timestamp);
+
+/**
+ * @brief Returns the number of the oldest value of a buffer, the values are
+ *        numbered in the order they are added; the number of a value stays
+ *        the same if older values are dropped, other than its offset
+ *
+ * @param sensor sensor number, 0: measurement buffer, 1..: sensor buffers
+ * @return uint32_t number of the value at offset 0
+ */
+uint32_t getFirstValueNumber(uint8_t sensor);
+
+/**
+ * @brief Stores a measurement value to the measurement buffer, updates
+ *        the rollup tiers, the flash log and the archive
+ *
+ * @param value averaged measurement value
+ */
+void storeMeasValue(const measValue_t &value);
+
+/**
+ * @brief Stores the averaged value of a store window, in deadband mode
+ *        (parameter "Store deadband" > 0) the value is stored only if it
+ *        differs more than the deadband from the last stored value or if the
+ *        heartbeat interval is expired; the last skipped value is stored
+ *        before a changed value, a step is not drawn as a ramp
+ *
+ * @param sensor sensor number, 0: measurement buffer, 1..: sensor buffers
+ * @param value averaged measurement value with its exact timestamp
+ * @return true value was stored
+ * @return false value was skipped by the deadband
+ */
+bool storeWindowValue(uint8_t sensor, const measValue_t &value);
+
+/**
+ * @brief Stores the averages of the store window of all sensors with the
+ *        same timestamp, starts the next window and updates the RTC
+ *        snapshot; the buffer of an additional sensor waits for the first
+ *        sample of the sensor; has to be called in loop() at the end of the
+ *        store interval
+ *
+ * @param timestamp time of the store window, local time
+ * @return measValue_t value of sensor 0
+ */
+measValue_t storeMeasWindow(time_t timestamp);
+
+/// true if the empty measurement buffer gets its first value, the first processed sample is stored at once
+bool isFirstMeasWindow(void);
+
+/// amount of values skipped by the deadband since start
+uint32_t getSkippedValues(void);
+
+/**
+ * @brief Returns the average time between the values of the measurement
+ *        buffer, the values are not equidistant in deadband mode
+ *
+ * @return float average distance [sec], the store interval if there are
+ *         less than two values
+ */
+float getMeasValueSpacing(void);
+
+/**
+ * @brief Restores the rollup tiers from their file, the measurement buffer
+ *        from the flash log and prepares the archive, has to be called in
+ *        setup() after initMeasBuffer()
+ */
+void restoreMeasBuffer(void);
+
+/// true if restoreMeasBuffer() was called
+bool isMeasBufferRestored(void);
+
+/**
+ * @brief Writes the not saved measurement values and the rollup tiers to
+ *        the flash and the RTC snapshot, has to be called before a restart;
+ *        does nothing before restoreMeasBuffer()
+ */
+void saveMeasBuffer(void);
+
+/**
+ * @brief Binary search of a timestamp in the measurement buffer; the
+ *        timestamps are local time, at the end of the daylight saving time
+ *        an hour is repeated and the values are not ascending: a timestamp
+ *        of the repeated hour is found in the first or in the second pass,
+ *        a window inside of it can be empty
+ *
+ * @param timestamp searched time
+ * @return size_t offset (see readFirst) of the first value with a timestamp
+ *         >= timestamp, size() if all values are older
+ */
+size_t findMeasValue(time_t timestamp);
+
+/**
+ * @brief Get min/max/sum/count of the measurement values in a time window
+ *
+ * @param from oldest time of the window, 0: no limit
+ * @param to newest time of the window, 0: no limit
+ * @return aggregate_t aggregated values, count is 0 if no value is found
+ */
+aggregate_t getMeasStatistics(time_t from, time_t to);
+
+/**
+ * @brief Get min/max/sum/count of the values of a sensor in a time window,
+ *        the buffers of the additional sensors have no index, the values
+ *        are scanned
+ *
+ * @param sensor sensor number, 0: measurement buffer, see getMeasStatistics()
+ * @param from oldest time of the window, 0: no limit
+ * @param to newest time of the window, 0: no limit
+ * @return aggregate_t aggregated values, count is 0 if no value is found
+ */
+aggregate_t getSensorStatistics(uint8_t sensor, time_t from, time_t to);
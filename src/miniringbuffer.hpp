@@ -1,5 +1,5 @@
 /*
-    File        ringbuffer.h
+    File        miniringbuffer.hpp
     Author      Heiko Klausing (h.klausing at gmx dot de)
     Created     2020-07-31
 
@@ -18,7 +18,28 @@
         - Empty state: (m_head == 0) && !full
         - Reading of data has no effect to pointer, read data will not deleted
         - Buffer has to be filled with dummy values
-        - Buffer size must be known at compile time
+        - The stored elements are accessible as two contiguous spans,
+          oldest elements first (firstSpan, secondSpan)
+        - Random access iterators from the oldest to the newest element,
+          usable with range-for and STL algorithms
+        - Access by the buffer index (slot, readSlot), e.g. for indexes
+          that are maintained alongside of the buffer
+
+    Policies (template parameters)
+        - _OVERFLOW defines the add behaviour of a full buffer:
+            OverflowOverwrite       the oldest element is overwritten (default)
+            OverflowReject          the new element is rejected, add returns false
+            OverflowCallback<_T>    the oldest element is given to a handler
+                                    before it is overwritten (setEvictHandler)
+        - _STORAGE defines the memory of the elements:
+            StaticStorage           array inside of the object, size _NSIZE (default)
+            ExternalStorage         buffer provided by the caller (assign)
+            HeapStorage             buffer allocated at runtime (resize)
+          With ExternalStorage and HeapStorage _NSIZE is the upper limit
+          of the runtime size.
+        - A static storage with a power of two size uses mask indexing,
+          all other buffers wrap the index by a compare. No modulo
+          operation is used for add and for iterators.
 
     Usage:  const size_t BUFSIZE = 32;
             typedef struct {
@@ -28,6 +49,12 @@
             RingBuffer<data_t, BUFSIZE> ringbuffer(data_t(0,0));
             ringbuffer.add(data_t(1,2));
             ringbuffer.add(data_t(3,4));
+            for(auto &data : ringbuffer)
+                Serial.println(data.value1);
+
+            RingBuffer<data_t, 0xffff, OverflowCallback<data_t>, HeapStorage> heapbuffer(data_t(0,0));
+            heapbuffer.setEvictHandler(&storeOldData);
+            heapbuffer.resize(1000);
 */
 
 #pragma once
@@ -35,18 +62,155 @@
 #include <cstddef>
 #include <cstdint>
 #include <cassert>
+#include <iterator>
+#include <new>
+
+
+/*
+ * Overflow policies
+ */
+
+// a full buffer overwrites the oldest element
+class OverflowOverwrite
+{
+protected:
+    template <typename _T>
+    bool evict(const _T &) { return true; }
+};
+
+// a full buffer rejects new elements
+class OverflowReject
+{
+protected:
+    template <typename _T>
+    bool evict(const _T &) { return false; }
+};
+
+// a full buffer gives the oldest element to a handler before it is overwritten
+template <typename _T>
+class OverflowCallback
+{
+public:
+    typedef void (*evictHandler_t)(const _T &);
+
+    // defines the handler for evicted elements, nullptr disables the handler
+    void setEvictHandler(evictHandler_t handler) { m_handler = handler; }
 
+protected:
+    bool evict(const _T &data)
+    {
+        if(m_handler)
+            m_handler(data);
+        return true;
+    }
+
+private:
+    evictHandler_t m_handler = nullptr;
+};
 
+
+/*
+ * Storage policies
+ */
+
+// buffer is part of the object, size is known at compile time
 template <typename _T, size_t _NSIZE>
-class RingBuffer
+class StaticStorage
+{
+public:
+    static const bool IS_STATIC = true;
+protected:
+    _T *data() { return m_data; }
+    size_t capacity() const { return _NSIZE; }
+private:
+    _T m_data[_NSIZE];
+};
+
+// buffer is provided by the caller, size is limited by _NSIZE
+template <typename _T, size_t _NSIZE>
+class ExternalStorage
+{
+public:
+    static const bool IS_STATIC = false;
+protected:
+    _T *data() { return m_data; }
+    size_t capacity() const { return m_capacity; }
+    bool storageAssign(_T *buffer, size_t capacity)
+    {
+        if(capacity > _NSIZE)
+            return false;
+        m_data = buffer;
+        m_capacity = buffer ? capacity : 0;
+        return true;
+    }
+private:
+    _T *m_data = nullptr;
+    size_t m_capacity = 0;
+};
+
+// buffer is allocated at runtime, size is limited by _NSIZE
+template <typename _T, size_t _NSIZE>
+class HeapStorage
+{
+public:
+    static const bool IS_STATIC = false;
+    ~HeapStorage() { delete[] m_data; }
+protected:
+    _T *data() { return m_data; }
+    size_t capacity() const { return m_capacity; }
+    bool storageAllocate(size_t capacity)
+    {
+        if(capacity > _NSIZE)
+            return false;
+        delete[] m_data;
+        m_data = capacity ? new (std::nothrow) _T[capacity] : nullptr;
+        m_capacity = m_data ? capacity : 0;
+        return m_data || !capacity;
+    }
+private:
+    _T *m_data = nullptr;
+    size_t m_capacity = 0;
+};
+
+
+/*
+ * Index handling, selected at compile time
+ */
+
+// wraps an index in range 0..2*capacity-1 by a compare
+template <size_t _NSIZE, bool _MASK>
+struct RingIndex
+{
+    static size_t wrap(size_t index, size_t capacity)
+    {
+        return index < capacity ? index : index - capacity;
+    }
+};
+
+// wraps an index by a mask, used for static power of two sizes
+template <size_t _NSIZE>
+struct RingIndex<_NSIZE, true>
+{
+    static size_t wrap(size_t index, size_t)
+    {
+        return index & (_NSIZE - 1);
+    }
+};
+
+
+template <typename _T, size_t _NSIZE,
+          typename _OVERFLOW = OverflowOverwrite,
+          template <typename, size_t> class _STORAGE = StaticStorage>
+class RingBuffer : public _OVERFLOW, private _STORAGE<_T, _NSIZE>
 {
 private:
     /* Limits */
     static const size_t MAX_BUFFER_LENGTH = 0xffff;
+    typedef _STORAGE<_T, _NSIZE> storage_t;
+    typedef RingIndex<_NSIZE, storage_t::IS_STATIC && (_NSIZE & (_NSIZE - 1)) == 0> index_t;
     /* data */
     size_t      m_head;         // write pointer, points to next write index
     bool        m_full;         // status flag
-    _T          m_buffer[_NSIZE];   // buffer for data
 
     // NOTE: disable constructor, copy constructor and assignment operator
     RingBuffer(void) = delete;
@@ -54,6 +218,55 @@ private:
     RingBuffer& operator=(const RingBuffer&) & = delete;
 
 public:
+    // contiguous part of the buffer
+    typedef struct {
+        _T      *data;          // first element of the span
+        size_t  size;           // amount of elements in the span
+    } span_t;
+
+    // random access iterator, offset 0 is the oldest element
+    class iterator
+    {
+    private:
+        RingBuffer  *m_ring;
+        size_t      m_offset;
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef _T          value_type;
+        typedef ptrdiff_t   difference_type;
+        typedef _T*         pointer;
+        typedef _T&         reference;
+
+        iterator() : m_ring(nullptr), m_offset(0) {}
+        iterator(RingBuffer *ring, size_t offset) : m_ring(ring), m_offset(offset) {}
+
+        reference operator*() const { return m_ring->data()[m_ring->physicalIndex(m_offset)]; }
+        pointer operator->() const { return &**this; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        iterator& operator++() { m_offset++; return *this; }
+        iterator operator++(int) { iterator it(*this); m_offset++; return it; }
+        iterator& operator--() { m_offset--; return *this; }
+        iterator operator--(int) { iterator it(*this); m_offset--; return it; }
+        iterator& operator+=(difference_type n) { m_offset += n; return *this; }
+        iterator& operator-=(difference_type n) { m_offset -= n; return *this; }
+        iterator operator+(difference_type n) const { return iterator(m_ring, m_offset + n); }
+        iterator operator-(difference_type n) const { return iterator(m_ring, m_offset - n); }
+        friend iterator operator+(difference_type n, const iterator &it) { return it + n; }
+        difference_type operator-(const iterator &other) const { return (difference_type)m_offset - (difference_type)other.m_offset; }
+
+        bool operator==(const iterator &other) const { return m_offset == other.m_offset; }
+        bool operator!=(const iterator &other) const { return m_offset != other.m_offset; }
+        bool operator<(const iterator &other) const { return m_offset < other.m_offset; }
+        bool operator>(const iterator &other) const { return m_offset > other.m_offset; }
+        bool operator<=(const iterator &other) const { return m_offset <= other.m_offset; }
+        bool operator>=(const iterator &other) const { return m_offset >= other.m_offset; }
+
+        // offset of the element, usable with readFirst()
+        size_t offset() const { return m_offset; }
+    };
+
     RingBuffer(_T dummy)
         : m_head(0)
         , m_full(false)
@@ -86,28 +299,53 @@ public:
     // returns the amount of defined buffer elements
     size_t content()
     {
-        return _NSIZE;
+        return this->capacity();
     }
 
     // returns the amount of stored buffer elements
     size_t size()
     {
         if(isFull())
-            return _NSIZE;
+            return this->capacity();
         return m_head;
     }
 
-    // add the next element to the buffer
-    void add(const _T data) {
+    // HeapStorage only: allocates a buffer for capacity elements, the
+    // buffer is cleared; returns false if the memory is not available
+    bool resize(size_t capacity)
+    {
+        clear();
+        return this->storageAllocate(capacity);
+    }
+
+    // ExternalStorage only: uses the buffer of the caller, the buffer
+    // is cleared; returns false if the capacity is too large
+    bool assign(_T *buffer, size_t capacity)
+    {
+        clear();
+        return this->storageAssign(buffer, capacity);
+    }
+
+    // add the next element to the buffer, returns false if the element
+    // was rejected by the overflow policy or if no buffer is available
+    bool add(const _T data) {
+
+        if(!this->capacity())
+            return false;
+
+        // the oldest element will be overwritten
+        if(m_full && !this->evict(this->data()[m_head]))
+            return false;
 
         // add data ..
-        m_buffer[m_head] = data;
+        this->data()[m_head] = data;
 
         // .. and adjust the pointer and flags
-        m_head = (m_head + 1) % _NSIZE;
+        m_head = index_t::wrap(m_head + 1, this->capacity());
         if(m_head == 0) {
             m_full = true;
         }
+        return true;
     }
 
     // read values from the newest to be oldest
@@ -117,28 +355,84 @@ public:
     _T& readLast(size_t offset=0)
     {
         //assert(!isEmpty());
-        size_t offsetValue = offset % _NSIZE;
+        size_t offsetValue = wrapOffset(offset);
 
         if(m_full)
-            return m_buffer[((m_head + _NSIZE) - 1 - offsetValue) % _NSIZE];
+            return this->data()[index_t::wrap(m_head + this->capacity() - 1 - offsetValue, this->capacity())];
         else {
             assert(offsetValue < m_head );
         }
-        return m_buffer[m_head - 1 - offsetValue];
+        return this->data()[m_head - 1 - offsetValue];
     }
 
     // read elements from the oldest to the newest
     _T& readFirst(size_t offset=0)
     {
         //assert(!isEmpty());
-        size_t offsetValue = offset % _NSIZE;
+        size_t offsetValue = wrapOffset(offset);
 
         if(!m_full) {
             assert(offsetValue < m_head);
-            return m_buffer[offsetValue];
+            return this->data()[offsetValue];
         }
 
-        return m_buffer[(m_head + offsetValue) % _NSIZE];
+        return this->data()[index_t::wrap(m_head + offsetValue, this->capacity())];
     }
 
+    // buffer index of an element, offset 0 is the oldest element
+    size_t slot(size_t offset=0)
+    {
+        return physicalIndex(wrapOffset(offset));
+    }
+
+    // element at a buffer index, see slot()
+    _T& readSlot(size_t slot)
+    {
+        return this->data()[slot];
+    }
+
+    // iterator to the oldest element
+    iterator begin()
+    {
+        return iterator(this, 0);
+    }
+
+    // iterator behind the newest element
+    iterator end()
+    {
+        return iterator(this, size());
+    }
+
+    // span with the oldest elements
+    span_t firstSpan()
+    {
+        if(m_full)
+            return span_t{&this->data()[m_head], this->capacity() - m_head};
+        return span_t{this->data(), m_head};
+    }
+
+    // span with the newest elements, size is 0 if all elements are in the first span
+    span_t secondSpan()
+    {
+        if(m_full)
+            return span_t{this->data(), m_head};
+        return span_t{this->data(), 0};
+    }
+
+private:
+    // buffer index of an element, offset 0 is the oldest element
+    size_t physicalIndex(size_t offset)
+    {
+        return index_t::wrap((m_full ? m_head : 0) + offset, this->capacity());
+    }
+
+    // limits the offset to the buffer capacity, modulo is only used for
+    // offsets outside of the buffer; a buffer without memory (capacity 0)
+    // returns offset 0
+    size_t wrapOffset(size_t offset)
+    {
+        if(offset < this->capacity())
+            return offset;
+        return this->capacity() ? offset % this->capacity() : 0;
+    }
 };
@@ -10,6 +10,7 @@
 #include "settings.hpp"
 
 #include "parameter.hpp"
+#include "parameterlist.h"
 #include "settingshandler.h"
 
 //
@@ -48,6 +49,35 @@ float getTempCorrection(void)
     return value;
 }
 
+float getSensorCorrection(uint8_t sensor)
+{
+    // comma separated list, the first value belongs to sensor 1
+    const char *value = sensor ? getListEntry(parameter_list.sensor_corrections, sensor - 1) : nullptr;
+    return value ? atof(value) : 0.0;
+}
+
+float getStoreDeadband(void)
+{
+    return parameter_list.store_deadband > 0.0 ? parameter_list.store_deadband : 0.0;
+}
+
+uint32_t getStoreHeartbeat(void)
+{
+    int minutes = parameter_list.store_heartbeat > 0 ? parameter_list.store_heartbeat : STORE_HEARTBEAT_DEFAULT;
+    return minutes * 60;
+}
+
+bool getSensorAlarm(uint8_t sensor, int8_t &low, int8_t &high)
+{
+    // comma separated list of "low:high", the first entry belongs to sensor 0
+    return parseSensorAlarm(parameter_list.sensor_alarms, sensor, low, high);
+}
+
+bool isAlarmWatch(void)
+{
+    return parameter_list.alarm_watch == 1;
+}
+
 bool isEepromListValid(void)
 {
     return (
@@ -108,6 +138,11 @@ bool initializeParameterList(void)
     g_ih.addSettingItem("Hostname", InputType::IT_STRING, parameter_list.hostname);
     g_ih.addSettingItem("Location", InputType::IT_STRING, parameter_list.location);
     g_ih.addSettingItem("Temp. correction", InputType::IT_FLOAT, &parameter_list.temp_correction);
+    g_ih.addSettingItem("Sensor corrections", InputType::IT_STRING, parameter_list.sensor_corrections);
+    g_ih.addSettingItem("Store deadband", InputType::IT_FLOAT, &parameter_list.store_deadband);
+    g_ih.addSettingItem("Store heartbeat", InputType::IT_INTEGER, &parameter_list.store_heartbeat);
+    g_ih.addSettingItem("Sensor alarms", InputType::IT_STRING, parameter_list.sensor_alarms);
+    g_ih.addSettingItem("Alarm watch", InputType::IT_INTEGER, &parameter_list.alarm_watch);
     //logParameterList("after EEPROM copy");
 
     // load parameter list with data from EEPROM
@@ -124,6 +159,11 @@ bool initializeParameterList(void)
         strcpy(parameter_list.hostname, "hostname");
         strcpy(parameter_list.location, "location");
         parameter_list.temp_correction = 0.0;
+        strcpy(parameter_list.sensor_corrections, "");
+        parameter_list.store_deadband = 0.0;
+        parameter_list.store_heartbeat = STORE_HEARTBEAT_DEFAULT;
+        strcpy(parameter_list.sensor_alarms, "");
+        parameter_list.alarm_watch = 0;
         // inform user about next step
         Serial.println(F("*** Parameter values must be renewed, press 's' to insert required values! ***"));
         //logParameterList("after setting of default values");
@@ -150,6 +190,11 @@ void logParameterList(const char * info)
     Serial.printf("  Hostname: '%s'\n", parameter_list.hostname);
     Serial.printf("  Location: '%s'\n", parameter_list.location);
     Serial.printf("  temp.Correction: %f\n", parameter_list.temp_correction);
+    Serial.printf("  Sensor corrections: '%s'\n", parameter_list.sensor_corrections);
+    Serial.printf("  Store deadband: %f\n", parameter_list.store_deadband);
+    Serial.printf("  Store heartbeat: %i\n", parameter_list.store_heartbeat);
+    Serial.printf("  Sensor alarms: '%s'\n", parameter_list.sensor_alarms);
+    Serial.printf("  Alarm watch: %i\n", parameter_list.alarm_watch);
     Serial.printf("  Size: %i (exp. %i)\n", parameter_list.block_size, PARAMETER_BUFFER_SIZE);
     Serial.println();
 }
\ No newline at end of file
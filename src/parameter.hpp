@@ -23,6 +23,11 @@ typedef struct
     char hostname[STRING_SIZE]; // name of the host
     char location[STRING_SIZE]; // location of the temp-logger
     float temp_correction;      // correction value for temperature
+    char sensor_corrections[STRING_SIZE]; // correction values of the sensors 1.., e.g. "-0.5,0.25"
+    float store_deadband;       // a value is stored if it differs more from the last stored value [°C], 0: store all
+    int store_heartbeat;        // max. time between stored values in deadband mode [min]
+    char sensor_alarms[STRING_SIZE]; // alarm thresholds of the sensors 0.. [°C], e.g. "5:30,-10:40", empty: no alarm
+    int alarm_watch;            // 1: sampling by alarm search between the stored values
     int block_size; // size of this data block
 } ParameterList_t;
 
@@ -63,6 +68,46 @@ String getLocation(void);
  */
 float getTempCorrection(void);
 
+/**
+ * @brief Get the correction value of an additional sensor
+ *
+ * @param sensor sensor number 1.., sensor 0 uses getTempCorrection()
+ * @return float correction value, 0.0 if not defined
+ */
+float getSensorCorrection(uint8_t sensor);
+
+/**
+ * @brief Get the deadband of the change driven storage
+ *
+ * @return float deadband [°C], 0.0 if each value is stored
+ */
+float getStoreDeadband(void);
+
+/**
+ * @brief Get the max. time between two stored values in deadband mode
+ *
+ * @return uint32_t heartbeat interval [sec]
+ */
+uint32_t getStoreHeartbeat(void);
+
+/**
+ * @brief Get the alarm thresholds of a sensor
+ *
+ * @param sensor sensor number 0..
+ * @param low low threshold [°C], the alarm is set at or below this value
+ * @param high high threshold [°C], the alarm is set at or above this value
+ * @return true thresholds are defined
+ * @return false no alarm for this sensor
+ */
+bool getSensorAlarm(uint8_t sensor, int8_t &low, int8_t &high);
+
+/**
+ * @brief Return the status of the alarm watch mode
+ *
+ * @return true the sensors are sampled by alarm searches between the stored values
+ */
+bool isAlarmWatch(void);
+
 /**
  * @brief Return the status of the parameter list
  * 
@@ -0,0 +1,52 @@
+/*
+ * File         src/parameterlist.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Parsing of the comma separated per sensor lists of the parameters.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "parameterlist.h"
+
+
+const char *getListEntry(const char *list, uint8_t index)
+{
+    const char *entry = list;
+    for (uint8_t i = 0; i < index && entry; i++)
+    {
+        entry = strchr(entry, ',');
+        if (entry)
+        {
+            entry++;
+        }
+    }
+    return entry;
+}
+
+bool parseSensorAlarm(const char *list, uint8_t sensor, int8_t &low, int8_t &high)
+{
+    const char *entry = getListEntry(list, sensor);
+    if (!entry)
+    {
+        return false;
+    }
+    // "low:high", both numbers are required, e.g. "-5:" is no alarm above 0 °C
+    char *end;
+    long low_value = strtol(entry, &end, 10);
+    if (end == entry || *end != ':')
+    {
+        return false;
+    }
+    const char *separator = end;
+    long high_value = strtol(separator + 1, &end, 10);
+    if (end == separator + 1 || (*end != ',' && *end != '\0'))
+    {
+        return false;
+    }
+    // the sensor compares whole degrees within its range
+    low = constrain(low_value, -55L, 125L);
+    high = constrain(high_value, -55L, 125L);
+    return low < high;
+}
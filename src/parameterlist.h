@@ -0,0 +1,37 @@
+/*
+ * File         src/parameterlist.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Parsing of the comma separated per sensor lists of the
+ *              parameters, e.g. "Sensor alarms"; used by parameter.cpp and
+ *              the host build.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+
+/**
+ * @brief Returns an entry of a comma separated list
+ *
+ * @param list comma separated list
+ * @param index number of the entry 0..
+ * @return const char* start of the entry, nullptr if the list is shorter
+ */
+const char *getListEntry(const char *list, uint8_t index);
+
+/**
+ * @brief Parses the alarm thresholds of a sensor from a list of "low:high"
+ *        entries, the first entry belongs to sensor 0; an entry with other
+ *        characters than the two integers is not valid, the thresholds are
+ *        limited to the range of the sensor -55..125 °C
+ *
+ * @param list comma separated list of "low:high" entries
+ * @param sensor sensor number 0..
+ * @param low low threshold [°C]
+ * @param high high threshold [°C]
+ * @return true the entry of the sensor is valid and low < high
+ * @return false no alarm for this sensor
+ */
+bool parseSensorAlarm(const char *list, uint8_t sensor, int8_t &low, int8_t &high);
@@ -0,0 +1,310 @@
+/*
+ * File         src/responsewriter.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Streaming writer of the HTTP responses without heap memory.
+ */
+
+#include <stdarg.h>
+
+#include "responsewriter.h"
+#include "fixedpoint.hpp"
+
+
+ResponseWriter::ResponseWriter()
+    : m_length{0}
+    , m_send_pos{0}
+    , m_send_end{0}
+    , m_client{nullptr}
+    , m_size{0}
+    , m_first_chunk{0}
+    , m_min_free_heap{0}
+    , m_blocking_writes{0}
+{
+}
+
+ResponseWriter::~ResponseWriter() {}
+
+void ResponseWriter::begin(WiFiClient *client, const char *type, bool found)
+{
+    m_length = 0;
+    m_send_pos = 0;
+    m_send_end = 0;
+    m_client = client;
+    m_size = 0;
+    m_first_chunk = 0;
+    m_min_free_heap = ESP.getFreeHeap();
+    m_blocking_writes = 0;
+    // the header is small, it fits into the send buffer of a new connection
+    if (m_client)
+    {
+        if (found)
+            m_client->print(F("HTTP/1.1 200 OK\r\n"));
+        else
+            m_client->print(F("HTTP/1.1 404 Not Found\r\n"));
+        m_client->print(F("Transfer-Encoding: chunked\r\nContent-Type: "));
+        m_client->print(type);
+        m_client->print(F("\r\nConnection: close\r\n\r\n"));
+    }
+}
+
+void ResponseWriter::end(void)
+{
+    closeChunk();
+    // the last chunk is added behind the data chunk, the trailer space of
+    // the buffer is reserved for it
+    if (!m_send_end)
+    {
+        m_send_pos = CHUNK_HEADER_SIZE;
+        m_send_end = CHUNK_HEADER_SIZE;
+    }
+    memcpy(m_buffer + m_send_end, "0\r\n\r\n", 5);
+    m_send_end += 5;
+}
+
+void ResponseWriter::endStep(void)
+{
+    closeChunk();
+}
+
+bool ResponseWriter::send(void)
+{
+    if (m_send_end && m_client)
+    {
+        size_t length = min((size_t)m_client->availableForWrite(), m_send_end - m_send_pos);
+        if (length)
+        {
+            if (!m_first_chunk)
+            {
+                m_first_chunk = micros() | 1;
+            }
+            m_send_pos += m_client->write(reinterpret_cast<const uint8_t *>(m_buffer + m_send_pos), length);
+        }
+        if (m_send_pos < m_send_end)
+        {
+            return false;
+        }
+    }
+    m_send_pos = 0;
+    m_send_end = 0;
+    return true;
+}
+
+void ResponseWriter::flush(void)
+{
+    // an open chunk is written first, the data of the step follow it
+    closeChunk();
+    if (m_send_end && m_client)
+    {
+        if (!m_first_chunk)
+        {
+            m_first_chunk = micros() | 1;
+        }
+        m_client->write(reinterpret_cast<const uint8_t *>(m_buffer + m_send_pos), m_send_end - m_send_pos);
+        // the blocking write holds the data in the heap until it is acknowledged
+        sampleHeap();
+    }
+    m_send_pos = 0;
+    m_send_end = 0;
+}
+
+size_t ResponseWriter::available(void)
+{
+    return HTTP_BLOCK_SIZE - m_length;
+}
+
+bool ResponseWriter::isFull(void)
+{
+    return available() < HTTP_ROW_SIZE;
+}
+
+ResponseWriter &ResponseWriter::print(const char *text)
+{
+    size_t length = strlen(text);
+    while (length)
+    {
+        reserve(1);
+        size_t part = min(length, (size_t)(HTTP_BLOCK_SIZE - m_length));
+        memcpy(data() + m_length, text, part);
+        m_length += part;
+        text += part;
+        length -= part;
+    }
+    return *this;
+}
+
+ResponseWriter &ResponseWriter::print(const __FlashStringHelper *text)
+{
+    // the flash allows 32 bit access only, it is read by memcpy_P
+    PGM_P pos = reinterpret_cast<PGM_P>(text);
+    size_t length = strlen_P(pos);
+    while (length)
+    {
+        reserve(1);
+        size_t part = min(length, (size_t)(HTTP_BLOCK_SIZE - m_length));
+        memcpy_P(data() + m_length, pos, part);
+        m_length += part;
+        pos += part;
+        length -= part;
+    }
+    return *this;
+}
+
+ResponseWriter &ResponseWriter::print(const String &text)
+{
+    return print(text.c_str());
+}
+
+ResponseWriter &ResponseWriter::print(char c)
+{
+    reserve(1);
+    data()[m_length++] = c;
+    return *this;
+}
+
+ResponseWriter &ResponseWriter::print(long value)
+{
+    if (value < 0)
+    {
+        print('-');
+        // the absolute value of LONG_MIN fits into unsigned long
+        return print(0ul - (unsigned long)value);
+    }
+    return print((unsigned long)value);
+}
+
+ResponseWriter &ResponseWriter::print(unsigned long value)
+{
+    // digits from the right into a small buffer
+    char digits[20];
+    uint8_t count = 0;
+    do
+    {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while (value);
+    reserve(count);
+    while (count)
+    {
+        data()[m_length++] = digits[--count];
+    }
+    return *this;
+}
+
+ResponseWriter &ResponseWriter::print(int value)
+{
+    return print((long)value);
+}
+
+ResponseWriter &ResponseWriter::print(unsigned int value)
+{
+    return print((unsigned long)value);
+}
+
+ResponseWriter &ResponseWriter::print(double value, uint8_t decimals)
+{
+    return printf("%.*f", decimals, value);
+}
+
+ResponseWriter &ResponseWriter::printTemp(int32_t centi, uint8_t decimals)
+{
+    reserve(TEMP_FORMAT_SIZE);
+    m_length += strlen(formatTemp(data() + m_length, centi, decimals));
+    return *this;
+}
+
+ResponseWriter &ResponseWriter::printTime(time_t epoch)
+{
+    // gmtime is used to convert to localtime, because the epoch value is localtime
+    struct tm ts = *gmtime(&epoch);
+    reserve(20);
+    m_length += strftime(data() + m_length, 20, "%Y-%m-%d %X", &ts);
+    return *this;
+}
+
+ResponseWriter &ResponseWriter::printf(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(data() + m_length, HTTP_BLOCK_SIZE - m_length + 1, format, args);
+    va_end(args);
+    // the conversion of a float takes heap memory
+    sampleHeap();
+    if (length > 0 && m_length + length > HTTP_BLOCK_SIZE)
+    {
+        // the text does not fit, it is written again into the empty buffer
+        m_blocking_writes++;
+        flush();
+        va_start(args, format);
+        length = vsnprintf(data(), HTTP_BLOCK_SIZE + 1, format, args);
+        va_end(args);
+        length = min(length, (int)HTTP_BLOCK_SIZE);
+    }
+    m_length += length > 0 ? length : 0;
+    return *this;
+}
+
+uint32_t ResponseWriter::size(void)
+{
+    return m_size + m_length;
+}
+
+uint32_t ResponseWriter::getFirstChunkTime(void)
+{
+    return m_first_chunk;
+}
+
+uint32_t ResponseWriter::getMinFreeHeap(void)
+{
+    uint32_t free_heap = ESP.getFreeHeap();
+    return free_heap < m_min_free_heap ? free_heap : m_min_free_heap;
+}
+
+uint32_t ResponseWriter::getBlockingWrites(void)
+{
+    return m_blocking_writes;
+}
+
+/*****************************************************************************
+ * private methods
+ *****************************************************************************/
+
+char *ResponseWriter::data(void)
+{
+    return m_buffer + CHUNK_HEADER_SIZE;
+}
+
+void ResponseWriter::reserve(size_t length)
+{
+    if (m_length + length > HTTP_BLOCK_SIZE)
+    {
+        // the step is larger than the buffer
+        m_blocking_writes++;
+        flush();
+    }
+}
+
+void ResponseWriter::sampleHeap(void)
+{
+    uint32_t free_heap = ESP.getFreeHeap();
+    m_min_free_heap = free_heap < m_min_free_heap ? free_heap : m_min_free_heap;
+}
+
+void ResponseWriter::closeChunk(void)
+{
+    if (!m_length)
+    {
+        return;
+    }
+    sampleHeap();
+    // the chunk size is written in front of the data and CR LF behind it,
+    // the chunk is sent as one block
+    char header[CHUNK_HEADER_SIZE + 1];
+    size_t header_length = snprintf(header, sizeof(header), "%X\r\n", (unsigned int)m_length);
+    memcpy(data() - header_length, header, header_length);
+    memcpy(data() + m_length, "\r\n", 2);
+    m_send_pos = CHUNK_HEADER_SIZE - header_length;
+    m_send_end = CHUNK_HEADER_SIZE + m_length + 2;
+    m_size += m_length;
+    m_length = 0;
+}
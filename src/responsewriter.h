@@ -0,0 +1,158 @@
+/*
+ * File         src/responsewriter.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Streaming writer of the HTTP responses without heap memory.
+ *              The page content is serialized in place into a buffer of
+ *              HTTP_BLOCK_SIZE bytes. Texts in flash (F()), integers, fixed
+ *              point temperatures and timestamps are written directly to the
+ *              buffer, no String is created.
+ *              A page is written in steps: after a step the buffer is closed
+ *              as one chunk of the chunked transfer encoding and sent by
+ *              send() as far as the client takes data, without waiting. The
+ *              next step is written after the chunk was sent. A step that
+ *              does not fit into the buffer is sent with a blocking write.
+ *              The lowest free heap is sampled before each chunk, after a
+ *              blocking write and after printf().
+ *
+ *    Usage:    ResponseWriter out;
+ *              out.begin(&client, "application/json");
+ *              out.print(F("{\"count\":")).print(count);
+ *              out.print(F(",\"avg\":")).printTemp(avg, 2).print('}');
+ *              out.end();
+ *              while (!out.send())
+ *                  ;
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+
+#include "settings.hpp"
+
+
+class ResponseWriter
+{
+private:
+    // space for the chunk size (hex) and CR LF in front of the data
+    static const size_t CHUNK_HEADER_SIZE = 8;
+    // CR LF behind the data and the last chunk "0\r\n\r\n"
+    static const size_t CHUNK_TRAILER_SIZE = 2 + 5;
+
+    /* data */
+    char m_buffer[CHUNK_HEADER_SIZE + HTTP_BLOCK_SIZE + CHUNK_TRAILER_SIZE]; // chunk header, data and trailer
+    size_t m_length;                // amount of data in the buffer
+    size_t m_send_pos;              // position of the next byte to send in m_buffer
+    size_t m_send_end;              // end of the closed chunk in m_buffer, 0: no chunk to send
+    WiFiClient *m_client;           // receiver of the chunks, nullptr: only counted
+    uint32_t m_size;                // amount of sent data bytes
+    uint32_t m_first_chunk;         // micros() of the first chunk, 0: nothing sent
+    uint32_t m_min_free_heap;       // lowest free heap during the response [byte]
+    uint32_t m_blocking_writes;     // amount of steps that did not fit into the buffer
+
+    char *data(void);
+    void reserve(size_t length);
+    void sampleHeap(void);
+    void closeChunk(void);
+
+public:
+    ResponseWriter();
+    ~ResponseWriter();
+
+    /**
+     * @brief Starts a response, the HTTP header of a chunked response is sent
+     *
+     * @param client receiver of the response, nullptr: the size is counted only
+     * @param type content type, e.g. "text/html", "application/json"
+     * @param found false: the status is "404 Not Found", the page is the error page
+     */
+    void begin(WiFiClient *client, const char *type, bool found = true);
+
+    /**
+     * @brief Closes the last step and adds the last chunk, the response is
+     * sent by send()
+     */
+    void end(void);
+
+    /**
+     * @brief Closes a step of the page, the buffer is sent by send()
+     */
+    void endStep(void);
+
+    /**
+     * @brief Sends the closed chunk as far as the client takes data, without
+     * waiting
+     *
+     * @return true the chunk is sent, the next step can be written
+     * @return false data are left, send() has to be called again
+     */
+    bool send(void);
+
+    /// sends the buffer with a blocking write, for a step larger than the buffer
+    void flush(void);
+
+    /// free space in the buffer for the current step [byte]
+    size_t available(void);
+
+    /// true if less than a row (HTTP_ROW_SIZE) fits into the buffer, the step should end
+    bool isFull(void);
+
+    /// writes a text of the RAM
+    ResponseWriter &print(const char *text);
+
+    /// writes a text of the flash, see F()
+    ResponseWriter &print(const __FlashStringHelper *text);
+
+    /// writes a String, for values of the SDK (e.g. IP address)
+    ResponseWriter &print(const String &text);
+
+    /// writes a character
+    ResponseWriter &print(char c);
+
+    /// writes a decimal number
+    ResponseWriter &print(long value);
+
+    /// writes a decimal number
+    ResponseWriter &print(unsigned long value);
+
+    /// writes a decimal number
+    ResponseWriter &print(int value);
+
+    /// writes a decimal number
+    ResponseWriter &print(unsigned int value);
+
+    /// writes a float number, for the settings and statistics only
+    ResponseWriter &print(double value, uint8_t decimals = 2);
+
+    /**
+     * @brief Writes a temperature without float, see formatTemp()
+     *
+     * @param centi temperature [1/100 °C]
+     * @param decimals amount of decimals 0..2
+     */
+    ResponseWriter &printTemp(int32_t centi, uint8_t decimals);
+
+    /// writes a local time epoch as ISO8601 text "YYYY-MM-DD hh:mm:ss"
+    ResponseWriter &printTime(time_t epoch);
+
+    /**
+     * @brief Writes a formatted text, the text is written in place; a text
+     * longer than HTTP_BLOCK_SIZE is cut
+     *
+     * @param format printf format
+     */
+    ResponseWriter &printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+    /// amount of written data bytes
+    uint32_t size(void);
+
+    /// micros() of the first chunk, 0 if nothing was sent
+    uint32_t getFirstChunkTime(void);
+
+    /// lowest free heap since begin(), sampled at each chunk, blocking write and printf() [byte]
+    uint32_t getMinFreeHeap(void);
+
+    /// amount of steps since begin() that were sent with a blocking write
+    uint32_t getBlockingWrites(void);
+};
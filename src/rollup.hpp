@@ -0,0 +1,270 @@
+/*
+ * File         src/rollup.hpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Rollup tiers for the long term history (RRD like).
+ *              A tier collects values for a fixed period (e.g. one hour)
+ *              and stores min/avg/max of the period into its own ring buffer.
+ *              Tiers can be cascaded, the closed period of a tier is the
+ *              input of the next tier (hour -> day).
+ *              Periods are aligned to the epoch value, with local time
+ *              epochs a day period starts at local midnight.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#include <algorithm>
+
+#include "fixedpoint.hpp"
+#include "miniringbuffer.hpp"
+
+
+// rollup element, temperatures in 1/100 °C like the measurement values
+typedef struct __attribute__((packed))
+{
+    uint32_t timestamp;     // start time of the period
+    int16_t min;            // minimum temperature of the period
+    int16_t avg;            // average temperature of the period
+    int16_t max;            // maximum temperature of the period
+} rollupValue_t;
+
+// current period of a tier, see RollupTier::getState()
+typedef struct
+{
+    uint32_t start;         // start time of the current period
+    int32_t min;            // minimum of the current period
+    int32_t max;            // maximum of the current period
+    int32_t sum;            // sum of the current period
+    uint16_t count;         // amount of values in the current period
+    uint16_t closed_count;  // amount of values of the last closed period
+} rollupState_t;
+
+
+template <size_t _NSIZE>
+class RollupTier
+{
+private:
+    /* data */
+    RingBuffer<rollupValue_t, _NSIZE> m_buffer;  // closed periods
+    uint32_t m_period;          // period length [sec]
+    uint32_t m_start;           // start time of the current period
+    int32_t m_min;              // minimum of the current period
+    int32_t m_max;              // maximum of the current period
+    int32_t m_sum;              // sum of the current period
+    uint16_t m_count;           // amount of values in the current period
+    uint16_t m_closed_count;    // amount of values of the last closed period
+    uint32_t m_closed_periods;  // amount of closed periods since the start, see firstNumber()
+
+    // NOTE: disable constructor, copy constructor and assignment operator
+    RollupTier(void) = delete;
+    RollupTier(const RollupTier&) = delete;
+    RollupTier& operator=(const RollupTier&) & = delete;
+
+public:
+    RollupTier(uint32_t period)
+        : m_buffer(rollupValue_t{0, 0, 0, 0})
+        , m_period{period}
+        , m_start{0}
+        , m_min{0}
+        , m_max{0}
+        , m_sum{0}
+        , m_count{0}
+        , m_closed_count{0}
+        , m_closed_periods{0}
+    {
+    }
+
+    ~RollupTier() {}
+
+    /**
+     * @brief Add a single measurement value to the tier
+     *
+     * @param timestamp time of the value
+     * @param temperature value in 1/100 °C
+     * @return true the previous period was closed, see readLast() and closedCount()
+     * @return false value was added to the current period
+     */
+    bool add(time_t timestamp, int16_t temperature)
+    {
+        return accumulate(timestamp, temperature, temperature, temperature, 1);
+    }
+
+    /**
+     * @brief Add a closed period of a finer tier to this tier
+     *
+     * @param value closed period of the finer tier
+     * @param count amount of values of the closed period, weight of the average
+     * @return true the previous period was closed, see readLast() and closedCount()
+     * @return false value was added to the current period
+     */
+    bool add(const rollupValue_t &value, uint16_t count)
+    {
+        return accumulate(value.timestamp, value.min, value.max, (int32_t)value.avg * count, count);
+    }
+
+    /**
+     * @brief Closes the current period if the timestamp is outside of it; a
+     *        tier fed by a finer tier gets the last part of a period only
+     *        with the close of the finer period, e.g. the day with the first
+     *        hour of the next day, this closes it with the first value
+     *
+     * @param timestamp time of the newest value
+     * @return true the current period was closed, see readLast() and closedCount()
+     * @return false the timestamp is inside of the current period or there is no one
+     */
+    bool close(time_t timestamp)
+    {
+        uint32_t start = (uint32_t)timestamp - ((uint32_t)timestamp % m_period);
+        if (!m_count || start == m_start)
+        {
+            return false;
+        }
+        closeCurrent();
+        return true;
+    }
+
+    // amount of stored (closed) periods
+    size_t size(void)
+    {
+        return m_buffer.size();
+    }
+
+    // amount of storable periods
+    size_t content(void)
+    {
+        return m_buffer.content();
+    }
+
+    // period length [sec]
+    uint32_t period(void)
+    {
+        return m_period;
+    }
+
+    // amount of values of the last closed period
+    uint16_t closedCount(void)
+    {
+        return m_closed_count;
+    }
+
+    // read closed periods from the oldest to the newest
+    rollupValue_t &readFirst(size_t offset = 0)
+    {
+        return m_buffer.readFirst(offset);
+    }
+
+    // read closed periods from the newest to the oldest
+    rollupValue_t &readLast(size_t offset = 0)
+    {
+        return m_buffer.readLast(offset);
+    }
+
+    // number of the oldest closed period, the periods are numbered in the
+    // order they are closed, the number stays if older periods are dropped
+    uint32_t firstNumber(void)
+    {
+        return m_closed_periods - (uint32_t)m_buffer.size();
+    }
+
+    // returns the offset of the first closed period with a start time >= timestamp
+    size_t lowerBound(time_t timestamp)
+    {
+        return std::lower_bound(m_buffer.begin(), m_buffer.end(), (uint32_t)timestamp,
+                                [](const rollupValue_t &value, uint32_t time) { return value.timestamp < time; })
+            .offset();
+    }
+
+    // true if the current period has values
+    bool hasCurrent(void)
+    {
+        return m_count > 0;
+    }
+
+    // the not closed current period
+    rollupValue_t current(void)
+    {
+        return makeValue();
+    }
+
+    // state of the current period, saved with the closed periods
+    rollupState_t getState(void)
+    {
+        return rollupState_t{m_start, m_min, m_max, m_sum, m_count, m_closed_count};
+    }
+
+    // removes all periods, the saved periods are added by restoreClosed()
+    // and restoreState()
+    void clear(void)
+    {
+        m_buffer.clear();
+        m_count = 0;
+        m_closed_count = 0;
+        m_closed_periods = 0;
+    }
+
+    // adds a saved closed period, from the oldest to the newest
+    void restoreClosed(const rollupValue_t &value)
+    {
+        m_buffer.add(value);
+        m_closed_periods++;
+    }
+
+    // sets the saved state of the current period
+    void restoreState(const rollupState_t &state)
+    {
+        m_start = state.start;
+        m_min = state.min;
+        m_max = state.max;
+        m_sum = state.sum;
+        m_count = state.count;
+        m_closed_count = state.closed_count;
+    }
+
+private:
+    bool accumulate(time_t timestamp, int32_t min, int32_t max, int32_t sum, uint16_t count)
+    {
+        bool closed = false;
+        uint32_t start = (uint32_t)timestamp - ((uint32_t)timestamp % m_period);
+
+        if (m_count && start != m_start)
+        {
+            // period is finished, store it
+            closeCurrent();
+            closed = true;
+        }
+
+        if (m_count == 0)
+        {
+            m_start = start;
+            m_min = min;
+            m_max = max;
+            m_sum = 0;
+        }
+        m_min = min < m_min ? min : m_min;
+        m_max = max > m_max ? max : m_max;
+        m_sum += sum;
+        m_count += count;
+
+        return closed;
+    }
+
+    void closeCurrent(void)
+    {
+        m_buffer.add(makeValue());
+        m_closed_periods++;
+        m_closed_count = m_count;
+        m_count = 0;
+    }
+
+    rollupValue_t makeValue(void)
+    {
+        rollupValue_t value;
+        value.timestamp = m_start;
+        value.min = (int16_t)m_min;
+        value.avg = (int16_t)(m_count ? divRound(m_sum, m_count) : 0);
+        value.max = (int16_t)m_max;
+        return value;
+    }
+};
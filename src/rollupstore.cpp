@@ -0,0 +1,182 @@
+/*
+ * File         src/rollupstore.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Saves the rollup tiers to LittleFS.
+ */
+
+#include <LittleFS.h>
+#include <coredecls.h>
+
+#include "rollupstore.h"
+
+
+// amount of periods per file access
+static const size_t ROLLUP_CHUNK_VALUES = 32;
+
+
+RollupStore::RollupStore()
+    : m_last_value{0}
+    , m_saves{0}
+    , m_load_time{0}
+{
+}
+
+RollupStore::~RollupStore() {}
+
+bool RollupStore::load(void)
+{
+    uint32_t start = millis();
+    file_header_t header;
+    File file = LittleFS.open(ROLLUP_FILE, "r");
+    if (!file)
+    {
+        return false;
+    }
+    if (file.read((uint8_t *)&header, sizeof(header)) != sizeof(header)
+        || header.magic != FILE_MAGIC
+        || header.value_size != sizeof(rollupValue_t)
+        || header.hourly_count > ROLLUP_HOURLY_SIZE
+        || header.daily_count > ROLLUP_DAILY_SIZE)
+    {
+        Serial.println(F("rollup tiers: file not valid"));
+        file.close();
+        return false;
+    }
+
+    uint32_t header_crc = header.crc;
+    header.crc = 0;
+    uint32_t crc = crc32(&header, sizeof(header));
+    bool read = readTier(file, g_rollup_hourly, header.hourly_count, crc)
+                && readTier(file, g_rollup_daily, header.daily_count, crc);
+    file.close();
+    if (!read || crc != header_crc)
+    {
+        // an incomplete history is not used, the flash log rebuilds its part
+        Serial.println(F("rollup tiers: CRC error"));
+        g_rollup_hourly.clear();
+        g_rollup_daily.clear();
+        return false;
+    }
+    g_rollup_hourly.restoreState(header.hourly);
+    g_rollup_daily.restoreState(header.daily);
+    m_last_value = header.last_value;
+
+    m_load_time = millis() - start;
+    Serial.printf("rollup tiers: %u hours, %u days restored in %u ms\n",
+                  header.hourly_count, header.daily_count, m_load_time);
+    return true;
+}
+
+bool RollupStore::save(void)
+{
+    if (!m_last_value)
+    {
+        return false;
+    }
+    file_header_t header;
+    header.magic = FILE_MAGIC;
+    header.value_size = sizeof(rollupValue_t);
+    header.hourly_count = g_rollup_hourly.size();
+    header.daily_count = g_rollup_daily.size();
+    header.reserved = 0;
+    header.last_value = (uint32_t)m_last_value;
+    header.hourly = g_rollup_hourly.getState();
+    header.daily = g_rollup_daily.getState();
+    header.crc = 0;
+
+    File file = LittleFS.open(ROLLUP_TEMP_FILE, "w");
+    if (!file)
+    {
+        Serial.println(F("ERROR: rollup tiers not saved!"));
+        return false;
+    }
+    // the CRC is written to the header after the periods
+    uint32_t crc = crc32(&header, sizeof(header));
+    bool written = file.write((const uint8_t *)&header, sizeof(header)) == sizeof(header)
+                   && writeTier(file, g_rollup_hourly, crc)
+                   && writeTier(file, g_rollup_daily, crc);
+    header.crc = crc;
+    written = written && file.seek(0) && file.write((const uint8_t *)&header, sizeof(header)) == sizeof(header);
+    file.close();
+
+    // the previous file is replaced only by a complete file
+    if (!written || !LittleFS.rename(ROLLUP_TEMP_FILE, ROLLUP_FILE))
+    {
+        Serial.println(F("ERROR: rollup tiers not saved!"));
+        LittleFS.remove(ROLLUP_TEMP_FILE);
+        return false;
+    }
+    m_saves++;
+    return true;
+}
+
+void RollupStore::update(time_t timestamp)
+{
+    m_last_value = timestamp;
+}
+
+time_t RollupStore::getLastValue(void)
+{
+    return m_last_value;
+}
+
+uint32_t RollupStore::getSaves(void)
+{
+    return m_saves;
+}
+
+uint32_t RollupStore::getLoadTime(void)
+{
+    return m_load_time;
+}
+
+/*****************************************************************************
+ * private methods
+ *****************************************************************************/
+
+template <size_t _NSIZE>
+bool RollupStore::writeTier(File &file, RollupTier<_NSIZE> &tier, uint32_t &crc)
+{
+    rollupValue_t values[ROLLUP_CHUNK_VALUES];
+    for (size_t offset = 0; offset < tier.size(); offset += ROLLUP_CHUNK_VALUES)
+    {
+        size_t count = min(ROLLUP_CHUNK_VALUES, tier.size() - offset);
+        for (size_t i = 0; i < count; i++)
+        {
+            values[i] = tier.readFirst(offset + i);
+        }
+        crc = crc32(values, count * sizeof(rollupValue_t), crc);
+        if (file.write((const uint8_t *)values, count * sizeof(rollupValue_t)) != count * sizeof(rollupValue_t))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <size_t _NSIZE>
+bool RollupStore::readTier(File &file, RollupTier<_NSIZE> &tier, uint16_t count, uint32_t &crc)
+{
+    rollupValue_t values[ROLLUP_CHUNK_VALUES];
+    tier.clear();
+    while (count)
+    {
+        size_t chunk = min((size_t)count, ROLLUP_CHUNK_VALUES);
+        if (file.read((uint8_t *)values, chunk * sizeof(rollupValue_t)) != chunk * sizeof(rollupValue_t))
+        {
+            return false;
+        }
+        crc = crc32(values, chunk * sizeof(rollupValue_t), crc);
+        for (size_t i = 0; i < chunk; i++)
+        {
+            tier.restoreClosed(values[i]);
+        }
+        count -= chunk;
+    }
+    return true;
+}
+
+
+// storage of the rollup tiers
+RollupStore g_rollup_store;
@@ -0,0 +1,97 @@
+/*
+ * File         src/rollupstore.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Saves the rollup tiers to LittleFS, the long term history
+ *              is kept over restarts and OTA updates.
+ *              The hourly and the daily tier are written as one file with a
+ *              header and a CRC, once per closed day and before a restart.
+ *              The file is written to a temporary file and renamed, an
+ *              interrupted write keeps the previous file.
+ *              The values stored after the saved time are added again by the
+ *              restore of the flash log.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+
+#include "settings.hpp"
+#include "measbuffer.hpp"
+
+
+class RollupStore
+{
+private:
+    static const uint32_t FILE_MAGIC = 0x52555031; // "RUP1"
+
+    // file header, followed by the hourly and the daily periods
+    typedef struct
+    {
+        uint32_t magic;         // file identification
+        uint16_t value_size;    // size of a period, detects format changes
+        uint16_t hourly_count;  // amount of hourly periods
+        uint16_t daily_count;   // amount of daily periods
+        uint16_t reserved;
+        uint32_t last_value;    // timestamp of the newest value in the tiers
+        rollupState_t hourly;   // current period of the hourly tier
+        rollupState_t daily;    // current period of the daily tier
+        uint32_t crc;           // CRC32 of the header (crc = 0) and the periods
+    } file_header_t;
+
+    /* data */
+    time_t m_last_value;        // timestamp of the newest value in the tiers
+    uint32_t m_saves;           // amount of saves since start
+    uint32_t m_load_time;       // time [ms] to load the tiers
+
+    template <size_t _NSIZE>
+    bool writeTier(File &file, RollupTier<_NSIZE> &tier, uint32_t &crc);
+    template <size_t _NSIZE>
+    bool readTier(File &file, RollupTier<_NSIZE> &tier, uint16_t count, uint32_t &crc);
+
+public:
+    RollupStore();
+    ~RollupStore();
+
+    /**
+     * @brief Loads the saved tiers, the file system has to be mounted
+     *
+     * @return true tiers are restored
+     * @return false no valid file, the tiers are empty
+     */
+    bool load(void);
+
+    /**
+     * @brief Saves both tiers
+     *
+     * @return true tiers are saved
+     * @return false write error
+     */
+    bool save(void);
+
+    /**
+     * @brief Has to be called for each value that is added to the tiers
+     *
+     * @param timestamp time of the value
+     */
+    void update(time_t timestamp);
+
+    /**
+     * @brief Returns the timestamp of the newest value in the tiers, values
+     *        up to this time are already part of the tiers
+     *
+     * @return time_t timestamp, 0 if the tiers are empty
+     */
+    time_t getLastValue(void);
+
+    /// amount of saves since start
+    uint32_t getSaves(void);
+
+    /// time [ms] used to load the tiers
+    uint32_t getLoadTime(void);
+};
+
+
+// storage of the rollup tiers
+extern RollupStore g_rollup_store;
@@ -0,0 +1,124 @@
+/*
+ * File         src/rtcsnapshot.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Snapshot of the newest measurement values in the RTC user memory.
+ */
+
+#include <TimeLib.h>
+#include <coredecls.h>
+#include <user_interface.h>
+
+#include "rtcsnapshot.h"
+#include "timehelper.h"
+#include "macros.h"
+
+
+RtcSnapshot::RtcSnapshot()
+    : m_warm_start{false}
+    , m_restore_time{0}
+{
+}
+
+RtcSnapshot::~RtcSnapshot() {}
+
+void RtcSnapshot::save(bool controlled)
+{
+    uint32_t now_ms = millis();
+
+    m_snapshot.magic = SNAPSHOT_MAGIC;
+    // the time can only be used if it was set by NTP or a snapshot
+    m_snapshot.controlled = controlled && timeStatus() != timeNotSet ? 1 : 0;
+    m_snapshot.utc_time = now();
+    m_snapshot.start_timestamp = g_timer_values.start_timestamp;
+    m_snapshot.next_meas = g_timer_values.next_meas_temp > now_ms ? g_timer_values.next_meas_temp - now_ms : 0;
+    m_snapshot.next_store = g_timer_values.next_store_temp > now_ms ? g_timer_values.next_store_temp - now_ms : 0;
+    g_temp_meas.getAverageState(m_snapshot.average);
+
+    // newest values, oldest first
+    m_snapshot.count = g_ringbuffer.size() < RTCSNAPSHOT_VALUES ? g_ringbuffer.size() : RTCSNAPSHOT_VALUES;
+    for (uint32_t i = 0; i < m_snapshot.count; i++)
+    {
+        m_snapshot.values[i] = g_ringbuffer.readLast(m_snapshot.count - 1 - i);
+    }
+
+    m_snapshot.crc = 0;
+    m_snapshot.crc = snapshotCrc();
+    ESP.rtcUserMemoryWrite(RTCSNAPSHOT_OFFSET, (uint32_t *)&m_snapshot, sizeof(m_snapshot));
+}
+
+bool RtcSnapshot::restore(time_t &utc_time)
+{
+    uint32_t start = micros();
+    m_warm_start = false;
+
+    // the RTC memory is only valid after a soft reset
+    uint32_t reason = ESP.getResetInfoPtr()->reason;
+    if (reason != REASON_SOFT_RESTART && reason != REASON_EXCEPTION_RST
+        && reason != REASON_SOFT_WDT_RST && reason != REASON_WDT_RST)
+    {
+        return false;
+    }
+
+    ESP.rtcUserMemoryRead(RTCSNAPSHOT_OFFSET, (uint32_t *)&m_snapshot, sizeof(m_snapshot));
+    uint32_t crc = m_snapshot.crc;
+    m_snapshot.crc = 0;
+    if (m_snapshot.magic != SNAPSHOT_MAGIC || crc != snapshotCrc() || m_snapshot.count > RTCSNAPSHOT_VALUES)
+    {
+        DEBUG_PRINTLN("RTC snapshot not valid");
+        return false;
+    }
+    // use the snapshot only once
+    m_snapshot.magic = 0;
+    ESP.rtcUserMemoryWrite(RTCSNAPSHOT_OFFSET, (uint32_t *)&m_snapshot, sizeof(uint32_t));
+
+    // add the values that are not restored by the flash log
+    time_t newest = g_ringbuffer.size() ? g_ringbuffer.readLast().timestamp : 0;
+    for (uint32_t i = 0; i < m_snapshot.count; i++)
+    {
+        if (m_snapshot.values[i].timestamp > newest)
+        {
+            storeMeasValue(m_snapshot.values[i]);
+        }
+    }
+    g_temp_meas.setAverageState(m_snapshot.average);
+
+    if (m_snapshot.controlled)
+    {
+        // restart time is short, the time since the reset is known by millis()
+        uint32_t now_ms = millis();
+        utc_time = m_snapshot.utc_time + (now_ms + RTCSNAPSHOT_RESTART_TIME) / 1000;
+        g_timer_values.start_timestamp = m_snapshot.start_timestamp;
+        g_timer_values.next_meas_temp = now_ms + m_snapshot.next_meas;
+        g_timer_values.next_store_temp = now_ms + m_snapshot.next_store;
+        m_warm_start = true;
+    }
+
+    m_restore_time = micros() - start;
+    Serial.printf("RTC snapshot: %u values, %s, %u us\n", m_snapshot.count,
+                  m_warm_start ? "warm start" : "time not valid", m_restore_time);
+    return m_warm_start;
+}
+
+bool RtcSnapshot::isWarmStart(void)
+{
+    return m_warm_start;
+}
+
+uint32_t RtcSnapshot::getRestoreTime(void)
+{
+    return m_restore_time;
+}
+
+/*****************************************************************************
+ * private methods
+ *****************************************************************************/
+
+uint32_t RtcSnapshot::snapshotCrc(void)
+{
+    return crc32(&m_snapshot, sizeof(m_snapshot));
+}
+
+
+// RTC memory snapshot
+RtcSnapshot g_rtc_snapshot;
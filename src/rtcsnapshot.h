@@ -0,0 +1,84 @@
+/*
+ * File         src/rtcsnapshot.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Snapshot of the newest measurement values, the average state
+ *              and the timer schedule in the RTC user memory. The RTC memory
+ *              keeps its content during a soft reset, so the logger can
+ *              continue without a gap after /restart, ESP.restart() or an
+ *              OTA update.
+ *              - The first 128 bytes of the RTC user memory are used by the
+ *                OTA boot loader, the snapshot starts behind this area.
+ *              - A snapshot written directly before a controlled restart
+ *                contains the current time, NTP is not required after the
+ *                restart.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#include "settings.hpp"
+#include "measbuffer.hpp"
+#include "meas.h"
+
+
+class RtcSnapshot
+{
+private:
+    static const uint32_t SNAPSHOT_MAGIC = 0x52544332; // "RTC2", fixed point values
+
+    typedef struct
+    {
+        uint32_t magic;             // snapshot identification
+        uint32_t crc;               // CRC32 of the snapshot (crc = 0)
+        uint32_t controlled;        // 1: written before a controlled restart
+        time_t utc_time;            // UTC time of the snapshot
+        time_t start_timestamp;     // logger start time
+        uint32_t next_meas;         // time [ms] to the next measurement
+        uint32_t next_store;        // time [ms] to the next store
+        averageState_t average;     // average state of the measurement
+        uint32_t count;             // amount of values
+        measValue_t values[RTCSNAPSHOT_VALUES]; // newest values, oldest first
+    } snapshot_t;
+
+    // the first 32 blocks (128 bytes) of the 512 bytes RTC user memory are used by the boot loader
+    static_assert(sizeof(snapshot_t) <= 512 - RTCSNAPSHOT_OFFSET * 4, "snapshot is too large for the RTC user memory");
+
+    /* data */
+    snapshot_t m_snapshot;
+    bool m_warm_start;              // snapshot was restored and the time is valid
+    uint32_t m_restore_time;        // time [us] used to restore the snapshot
+
+    uint32_t snapshotCrc(void);
+
+public:
+    RtcSnapshot();
+    ~RtcSnapshot();
+
+    /**
+     * @brief Writes the snapshot to the RTC memory
+     *
+     * @param controlled true if the snapshot is written directly before a restart
+     */
+    void save(bool controlled);
+
+    /**
+     * @brief Restores values, average state and timers after a soft reset
+     *
+     * @param utc_time current UTC time, set if the result is true
+     * @return true snapshot of a controlled restart was restored, the time is valid
+     * @return false no snapshot or no valid time
+     */
+    bool restore(time_t &utc_time);
+
+    /// true if the last start used the time of the snapshot
+    bool isWarmStart(void);
+
+    /// time [us] used to restore the snapshot
+    uint32_t getRestoreTime(void);
+};
+
+
+// RTC memory snapshot
+extern RtcSnapshot g_rtc_snapshot;
@@ -0,0 +1,136 @@
+/*
+ * File         src/sampler.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Timer driven sampling of the temperature sensors.
+ */
+
+#include "sampler.h"
+#include "rtcsnapshot.h"
+
+
+Sampler::Sampler()
+    : m_interval{0}
+    , m_last_tick{0}
+    , m_max_jitter{0}
+    , m_jitter_sum{0}
+    , m_jitter_count{0}
+    , m_samples{0}
+{
+}
+
+Sampler::~Sampler() {}
+
+void Sampler::begin(uint32_t interval)
+{
+    setInterval(interval);
+    onTick(this);
+}
+
+void Sampler::setInterval(uint32_t interval)
+{
+    if (interval == m_interval)
+    {
+        return;
+    }
+    // the jitter statistics are kept, the first interval after the change
+    // is not measured, the tick of the old interval is not its start
+    m_tick.detach();
+    m_interval = interval;
+    m_last_tick = 0;
+    m_tick.attach_ms(interval, &Sampler::onTick, this);
+}
+
+bool Sampler::pop(sample_t &sample)
+{
+    return m_queue.pop(sample);
+}
+
+uint32_t Sampler::process(void)
+{
+    uint32_t count = 0;
+    sample_t sample;
+    while (m_queue.pop(sample))
+    {
+        g_temp_meas.processSample(sample);
+        count++;
+    }
+    if (count)
+    {
+        // the governor adapts the sampling interval
+        setInterval(g_temp_meas.getMeasInterval());
+        g_rtc_snapshot.save(false);
+    }
+    return count;
+}
+
+uint32_t Sampler::getInterval(void)
+{
+    return m_interval;
+}
+
+uint32_t Sampler::getMaxJitter(void)
+{
+    return m_max_jitter;
+}
+
+uint32_t Sampler::getMeanJitter(void)
+{
+    return m_jitter_count ? (uint32_t)(m_jitter_sum / m_jitter_count) : 0;
+}
+
+uint32_t Sampler::getSamples(void)
+{
+    return m_samples;
+}
+
+uint32_t Sampler::getDroppedSamples(void)
+{
+    return m_queue.dropped();
+}
+
+size_t Sampler::getQueueSize(void)
+{
+    return m_queue.size();
+}
+
+/*****************************************************************************
+ * private methods
+ *****************************************************************************/
+
+void Sampler::onTick(Sampler *sampler)
+{
+    uint32_t now = micros();
+    if (sampler->m_last_tick)
+    {
+        // deviation of the tick interval from the sampling interval
+        int32_t deviation = (int32_t)(now - sampler->m_last_tick) - (int32_t)(sampler->m_interval * 1000);
+        uint32_t jitter = deviation < 0 ? -deviation : deviation;
+        sampler->m_max_jitter = jitter > sampler->m_max_jitter ? jitter : sampler->m_max_jitter;
+        sampler->m_jitter_sum += jitter;
+        sampler->m_jitter_count++;
+    }
+    sampler->m_last_tick = now ? now : 1;
+
+    g_temp_meas.meas();
+    sampler->m_read.once_ms(g_temp_meas.getConversionWait(), &Sampler::onRead, sampler);
+}
+
+void Sampler::onRead(Sampler *sampler)
+{
+    sample_t sample;
+    if (g_temp_meas.readSample(sample))
+    {
+        sampler->m_queue.push(sample);
+        sampler->m_samples++;
+    }
+    else if (g_temp_meas.isBusy())
+    {
+        // the conversion is not finished, check again
+        sampler->m_read.once_ms(SAMPLER_POLL_INTERVAL, &Sampler::onRead, sampler);
+    }
+}
+
+
+// timer driven sampling of the sensors
+Sampler g_sampler;
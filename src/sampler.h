@@ -0,0 +1,102 @@
+/*
+ * File         src/sampler.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Timer driven sampling of the temperature sensors.
+ *              A Ticker starts the conversion of all sensors with the
+ *              interval of the governor, a second one shot Ticker reads the
+ *              sensors after the conversion time. The samples are handed to
+ *              loop() by a lock free single producer / single consumer
+ *              queue, loop() adds them to the averages.
+ *              The Ticker callbacks run in the system context between the
+ *              loop() runs and during each delay()/yield(), the sampling
+ *              continues while loop() is blocked by a WiFi reconnect or by
+ *              a long web page. The interval jitter of the ticks is measured.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <Ticker.h>
+
+#include "settings.hpp"
+#include "meas.h"
+#include "spscqueue.hpp"
+
+
+class Sampler
+{
+private:
+    /* data */
+    Ticker m_tick;                  // starts the conversions
+    Ticker m_read;                  // reads the sensors after the conversion
+    SpscQueue<sample_t, SAMPLER_QUEUE_SIZE> m_queue;
+    uint32_t m_interval;            // sampling interval [ms]
+    uint32_t m_last_tick;           // micros() of the last tick, 0: no tick since the interval change
+    uint32_t m_max_jitter;          // max. deviation of a tick interval [us]
+    uint64_t m_jitter_sum;          // sum of the deviations [us], 64 bit: no overflow
+    uint32_t m_jitter_count;        // amount of measured tick intervals
+    uint32_t m_samples;             // amount of queued samples
+
+    static void onTick(Sampler *sampler);
+    static void onRead(Sampler *sampler);
+
+public:
+    Sampler();
+    ~Sampler();
+
+    /**
+     * @brief Starts the sampling, the first conversion is started at once
+     *
+     * @param interval sampling interval [ms]
+     */
+    void begin(uint32_t interval);
+
+    /**
+     * @brief Changes the sampling interval, the next tick follows after the
+     * new interval; the jitter statistics are kept; has to be called in loop()
+     *
+     * @param interval sampling interval [ms]
+     */
+    void setInterval(uint32_t interval);
+
+    /**
+     * @brief Reads the next sample, has to be called in loop() only
+     *
+     * @param sample buffer for the sample
+     * @return true a sample was read
+     * @return false no sample available
+     */
+    bool pop(sample_t &sample);
+
+    /**
+     * @brief Adds the queued samples to the averages of g_temp_meas, sets
+     * the sampling interval of the governor and updates the RTC snapshot;
+     * has to be called in loop()
+     *
+     * @return uint32_t amount of processed samples
+     */
+    uint32_t process(void);
+
+    /// sampling interval [ms]
+    uint32_t getInterval(void);
+
+    /// max. deviation of a tick from the sampling interval since start [us]
+    uint32_t getMaxJitter(void);
+
+    /// mean deviation of a tick from the sampling interval since start [us]
+    uint32_t getMeanJitter(void);
+
+    /// amount of queued samples since start
+    uint32_t getSamples(void);
+
+    /// amount of samples lost because loop() did not read the queue
+    uint32_t getDroppedSamples(void);
+
+    /// amount of samples in the queue
+    size_t getQueueSize(void);
+};
+
+
+// timer driven sampling of the sensors
+extern Sampler g_sampler;
@@ -0,0 +1,90 @@
+/*
+ * File         src/sensorsource.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Source of the temperature values of the Measurement.
+ */
+
+#include "sensorsource.h"
+
+
+uint8_t SensorSource::crc8(const uint8_t *data, uint8_t len)
+{
+    // polynomial x^8 + x^5 + x^4 + 1, LSB first
+    uint8_t crc = 0;
+    while (len--)
+    {
+        uint8_t byte = *data++;
+        for (uint8_t i = 0; i < 8; i++)
+        {
+            uint8_t mix = (crc ^ byte) & 0x01;
+            crc >>= 1;
+            if (mix)
+            {
+                crc ^= 0x8C;
+            }
+            byte >>= 1;
+        }
+    }
+    return crc;
+}
+
+void SensorSource::powerOnSimSensor(simSensor_t &sensor)
+{
+    sensor.th = 0x4B;
+    sensor.tl = 0x46;
+    sensor.config = 0x7F;
+    sensor.raw = 85 * 16;
+    sensor.present = true;
+}
+
+void SensorSource::makeScratchPad(int16_t raw, uint8_t th, uint8_t tl, uint8_t config, uint8_t *scratchpad)
+{
+    scratchpad[0] = (uint8_t)(raw & 0xFF);
+    scratchpad[1] = (uint8_t)((uint16_t)raw >> 8);
+    scratchpad[2] = th;
+    scratchpad[3] = tl;
+    scratchpad[4] = config;
+    scratchpad[5] = 0xFF;   // reserved
+    scratchpad[6] = 0x0C;   // reserved
+    scratchpad[7] = 0x10;   // reserved
+    scratchpad[8] = crc8(scratchpad, 8);
+}
+
+void SensorSource::makeSerialCode(const char *signature, uint8_t sensor, uint8_t *code)
+{
+    code[0] = 0x28; // DS18B20 family code
+    code[1] = signature[0];
+    code[2] = signature[1];
+    code[3] = signature[2];
+    code[4] = sensor;
+    code[5] = 0;
+    code[6] = 0;
+    code[7] = crc8(code, 7);
+}
+
+int SensorSource::findSerialCode(const char *signature, const uint8_t *code)
+{
+    if (code[0] != 0x28 || code[1] != (uint8_t)signature[0] || code[2] != (uint8_t)signature[1]
+        || code[3] != (uint8_t)signature[2])
+    {
+        return -1;
+    }
+    return code[4];
+}
+
+uint8_t SensorSource::searchSimAlarms(const char *signature, const simSensor_t *sensors, uint8_t count,
+                                     SerialCode_t *codes, uint8_t max_count)
+{
+    uint8_t found = 0;
+    for (uint8_t i = 0; i < count && found < max_count; i++)
+    {
+        // only the bits 11..4 (integer part) of the temperature are compared
+        int8_t value = (int8_t)(sensors[i].raw >> 4);
+        if (sensors[i].present && (value <= (int8_t)sensors[i].tl || value >= (int8_t)sensors[i].th))
+        {
+            makeSerialCode(signature, i, codes[found++]);
+        }
+    }
+    return found;
+}
@@ -0,0 +1,170 @@
+/*
+ * File         src/sensorsource.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Source of the temperature values of the Measurement.
+ *              The interface works on the level of the DS18B20 scratchpad:
+ *              a source enumerates its sensors, starts a conversion of all
+ *              sensors and delivers the 9 scratchpad bytes of a sensor.
+ *              The alarm search finds the sensors whose last conversion was
+ *              outside of their TH/TL registers without reading them.
+ *              CRC check, retries, error values and averaging are done by the
+ *              Measurement for all sources in the same way.
+ *              Backends:
+ *              - DS18B20Source, the sensors of the 1-wire bus
+ *              - SyntheticSource, generated values with noise, drift and dropouts
+ *              - TraceSource, replay of a recorded CSV or binary trace
+ *              The simulated backends do not use OneWire/DallasTemperature.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+
+typedef uint8_t SerialCode_t[8];
+
+
+class SensorSource
+{
+public:
+    virtual ~SensorSource() {}
+
+    /**
+     * @brief Enumerates the sensors of the source, is called once by
+     * Measurement::begin() in setup()
+     *
+     * @param codes buffer for the ROM codes of the sensors
+     * @param max_count size of the buffer
+     * @return uint8_t amount of found sensors
+     */
+    virtual uint8_t begin(SerialCode_t *codes, uint8_t max_count) = 0;
+
+    /// starts the conversion of all sensors, the call returns immediately
+    virtual void startConversion(void) = 0;
+
+    /**
+     * @brief Prepares the values of the next conversion, is called in loop();
+     * startConversion() runs in the timer context and must not access files
+     * or allocate heap memory
+     */
+    virtual void readAhead(void) {}
+
+    /// true if the started conversion is finished
+    virtual bool isConversionComplete(void) = 0;
+
+    /// true if a sensor uses the parasite power, the conversion end cannot be polled
+    virtual bool isParasitePowerMode(void)
+    {
+        return false;
+    }
+
+    /// max. conversion time of a resolution [ms]
+    virtual uint32_t getConversionWait(uint8_t resolution) = 0;
+
+    /**
+     * @brief Reads the scratchpad of a sensor
+     *
+     * @param code ROM code of the sensor
+     * @param scratchpad buffer for the 9 scratchpad bytes, byte 8 is the CRC
+     * @return true sensor answered
+     * @return false no presence pulse
+     */
+    virtual bool readScratchPad(const uint8_t *code, uint8_t *scratchpad) = 0;
+
+    /**
+     * @brief Writes TH, TL and the configuration register of a sensor, the
+     * sensor EEPROM is not written
+     *
+     * @param code ROM code of the sensor
+     * @param th TH register (alarm high)
+     * @param tl TL register (alarm low)
+     * @param config configuration register (resolution)
+     */
+    virtual void writeScratchPad(const uint8_t *code, uint8_t th, uint8_t tl, uint8_t config) = 0;
+
+    /**
+     * @brief Alarm search (ROM command 0xEC), only the sensors with the alarm
+     * flag of the last conversion answer: integer part of the temperature
+     * <= TL or >= TH
+     *
+     * @param codes buffer for the ROM codes of the sensors with an alarm
+     * @param max_count size of the buffer
+     * @return uint8_t amount of sensors with an alarm
+     */
+    virtual uint8_t alarmSearch(SerialCode_t *codes, uint8_t max_count) = 0;
+
+    /// name of the source for the info page
+    virtual const char *getName(void) = 0;
+
+    /**
+     * @brief Dallas/Maxim CRC8 of the 1-wire bus (ROM code and scratchpad)
+     *
+     * @param data data bytes
+     * @param len amount of bytes
+     * @return uint8_t CRC8
+     */
+    static uint8_t crc8(const uint8_t *data, uint8_t len);
+
+protected:
+    // registers of a simulated sensor
+    typedef struct
+    {
+        uint8_t th;             // TH register
+        uint8_t tl;             // TL register
+        uint8_t config;         // configuration register
+        int16_t raw;            // temperature of the last conversion [1/16 °C]
+        bool present;           // sensor answers the next read
+    } simSensor_t;
+
+    /**
+     * @brief Sets the power on values of the DS18B20: 85 °C, TH 75 °C,
+     * TL 70 °C, 12 bit
+     *
+     * @param sensor registers of a simulated sensor
+     */
+    static void powerOnSimSensor(simSensor_t &sensor);
+
+    /**
+     * @brief Builds the scratchpad of a simulated sensor
+     *
+     * @param raw temperature [1/16 °C]
+     * @param th TH register
+     * @param tl TL register
+     * @param config configuration register
+     * @param scratchpad buffer for the 9 scratchpad bytes
+     */
+    static void makeScratchPad(int16_t raw, uint8_t th, uint8_t tl, uint8_t config, uint8_t *scratchpad);
+
+    /**
+     * @brief Builds the ROM code of a simulated sensor, family code 0x28
+     *
+     * @param signature 3 characters that identify the backend
+     * @param sensor sensor number
+     * @param code buffer for the ROM code
+     */
+    static void makeSerialCode(const char *signature, uint8_t sensor, uint8_t *code);
+
+    /**
+     * @brief Returns the sensor number of a simulated ROM code
+     *
+     * @param signature 3 characters that identify the backend
+     * @param code ROM code
+     * @return int sensor number, -1 for a foreign ROM code
+     */
+    static int findSerialCode(const char *signature, const uint8_t *code);
+
+    /**
+     * @brief Alarm search of simulated sensors, compares the temperature
+     * like the DS18B20 with the TH/TL registers
+     *
+     * @param signature 3 characters that identify the backend
+     * @param sensors registers of the simulated sensors
+     * @param count amount of simulated sensors
+     * @param codes buffer for the ROM codes of the sensors with an alarm
+     * @param max_count size of the buffer
+     * @return uint8_t amount of sensors with an alarm
+     */
+    static uint8_t searchSimAlarms(const char *signature, const simSensor_t *sensors, uint8_t count,
+                                   SerialCode_t *codes, uint8_t max_count);
+};
@@ -38,6 +38,46 @@ constexpr uint8_t LED_PIN_WEBPAGES = D0;
 /// GPIO to access the 1-wire devices
 constexpr uint8_t ONE_WIRE_PIN = D3;
 
+/// Max. amount of DS18B20 sensors on the 1-wire bus
+constexpr uint8_t MEAS_MAX_SENSORS = 12;
+/// Amount of repeated scratchpad reads of a sensor after a CRC error
+constexpr uint8_t MEAS_READ_RETRIES = 2;
+/// A sensor is suspected stuck if its raw value does not change for this amount of samples,
+/// 3 hours at the normal sampling interval; a 12 bit value has some LSB noise
+constexpr uint16_t MEAS_STUCK_SAMPLES = 720;
+/// Amount of bins of the conversion time histogram, the last bin collects the longer conversions
+constexpr uint8_t MEAS_LATENCY_BINS = 12;
+/// Width of a bin of the conversion time histogram [ms]
+constexpr uint32_t MEAS_LATENCY_BIN_WIDTH = 100;
+/// A 85 °C sample is the power on value of the DS18B20 if it differs more from the last sample [°C]
+constexpr float MEAS_POWER_ON_JUMP = 5.0;
+
+/// Sample filter between the scan and the store window, the stages are composed by SampleFilter_t in meas.h
+/// Median/Hampel filter: window [samples], an odd window delays a step by half the window
+constexpr size_t FILTER_MEDIAN_WINDOW = 5;
+/// Hampel filter: threshold in 1/10 of the scaled median absolute deviation (k = 3.0)
+constexpr uint16_t FILTER_HAMPEL_K = 30;
+/// Hampel filter: min. threshold [1/100 °C], the MAD of a stable quantized value is 0
+constexpr uint16_t FILTER_HAMPEL_MIN = 25;
+/// EMA filter: smoothing factor alpha [1/1000]
+constexpr uint16_t FILTER_EMA_ALPHA = 300;
+/// Decimation: amount of samples per value, 64 samples of a 9 bit sensor (0.5 °C) give a 12 bit value
+/// if the noise spans at least one LSB
+constexpr uint16_t FILTER_DECIMATE = 64;
+
+/// Source of the temperature values, default are the DS18B20 on the 1-wire bus;
+/// uncomment one of the following lines to run the logger without hardware
+//#define MEAS_SOURCE_SYNTHETIC
+//#define MEAS_SOURCE_TRACE
+/// Synthetic source: amount of sensors, start temperature [°C], noise [°C], drift [°C/h], dropouts [1/1000]
+constexpr uint8_t MEAS_SYNTHETIC_SENSORS = 2;
+constexpr float MEAS_SYNTHETIC_BASE = 20.0;
+constexpr float MEAS_SYNTHETIC_NOISE = 0.1;
+constexpr float MEAS_SYNTHETIC_DRIFT = 0.5;
+constexpr uint16_t MEAS_SYNTHETIC_DROPOUT = 10;
+/// Trace source: recorded trace on LittleFS, CSV or binary, see tracesource.h
+#define MEAS_TRACE_FILE "/trace.csv"
+
 /// Start memory address of EEPROM usage
 constexpr int8 eeprom_startAddress = 0;
 
@@ -47,8 +87,20 @@ constexpr int8 eeprom_startAddress = 0;
 
 /// Web Server Port number
 constexpr uint16_t WEB_SERVER_PORT = 80;
-/// Amount of bytes per block for transmitting -> reduce required RAM size
+/// Amount of bytes per block for transmitting -> reduce required RAM size, a block is sent as one HTTP chunk
 constexpr uint32_t HTTP_BLOCK_SIZE = 1024;
+/// Reserve of a row in a block, a page step ends if less space is left in the block
+constexpr uint32_t HTTP_ROW_SIZE = 128;
+/// Amount of parallel connections, each one has a block buffer
+constexpr size_t WEB_MAX_CONNECTIONS = 3;
+/// Max. size of the request line "GET <path>?<parameter> HTTP/1.1", a longer line is cut
+constexpr size_t WEB_REQUEST_SIZE = 128;
+/// A connection is closed if the request line is not received within this time [ms]
+constexpr uint32_t WEB_REQUEST_TIMEOUT = 2000;
+/// A connection is closed if the client does not take data within this time [ms]
+constexpr uint32_t WEB_SEND_TIMEOUT = 5000;
+/// Max. time of the web server per loop() pass for all connections [us]
+constexpr uint32_t WEB_LOOP_BUDGET = 20000;
 
 /*
  * Sensor
@@ -67,10 +119,97 @@ constexpr size_t SERIAL_CODE_SIZE = (64 /*bit*/ / 4 /*nibble size*/) + 1 /*Termi
 #define TIME_DOMAIN_IN_DAYS        14 // days
 #define TIME_MEASUREMENT_DISTANCE  15 // seconds
 
-/// Amount of measurment elements that have to be stored in the queue
+/// Sampler: queue size between the timer context and loop(), power of two; covers a blocked loop() of 75 sec at 5 sec sampling
+constexpr size_t SAMPLER_QUEUE_SIZE = 16;
+/// Sampler: check interval of a conversion that was not finished after the conversion time [ms]
+constexpr uint32_t SAMPLER_POLL_INTERVAL = 10;
+
+/// Governor: rate of change [°C/min] that switches to the fast sampling
+constexpr float GOVERNOR_FAST_RATE = 0.5;
+/// Governor: the temperature is stable while all samples stay in this band [°C] around a reference
+constexpr float GOVERNOR_STABLE_BAND = 0.2;
+/// Governor: amount of stable samples in sequence to use the next slower sampling
+constexpr uint8_t GOVERNOR_STABLE_SAMPLES = 8;
+
+/// Alarm watch mode: interval of the conversions with an alarm search [ms], the sensors are read at the store interval
+constexpr uint32_t ALARM_WATCH_INTERVAL = TIME_MEASUREMENT_DISTANCE * 1000 / 3;
+
+/// Amount of measurment elements of the 14 days queue, sizes the RAM of the compressed queue (MEASBUFFER_COMPRESSED)
 constexpr size_t RINGBUFFER_SIZE = TIME_MEASUREMENTS_PER_HOUR  * TIME_HOURS_PER_DAY  * TIME_DOMAIN_IN_DAYS ;
+/// Upper limit of the measurement queue, the queue is sized at start by the free heap
+constexpr size_t RINGBUFFER_MAX_SIZE = TIME_MEASUREMENTS_PER_HOUR  * TIME_HOURS_PER_DAY  * 21 /*days*/;
+/// Lower limit of the measurement queue, used if the heap is too small
+constexpr size_t RINGBUFFER_MIN_SIZE = TIME_MEASUREMENTS_PER_HOUR  * TIME_HOURS_PER_DAY  * 1 /*day*/;
+/// Heap of a web connection while a page is sent: lwIP send buffer (2 TCP segments of 1460 byte) and client context [bytes]
+constexpr size_t WEB_CONNECTION_HEAP = 2 * 1460 + 256;
+/// Heap of WiFi reconnect, DHCP, mDNS, NTP and two open LittleFS files (flash log, archive) [bytes]
+constexpr size_t SYSTEM_HEAP_RESERVE = 6 * 1024;
+/// Heap that is kept free when the queue is sized [bytes]; the rollup tiers (about 32 kB) and the connection
+/// buffers of the web server are static, they are not part of the free heap block at start
+constexpr size_t MEASBUFFER_HEAP_RESERVE = WEB_MAX_CONNECTIONS * WEB_CONNECTION_HEAP + SYSTEM_HEAP_RESERVE;
 /// time domain that defines the time distance in sec to store the next measurement value to queue
 constexpr uint32_t MEASURMENT_DOMAIN = 60 * 60 / TIME_MEASUREMENTS_PER_HOUR;
+/// Deadband mode: default of the max. time between two stored values [min]
+constexpr int STORE_HEARTBEAT_DEFAULT = 60;
+
+/*
+ * Rollup tiers, min/avg/max values for the long term history
+ */
+#define ROLLUP_HOURLY_DAYS         90 // days
+#define ROLLUP_DAILY_YEARS         3  // years
+
+/// Amount of hourly rollup elements
+constexpr size_t ROLLUP_HOURLY_SIZE = TIME_HOURS_PER_DAY * ROLLUP_HOURLY_DAYS;
+/// Amount of daily rollup elements
+constexpr size_t ROLLUP_DAILY_SIZE = 366 * ROLLUP_DAILY_YEARS;
+/// File of the saved rollup tiers, written once per day and before a restart
+#define ROLLUP_FILE "/rollup.bin"
+/// Temporary file of a rollup save, renamed after the complete write
+#define ROLLUP_TEMP_FILE "/rollup.tmp"
+
+/*
+ * Flash log of the measurement values, restores the measurement buffer at start
+ */
+
+/// Directory of the flash log files
+#define FLASHLOG_DIRECTORY "/wal"
+/// Amount of values that are written together, one page of 556 byte (16 byte header, 18 byte values) per 3 hours
+constexpr size_t FLASHLOG_PAGE_VALUES = 30;
+/// Amount of pages per segment file
+constexpr size_t FLASHLOG_SEGMENT_PAGES = 16;
+/// Amount of segment files, covers the largest measurement buffer plus one segment
+constexpr size_t FLASHLOG_SEGMENTS = RINGBUFFER_MAX_SIZE / (FLASHLOG_PAGE_VALUES * FLASHLOG_SEGMENT_PAGES) + 2;
+
+/*
+ * Archive of the finished days on LittleFS, about 1.5 kB per day
+ */
+
+/// Directory of the archive files
+#define ARCHIVE_DIRECTORY "/arc"
+/// Months that are kept in the archive, the current month included
+constexpr int ARCHIVE_RETENTION_MONTHS = 13;
+/// The oldest archive files are deleted if the free file system space is smaller [bytes]
+constexpr size_t ARCHIVE_MIN_FREE_SPACE = 64 * 1024;
+/// Amount of values that are read/written with one file access
+constexpr size_t ARCHIVE_CHUNK_VALUES = 32;
+
+/*
+ * Snapshot of the newest values in the RTC user memory for warm restarts
+ */
+
+/// First RTC user memory block of the snapshot, blocks 0..31 are used by the OTA boot loader
+constexpr uint32_t RTCSNAPSHOT_OFFSET = 32;
+/// Amount of newest measurement values in the snapshot
+constexpr size_t RTCSNAPSHOT_VALUES = 16;
+/// Estimated time [ms] between the snapshot and the start of the new firmware run (reset + boot)
+constexpr uint32_t RTCSNAPSHOT_RESTART_TIME = 300;
+
+/// uncomment the following line to store the measurement values compressed,
+/// the same RAM size holds the values of months instead of days; the quality
+/// fields (min/max/standard deviation/sample counts) are not kept compressed
+//#define MEASBUFFER_COMPRESSED
+/// Amount of bytes per compressed block
+constexpr size_t COMPRESSED_BLOCK_SIZE = 256;
 
 /*
  * Parameter definitions
@@ -79,4 +218,4 @@ constexpr uint32_t MEASURMENT_DOMAIN = 60 * 60 / TIME_MEASUREMENTS_PER_HOUR;
 /// size of string size in parameter list incluing termination
 constexpr int STRING_SIZE = 32;
 /// if the parameter list is changed this values should be changed
-constexpr int PARAMETER_LIST_VERSION = 1;
+constexpr int PARAMETER_LIST_VERSION = 4;
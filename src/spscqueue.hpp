@@ -0,0 +1,106 @@
+/*
+ * File         src/spscqueue.hpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Lock free single producer / single consumer queue.
+ *              The producer (e.g. a timer callback) calls push(), the
+ *              consumer (loop()) calls pop(). Each index is written by one
+ *              side only, the element is written before the index is
+ *              published (release) and read after the index is seen
+ *              (acquire); no interrupt lock is required.
+ *              One element is kept free to separate full and empty, the
+ *              queue holds _NSIZE - 1 elements. _NSIZE has to be a power
+ *              of two, the indexes are wrapped by a mask.
+ *
+ *    Usage:    SpscQueue<sample_t, 16> queue;
+ *              queue.push(sample);     // producer
+ *              while (queue.pop(sample))   // consumer
+ *                  process(sample);
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#include <atomic>
+
+
+template <typename _T, size_t _NSIZE>
+class SpscQueue
+{
+    static_assert(_NSIZE >= 2 && (_NSIZE & (_NSIZE - 1)) == 0, "queue size has to be a power of two");
+    static const size_t MASK = _NSIZE - 1;
+
+private:
+    _T m_buffer[_NSIZE];
+    std::atomic<size_t> m_head;     // next write position, written by the producer
+    std::atomic<size_t> m_tail;     // next read position, written by the consumer
+    std::atomic<uint32_t> m_dropped; // amount of rejected elements of a full queue, written by the producer
+
+public:
+    SpscQueue()
+        : m_head{0}
+        , m_tail{0}
+        , m_dropped{0}
+    {
+    }
+
+    /**
+     * @brief Adds an element, has to be called by the producer only
+     *
+     * @param value new element
+     * @return true element was added
+     * @return false queue is full, the element is dropped
+     */
+    bool push(const _T &value)
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t next = (head + 1) & MASK;
+        if (next == m_tail.load(std::memory_order_acquire))
+        {
+            // written by the producer only, no read-modify-write instruction is required
+            m_dropped.store(m_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        m_buffer[head] = value;
+        m_head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element, has to be called by the consumer only
+     *
+     * @param value buffer for the element
+     * @return true an element was read
+     * @return false queue is empty
+     */
+    bool pop(_T &value)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        value = m_buffer[tail];
+        m_tail.store((tail + 1) & MASK, std::memory_order_release);
+        return true;
+    }
+
+    /// amount of queued elements, a snapshot for information only
+    size_t size(void)
+    {
+        return (m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire)) & MASK;
+    }
+
+    /// max. amount of queued elements
+    size_t content(void)
+    {
+        return _NSIZE - 1;
+    }
+
+    /// amount of elements dropped because the queue was full
+    uint32_t dropped(void)
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+};
@@ -0,0 +1,118 @@
+/*
+ * File         src/syntheticsource.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Sensor source with generated temperature values.
+ */
+
+#include "syntheticsource.h"
+
+
+// ROM code signature of the synthetic sensors
+static const char SYNTHETIC_SIGNATURE[] = "SYN";
+
+
+SyntheticSource::SyntheticSource(uint8_t sensors, float base, float noise, float drift, uint16_t dropout, uint32_t seed)
+    : m_sensors{sensors < MEAS_MAX_SENSORS ? sensors : MEAS_MAX_SENSORS}
+    , m_base{base}
+    , m_noise{noise}
+    , m_drift{drift}
+    , m_dropout{dropout}
+    , m_random{seed ? seed : 1}
+    , m_conversions{0}
+{
+    for (uint8_t i = 0; i < MEAS_MAX_SENSORS; i++)
+    {
+        powerOnSimSensor(m_sensor[i]);
+    }
+}
+
+SyntheticSource::~SyntheticSource() {}
+
+uint8_t SyntheticSource::begin(SerialCode_t *codes, uint8_t max_count)
+{
+    uint8_t count = m_sensors < max_count ? m_sensors : max_count;
+    for (uint8_t i = 0; i < count; i++)
+    {
+        makeSerialCode(SYNTHETIC_SIGNATURE, i, codes[i]);
+    }
+    return count;
+}
+
+void SyntheticSource::startConversion(void)
+{
+    // base + drift + uniform noise in [-noise, noise]
+    float hours = millis() / (60.0 * 60.0 * 1000.0);
+    for (uint8_t i = 0; i < m_sensors; i++)
+    {
+        float noise = m_noise * ((nextRandom() % 2001) / 1000.0 - 1.0);
+        float value = m_base + i * 0.5 + m_drift * hours + noise;
+        m_sensor[i].raw = (int16_t)lroundf(value * 16);
+        // a dropout is decided per conversion, the retries of the read fail too
+        m_sensor[i].present = nextRandom() % 1000 >= m_dropout;
+    }
+    m_conversions++;
+}
+
+bool SyntheticSource::isConversionComplete(void)
+{
+    return true;
+}
+
+uint32_t SyntheticSource::getConversionWait(uint8_t resolution)
+{
+    // same times as the DS18B20, used for the timeout only
+    return 750 / (1 << (12 - resolution));
+}
+
+bool SyntheticSource::readScratchPad(const uint8_t *code, uint8_t *scratchpad)
+{
+    int sensor = findSerialCode(SYNTHETIC_SIGNATURE, code);
+    if (sensor < 0 || sensor >= m_sensors || !m_sensor[sensor].present)
+    {
+        // no presence pulse
+        return false;
+    }
+    const simSensor_t &reg = m_sensor[sensor];
+    makeScratchPad(reg.raw, reg.th, reg.tl, reg.config, scratchpad);
+    return true;
+}
+
+void SyntheticSource::writeScratchPad(const uint8_t *code, uint8_t th, uint8_t tl, uint8_t config)
+{
+    int sensor = findSerialCode(SYNTHETIC_SIGNATURE, code);
+    if (sensor >= 0 && sensor < m_sensors)
+    {
+        m_sensor[sensor].th = th;
+        m_sensor[sensor].tl = tl;
+        m_sensor[sensor].config = config;
+    }
+}
+
+uint8_t SyntheticSource::alarmSearch(SerialCode_t *codes, uint8_t max_count)
+{
+    return searchSimAlarms(SYNTHETIC_SIGNATURE, m_sensor, m_sensors, codes, max_count);
+}
+
+const char *SyntheticSource::getName(void)
+{
+    return "synthetic";
+}
+
+uint32_t SyntheticSource::getConversions(void)
+{
+    return m_conversions;
+}
+
+/*****************************************************************************
+ * private methods
+ *****************************************************************************/
+
+uint32_t SyntheticSource::nextRandom(void)
+{
+    // xorshift32
+    m_random ^= m_random << 13;
+    m_random ^= m_random >> 17;
+    m_random ^= m_random << 5;
+    return m_random;
+}
@@ -0,0 +1,62 @@
+/*
+ * File         src/syntheticsource.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Sensor source with generated temperature values for tests
+ *              without hardware. Each sensor delivers a base value plus a
+ *              linear drift over the time and a uniform noise, some reads
+ *              fail like a sensor with a bad contact (dropouts).
+ *              The random numbers are generated by a seeded xorshift
+ *              generator, a run is reproducible.
+ *              A conversion is finished immediately.
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#include "sensorsource.h"
+#include "settings.hpp"
+
+
+class SyntheticSource : public SensorSource
+{
+private:
+    /* data */
+    simSensor_t m_sensor[MEAS_MAX_SENSORS];
+    uint8_t m_sensors;          // amount of simulated sensors
+    float m_base;               // temperature of sensor 0 at start [°C]
+    float m_noise;              // max. noise amplitude [°C]
+    float m_drift;              // drift [°C/h]
+    uint16_t m_dropout;         // probability of a failed read [1/1000]
+    uint32_t m_random;          // state of the random generator
+    uint32_t m_conversions;     // amount of started conversions
+
+    uint32_t nextRandom(void);
+
+public:
+    /**
+     * @brief Construct a new Synthetic Source object
+     *
+     * @param sensors amount of simulated sensors, sensor n is n * 0.5 °C warmer than sensor 0
+     * @param base temperature of sensor 0 at start [°C]
+     * @param noise max. noise amplitude [°C]
+     * @param drift drift [°C/h]
+     * @param dropout probability of a failed read [1/1000]
+     * @param seed start value of the random generator, not 0
+     */
+    SyntheticSource(uint8_t sensors, float base, float noise, float drift, uint16_t dropout, uint32_t seed = 1);
+    ~SyntheticSource();
+
+    uint8_t begin(SerialCode_t *codes, uint8_t max_count) override;
+    void startConversion(void) override;
+    bool isConversionComplete(void) override;
+    uint32_t getConversionWait(uint8_t resolution) override;
+    bool readScratchPad(const uint8_t *code, uint8_t *scratchpad) override;
+    void writeScratchPad(const uint8_t *code, uint8_t th, uint8_t tl, uint8_t config) override;
+    uint8_t alarmSearch(SerialCode_t *codes, uint8_t max_count) override;
+    const char *getName(void) override;
+
+    /// amount of started conversions
+    uint32_t getConversions(void);
+};
@@ -8,6 +8,8 @@ code for time conversion based on http://stackoverflow.com/
 
 // note: all timing relates to 1970-01-01T00:00:00Z
 
+#include <TimeLib.h>
+
 #include "timehelper.h"
 
 
@@ -30,4 +32,50 @@ String convertEpochToIso8601(const time_t epoch)
 }
 
 
+/**
+ * @brief Converts a ISO8601 string or an epoch number to an epoch time value
+ * 
+ * @param iso8601 - time string like '2020-07-25', '2020-07-25T13:24' or
+ *                  '2020-07-25 13:24:52'; URL encoded ':' and ' ' are
+ *                  accepted; a plain number is used as epoch value
+ * @return time_t epoch value, 0 if the string is not valid
+ */
+time_t convertIso8601ToEpoch(const String &iso8601)
+{
+    String value = iso8601;
+    value.replace("%3A", ":");
+    value.replace("%3a", ":");
+    value.replace("%20", " ");
+    value.replace("+", " ");
+
+    if (value.indexOf('-') < 0)
+    {
+        // epoch number
+        return (time_t)strtoul(value.c_str(), nullptr, 10);
+    }
+
+    // the year is limited by the 32 bit epoch of TimeLib
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    if (sscanf(value.c_str(), "%d-%d-%d%*c%d:%d:%d", &year, &month, &day, &hour, &minute, &second) < 3
+        || year < 1970 || year > 2105 || month < 1 || month > 12 || day < 1 || day > 31
+        || hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 59)
+    {
+        return 0;
+    }
+
+    tmElements_t tm;
+    tm.Year = CalendarYrToTm(year);
+    tm.Month = month;
+    tm.Day = day;
+    tm.Hour = hour;
+    tm.Minute = minute;
+    tm.Second = second;
+    time_t epoch = makeTime(tm);
+
+    // a day behind the end of the month (e.g. 2021-02-30) is moved by makeTime()
+    breakTime(epoch, tm);
+    return tm.Day == day ? epoch : 0;
+}
+
+
 timer_values_t g_timer_values;
\ No newline at end of file
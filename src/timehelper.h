@@ -17,5 +17,7 @@ code for time conversion based on http://stackoverflow.com/
 
 String convertEpochToIso8601(const time_t epoch);
 
+time_t convertIso8601ToEpoch(const String &iso8601);
+
 
 extern timer_values_t g_timer_values;
\ No newline at end of file
@@ -0,0 +1,265 @@
+/*
+ * File         src/tracesource.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Sensor source that replays a recorded trace from LittleFS.
+ */
+
+#include <LittleFS.h>
+
+#include "tracesource.h"
+
+
+// ROM code signature of the trace sensors
+static const char TRACE_SIGNATURE[] = "TRC";
+
+
+TraceSource::TraceSource(const char *path)
+    : m_path{path}
+    , m_binary{false}
+    , m_sensors{0}
+    , m_trace_sensors{0}
+    , m_records{0}
+    , m_rewinds{0}
+    , m_repeats{0}
+    , m_next_ready{false}
+{
+    for (uint8_t i = 0; i < MEAS_MAX_SENSORS; i++)
+    {
+        powerOnSimSensor(m_sensor[i]);
+        m_next_raw[i] = 0;
+        m_next_present[i] = false;
+    }
+}
+
+TraceSource::~TraceSource() {}
+
+uint8_t TraceSource::begin(SerialCode_t *codes, uint8_t max_count)
+{
+    if (!LittleFS.begin() || !(m_file = LittleFS.open(m_path, "r")))
+    {
+        Serial.printf("ERROR: trace %s not available!\n", m_path);
+        return 0;
+    }
+
+    // a binary trace starts with its header, each other file is read as CSV
+    trace_header_t header;
+    m_binary = m_file.read((uint8_t *)&header, sizeof(header)) == sizeof(header) && header.magic == TRACE_MAGIC;
+    if (m_binary)
+    {
+        m_trace_sensors = header.sensors;
+        m_sensors = header.sensors;
+    }
+    else
+    {
+        // the amount of sensors is the amount of temperatures of the first record
+        bool valid[MEAS_MAX_SENSORS];
+        float values[MEAS_MAX_SENSORS];
+        m_file.seek(0, SeekSet);
+        while (m_file.available() && !m_sensors)
+        {
+            m_sensors = parseCsvLine(m_file.readStringUntil('\n'), valid, values);
+        }
+    }
+    m_sensors = m_sensors < max_count ? m_sensors : max_count;
+    rewind();
+    readAhead();
+
+    for (uint8_t i = 0; i < m_sensors; i++)
+    {
+        makeSerialCode(TRACE_SIGNATURE, i, codes[i]);
+    }
+    Serial.printf("trace %s: %u sensors\n", m_path, m_sensors);
+    return m_sensors;
+}
+
+void TraceSource::startConversion(void)
+{
+    if (!m_next_ready)
+    {
+        // no record was read ahead, the sensors keep the last values
+        m_repeats++;
+        return;
+    }
+    for (uint8_t i = 0; i < m_sensors; i++)
+    {
+        m_sensor[i].raw = m_next_raw[i];
+        m_sensor[i].present = m_next_present[i];
+    }
+    m_next_ready = false;
+}
+
+void TraceSource::readAhead(void)
+{
+    if (m_next_ready)
+    {
+        return;
+    }
+    if (!readRecord())
+    {
+        // an empty trace delivers dropouts only
+        for (uint8_t i = 0; i < m_sensors; i++)
+        {
+            m_next_present[i] = false;
+        }
+    }
+    // the record is complete before the timer context may use it
+    m_next_ready = true;
+}
+
+bool TraceSource::isConversionComplete(void)
+{
+    return true;
+}
+
+uint32_t TraceSource::getConversionWait(uint8_t resolution)
+{
+    // same times as the DS18B20, used for the timeout only
+    return 750 / (1 << (12 - resolution));
+}
+
+bool TraceSource::readScratchPad(const uint8_t *code, uint8_t *scratchpad)
+{
+    int sensor = findSerialCode(TRACE_SIGNATURE, code);
+    if (sensor < 0 || sensor >= m_sensors || !m_sensor[sensor].present)
+    {
+        // no presence pulse
+        return false;
+    }
+    const simSensor_t &reg = m_sensor[sensor];
+    makeScratchPad(reg.raw, reg.th, reg.tl, reg.config, scratchpad);
+    return true;
+}
+
+void TraceSource::writeScratchPad(const uint8_t *code, uint8_t th, uint8_t tl, uint8_t config)
+{
+    int sensor = findSerialCode(TRACE_SIGNATURE, code);
+    if (sensor >= 0 && sensor < m_sensors)
+    {
+        m_sensor[sensor].th = th;
+        m_sensor[sensor].tl = tl;
+        m_sensor[sensor].config = config;
+    }
+}
+
+uint8_t TraceSource::alarmSearch(SerialCode_t *codes, uint8_t max_count)
+{
+    return searchSimAlarms(TRACE_SIGNATURE, m_sensor, m_sensors, codes, max_count);
+}
+
+const char *TraceSource::getName(void)
+{
+    return "trace replay";
+}
+
+uint32_t TraceSource::getRecords(void)
+{
+    return m_records;
+}
+
+uint32_t TraceSource::getRewinds(void)
+{
+    return m_rewinds;
+}
+
+uint32_t TraceSource::getRepeats(void)
+{
+    return m_repeats;
+}
+
+/*****************************************************************************
+ * private methods
+ *****************************************************************************/
+
+bool TraceSource::readRecord(void)
+{
+    if (!m_file || !m_sensors)
+    {
+        return false;
+    }
+    // the trace is started again at its end, one restart per call
+    for (uint8_t pass = 0; pass < 2; pass++)
+    {
+        if (m_binary ? readBinaryRecord() : readCsvRecord())
+        {
+            m_records++;
+            return true;
+        }
+        rewind();
+        m_rewinds++;
+    }
+    return false;
+}
+
+bool TraceSource::readBinaryRecord(void)
+{
+    uint32_t time;
+    if (m_file.read((uint8_t *)&time, sizeof(time)) != sizeof(time))
+    {
+        return false;
+    }
+    // the values of the sensors above MEAS_MAX_SENSORS are skipped
+    for (uint8_t i = 0; i < m_trace_sensors; i++)
+    {
+        int16_t raw;
+        if (m_file.read((uint8_t *)&raw, sizeof(raw)) != sizeof(raw))
+        {
+            return false;
+        }
+        if (i < m_sensors)
+        {
+            m_next_present[i] = raw != TRACE_DROPOUT;
+            m_next_raw[i] = raw;
+        }
+    }
+    return true;
+}
+
+bool TraceSource::readCsvRecord(void)
+{
+    bool valid[MEAS_MAX_SENSORS];
+    float values[MEAS_MAX_SENSORS];
+    while (m_file.available())
+    {
+        if (!parseCsvLine(m_file.readStringUntil('\n'), valid, values))
+        {
+            // header or comment
+            continue;
+        }
+        for (uint8_t i = 0; i < m_sensors; i++)
+        {
+            m_next_present[i] = valid[i];
+            m_next_raw[i] = valid[i] ? (int16_t)lroundf(values[i] * 16) : 0;
+        }
+        return true;
+    }
+    return false;
+}
+
+uint8_t TraceSource::parseCsvLine(const String &line, bool *valid, float *values)
+{
+    // the first field is the time, the temperatures follow; missing temperatures are dropouts
+    int start = line.indexOf(',');
+    uint8_t count = 0;
+    bool numeric = false;
+    memset(valid, 0, MEAS_MAX_SENSORS * sizeof(bool));
+    while (start >= 0 && count < MEAS_MAX_SENSORS)
+    {
+        int end = line.indexOf(',', start + 1);
+        String field = line.substring(start + 1, end < 0 ? line.length() : end);
+        field.trim();
+        char *parse_end;
+        values[count] = strtof(field.c_str(), &parse_end);
+        valid[count] = !field.isEmpty() && *parse_end == 0 && !isnan(values[count]);
+        numeric |= valid[count];
+        count++;
+        start = end;
+    }
+    // a line without any numeric temperature is no record
+    return numeric ? count : 0;
+}
+
+void TraceSource::rewind(void)
+{
+    m_file.seek(m_binary ? sizeof(trace_header_t) : 0, SeekSet);
+}
@@ -0,0 +1,97 @@
+/*
+ * File         src/tracesource.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Sensor source that replays a recorded trace from LittleFS.
+ *              Each conversion delivers the next record of the trace, the
+ *              trace is started again at its end. The timestamps of the
+ *              trace are not used, the replay is as fast as the sampling.
+ *              The record is read ahead in loop(), the conversion in the
+ *              timer context takes the prepared values only.
+ *              Formats:
+ *              - binary: header "TRC1" + amount of sensors (uint8_t) + 3
+ *                reserved bytes, records of uint32_t time + int16_t raw
+ *                value [1/16 °C] per sensor, little endian;
+ *                TRACE_DROPOUT is a dropout
+ *              - CSV (each file without the binary header): one record per
+ *                line "time,temp0,temp1,...", temperatures in °C; an empty
+ *                or not numeric temperature is a dropout; lines without any
+ *                numeric temperature (header, "#" comments) are skipped
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+
+#include "sensorsource.h"
+#include "settings.hpp"
+
+
+class TraceSource : public SensorSource
+{
+public:
+    /// raw value of a dropout in a binary trace
+    static const int16_t TRACE_DROPOUT = INT16_MIN;
+
+private:
+    static const uint32_t TRACE_MAGIC = 0x31435254; // "TRC1"
+
+    // header of a binary trace
+    typedef struct __attribute__((packed))
+    {
+        uint32_t magic;         // file identification
+        uint8_t sensors;        // amount of sensors per record
+        uint8_t reserved[3];
+    } trace_header_t;
+
+    /* data */
+    const char *m_path;         // file name of the trace
+    File m_file;                // opened trace
+    bool m_binary;              // binary format, else CSV
+    simSensor_t m_sensor[MEAS_MAX_SENSORS];
+    uint8_t m_sensors;          // amount of used sensors of the trace
+    uint8_t m_trace_sensors;    // amount of sensors per record of a binary trace
+    uint32_t m_records;         // amount of replayed records
+    uint32_t m_rewinds;         // amount of replay restarts at the trace end
+    uint32_t m_repeats;         // amount of conversions without a record read ahead
+
+    /* record of the next conversion, read ahead in loop() */
+    int16_t m_next_raw[MEAS_MAX_SENSORS];   // temperature [1/16 °C]
+    bool m_next_present[MEAS_MAX_SENSORS];  // false: dropout
+    volatile bool m_next_ready;             // the record was read and not yet used
+
+    bool readRecord(void);
+    bool readBinaryRecord(void);
+    bool readCsvRecord(void);
+    uint8_t parseCsvLine(const String &line, bool *valid, float *values);
+    void rewind(void);
+
+public:
+    /**
+     * @brief Construct a new Trace Source object, the file is opened by begin()
+     *
+     * @param path file name of the trace on LittleFS
+     */
+    TraceSource(const char *path);
+    ~TraceSource();
+
+    uint8_t begin(SerialCode_t *codes, uint8_t max_count) override;
+    void startConversion(void) override;
+    void readAhead(void) override;
+    bool isConversionComplete(void) override;
+    uint32_t getConversionWait(uint8_t resolution) override;
+    bool readScratchPad(const uint8_t *code, uint8_t *scratchpad) override;
+    void writeScratchPad(const uint8_t *code, uint8_t th, uint8_t tl, uint8_t config) override;
+    uint8_t alarmSearch(SerialCode_t *codes, uint8_t max_count) override;
+    const char *getName(void) override;
+
+    /// amount of replayed records
+    uint32_t getRecords(void);
+
+    /// amount of replay restarts at the trace end
+    uint32_t getRewinds(void);
+
+    /// amount of conversions that repeated the last record, loop() did not read ahead in time
+    uint32_t getRepeats(void);
+};
@@ -10,19 +10,25 @@
 #include "parameter.hpp"
 #include "measbuffer.hpp"
 #include "timehelper.h"
+#include "flashlog.h"
+#include "rtcsnapshot.h"
+#include "archive.h"
+#include "rollupstore.h"
+#include "sampler.h"
+#include "responsewriter.h"
 
 /*******************************************************************************
  * Helper functions
  ******************************************************************************/
 
 /**
- * @brief Get the Style Definitions object
+ * @brief Writes the style definitions
  * 
- * @return String 
+ * @param out writer of the page
  */
-String getStyleDefinitions()
+void writeStyleDefinitions(ResponseWriter &out)
 {
-    String style = F(
+    out.print(F(
         "<style>"
         "h1 {background-color: rgb(75, 75, 223);color: white;height: 40px;padding-left: 10px;}"
         //        "h1 {color: Indigo; font-size:32px;}"
@@ -31,496 +37,1119 @@ String getStyleDefinitions()
         "button { height: 40px; min-width: 100px; font-size: 1.1em;}"
         ".buttons {text-align: left;}"
         ".info {text-align: left; font-size: 0.7em;}"
-        "</style>");
-    return style;
+        "</style>"));
 }
 
+void writeHtmlHeadStartSequence(ResponseWriter &out, const __FlashStringHelper *title, uint32_t refresh)
+{
+    out.print(F("<!DOCTYPE html>"
+                "<html>"
+                "<head>"
+                "<meta charset=\"utf-8\">"));
+
+    out.print(F("<title>"));
+    out.print(title);
+    out.print(F("</title>"));
+
+    writeStyleDefinitions(out);
+    if (refresh)
+    {
+        // add refresh if refresh is required (>0!)
+        out.print(F("<meta http-equiv=\"refresh\" content=\""));
+        out.print(refresh);
+        out.print(F("\" >"));
+    }
+}
+
+void writeLinkList(ResponseWriter &out)
+{
+    out.print(F("<p>"
+                "<a href=\"/\"><button>Dashboard</button></a> "
+                "<a href=\"/graph\"><button>Graph</button></a> "
+                "<a href=\"/info\"><button>Information</button></a> "
+                "<a href=\"/measval.js\"><button>JSON temperature file</button></a> "
+                "</p>"));
+}
+
+void writeInfoText(ResponseWriter &out)
+{
+    out.print(F(
+        "<p class=\"info\">"
+        "Page requests = "));
+    out.print(g_prj_web_server.getRequestedPages());
+    out.print(F(", free RAM = "));
+    out.print(system_get_free_heap_size());
+    out.print(F(", max. data points = "));
+    out.print(g_ringbuffer.content());
+    out.print(F(", scanned data points = "));
+    out.print(g_ringbuffer.size());
+    out.print(F("</p>"));
+}
+
+// Tier of the measurement history that is used for a page
+enum class HistoryTier_t
+{
+    RAW,    // single measurement values
+    HOURLY, // hourly min/avg/max values
+    DAILY   // daily min/avg/max values
+};
+
 /*
- * HTTP 1.1 header with length information
- * Has to be used before sending a web page
- * Type: 'text/html', 'application/json'
+ * Returns the requested time window of the page parameters:
+ * - "from=<time>&to=<time>", time as epoch value or as ISO8601 string, a not
+ *   valid time is no limit; from > to is an empty window
+ * - "range=<hours>", the last hours up to the newest measurement value, a
+ *   range behind 1970 starts with the oldest value
  */
-String getHTTPTypeSizeHeader(String type, uint32_t send_size)
+timeWindow_t getRequestedWindow(void)
 {
-    String header;
+    timeWindow_t window = {0, 0};
+    String from = g_prj_web_server.getParameter("from");
+    String to = g_prj_web_server.getParameter("to");
 
-    header = "HTTP/1.1 200 OK\r\nContent-Length: " + String(send_size) + "\r\nContent-Type: " + type + "\r\nConnection: close\r\n\r\n";
+    if (!from.isEmpty() || !to.isEmpty())
+    {
+        window.from = from.isEmpty() ? 0 : convertIso8601ToEpoch(from);
+        window.to = to.isEmpty() ? 0 : convertIso8601ToEpoch(to);
+    }
+    else
+    {
+        long hours = g_prj_web_server.getParameter("range").toInt();
+        if (hours > 0 && g_ringbuffer.size())
+        {
+            // no overflow of a 32 bit time_t, 1: older than all values
+            time_t last = g_ringbuffer.readLast().timestamp;
+            window.from = hours < last / (60 * 60) ? last - (time_t)hours * 60 * 60 : 1;
+        }
+    }
+    return window;
+}
 
-    return (header);
+/*
+ * Selects the history tier with the highest resolution that covers the
+ * start of the time window
+ */
+HistoryTier_t selectHistoryTier(const timeWindow_t &window)
+{
+    // all values since the start are in the measurement buffer
+    if (!window.from || !g_ringbuffer.isFull() || window.from >= g_ringbuffer.readFirst().timestamp)
+        return HistoryTier_t::RAW;
+    if (!g_rollup_hourly.size() || g_rollup_hourly.size() < g_rollup_hourly.content()
+        || window.from >= (time_t)g_rollup_hourly.readFirst().timestamp)
+        return HistoryTier_t::HOURLY;
+    return HistoryTier_t::DAILY;
 }
 
-String getHtmlHeadStartSequence(const String &title, uint32_t refresh)
+/*
+ * Writes a local time epoch as JavaScript date, the month starts at 0
+ * (google graph requirement)
+ */
+void writeGraphDate(ResponseWriter &out, time_t epoch)
 {
-    String head = F("<!DOCTYPE html>"
-                    "<html>"
-                    "<head>"
-                    "<meta charset=\"utf-8\">");
+    // gmtime is used to convert to localtime, because the eoch value is localtime
+    struct tm ts = *gmtime(&epoch);
+    out.printf("new Date(%04d,%d,%d,%d,%d,%d)",
+               ts.tm_year + 1900, ts.tm_mon, ts.tm_mday, ts.tm_hour, ts.tm_min, ts.tm_sec);
+}
 
-    head += F("<title>");
-    head += title;
-    head += F("</title>");
+/*
+ * Returns the sensor of the parameter "sensor=<ROM code>", 0 (primary sensor)
+ * without parameter; -1 if the sensor is unknown, the web server answers such
+ * a request with the unknown page
+ */
+int getRequestedSensor(void)
+{
+    String serial_code = g_prj_web_server.getParameter("sensor");
+    if (serial_code.isEmpty())
+        return 0;
+    return g_temp_meas.findSensor(serial_code);
+}
 
-    head += getStyleDefinitions();
-    if (refresh)
+/*
+ * Writes the values of a measurement buffer from the row cursor.next up to
+ * the offset last as graph rows or as JSON rows until the step is full,
+ * returns true if all rows are written
+ */
+template <typename _BUFFER>
+bool appendRawRows(_BUFFER &buffer, uint32_t first_number, size_t last, bool graph, ResponseWriter &out, pageCursor_t &cursor)
+{
+    // the values dropped by the buffer since the last step are skipped
+    size_t offset = (int32_t)(cursor.next - first_number) > 0 ? cursor.next - first_number : 0;
+    typename _BUFFER::iterator end(&buffer, last);
+    for (typename _BUFFER::iterator it(&buffer, min(offset, last)); it != end; ++it)
     {
-        // add refresh if refresh is required (>0!)
-        head += F("<meta http-equiv=\"refresh\" content=\"");
-        head += refresh;
-        head += F("\" >");
+        if (out.isFull())
+            return false;
+        const measValue_t &value = *it;
+        cursor.next = first_number + (uint32_t)it.offset() + 1;
+        // time/temperature value
+        time_t epoch = value.timestamp;
+        if (!cursor.first)
+            cursor.first = epoch;
+        if (graph)
+        {
+            out.print(F(",["));
+            writeGraphDate(out, epoch);
+            out.print(',').printTemp(value.temperature, 1).print(']');
+        }
+        else
+        {
+            // mean and the quality of the store window
+            out.print(F(",\r\n[\"")).printTime(epoch).print(F("\","));
+            out.printTemp(value.temperature, 2).print(',');
+            out.printTemp(value.quality.min, 2).print(',');
+            out.printTemp(value.quality.max, 2).print(',');
+            out.printTemp(value.quality.stddev, 2).print(',');
+            out.print(value.quality.valid).print(',');
+            out.print(value.quality.rejected).print(']');
+        }
     }
-    return (head);
+    return true;
 }
 
-String getLinkList(void)
+/*
+ * Writes the values of a sensor inside of the time window as graph rows or as
+ * JSON rows, the rows are continued with the row cursor.next; returns true
+ * if all rows are written
+ */
+bool appendSensorRows(int sensor, const timeWindow_t &window, bool graph, ResponseWriter &out, pageCursor_t &cursor)
 {
-    return String(F("<p>"
-                    "<a href=\"/\"><button>Dashboard</button></a> "
-                    "<a href=\"/graph\"><button>Graph</button></a> "
-                    "<a href=\"/info\"><button>Information</button></a> "
-                    "<a href=\"/measval.js\"><button>JSON temperature file</button></a> "
-                    "</p>"));
+    // the rows are continued by their number, the timestamps of local time
+    // are repeated at the end of the daylight saving time
+    if (sensor == 0)
+    {
+        return appendRawRows(g_ringbuffer, getFirstValueNumber(0),
+                             window.to ? findMeasValue(window.to + 1) : g_ringbuffer.size(),
+                             graph, out, cursor);
+    }
+    SensorBuffer_t *buffer = sensor > 0 ? getSensorBuffer(sensor) : nullptr;
+    if (!buffer)
+        return true;
+    return appendRawRows(*buffer, getFirstValueNumber(sensor),
+                         window.to ? findSensorValue(sensor, window.to + 1) : buffer->size(),
+                         graph, out, cursor);
 }
 
-String getInfoText(void)
+/*
+ * Writes a rollup value as graph row or as JSON row
+ */
+void appendRollupRow(ResponseWriter &out, const rollupValue_t &value, bool graph)
 {
-    String info = F(
-        "<p class=\"info\">"
-        "Page requests = ");
-    info += String(g_prj_web_server.getRequestedPages());
-    info += F(", free RAM = ");
-    info += String(system_get_free_heap_size());
-    info += F(", max. data points = ");
-    info += String(g_ringbuffer.content());
-    info += F(", scanned data points = ");
-    info += String(g_ringbuffer.size());
-    info += F("</p>");
-    return info;
+    uint8_t decimals = graph ? 1 : 2;
+    if (graph)
+    {
+        out.print(F(",["));
+        writeGraphDate(out, value.timestamp);
+    }
+    else
+    {
+        out.print(F(",\r\n[\"")).printTime(value.timestamp).print('"');
+    }
+    out.print(',').printTemp(value.avg, decimals);
+    out.print(',').printTemp(value.min, decimals);
+    out.print(',').printTemp(value.max, decimals).print(']');
+}
+
+/*
+ * Writes the rows of a rollup tier inside of the time window until the step
+ * is full, the rows are continued with the row cursor.next; returns true if
+ * all rows are written
+ */
+template <size_t _NSIZE>
+bool appendRollupRows(RollupTier<_NSIZE> &tier, const timeWindow_t &window, bool graph, ResponseWriter &out, pageCursor_t &cursor)
+{
+    uint32_t first_number = tier.firstNumber();
+    size_t last = window.to ? tier.lowerBound(window.to + 1) : tier.size();
+    size_t i = (int32_t)(cursor.next - first_number) > 0 ? cursor.next - first_number : 0;
+    for (; i < last; i++)
+    {
+        if (out.isFull())
+            return false;
+        rollupValue_t &value = tier.readFirst(i);
+        cursor.next = first_number + (uint32_t)i + 1;
+        if (!cursor.first)
+            cursor.first = value.timestamp;
+        appendRollupRow(out, value, graph);
+    }
+    if (tier.hasCurrent()
+        && (time_t)tier.current().timestamp >= window.from
+        && (!window.to || (time_t)tier.current().timestamp <= window.to))
+    {
+        // the current period is not closed, but it is the newest information
+        if (out.isFull())
+            return false;
+        if (!cursor.first)
+            cursor.first = tier.current().timestamp;
+        appendRollupRow(out, tier.current(), graph);
+    }
+    return true;
+}
+
+/*
+ * Sets the history rows of the page by the first step: the sensor, the time
+ * window and the tier are fixed for the whole response, cursor.next is the
+ * number of the first row inside of the window
+ */
+void startHistoryRows(pageCursor_t &cursor)
+{
+    cursor.window = getRequestedWindow();
+    cursor.sensor = (int8_t)getRequestedSensor();
+    // the additional sensors have raw values only
+    HistoryTier_t tier = cursor.sensor ? HistoryTier_t::RAW : selectHistoryTier(cursor.window);
+    cursor.tier = static_cast<uint8_t>(tier);
+
+    time_t from = cursor.window.from;
+    if (tier == HistoryTier_t::HOURLY)
+        cursor.next = g_rollup_hourly.firstNumber() + (from ? g_rollup_hourly.lowerBound(from) : 0);
+    else if (tier == HistoryTier_t::DAILY)
+        cursor.next = g_rollup_daily.firstNumber() + (from ? g_rollup_daily.lowerBound(from) : 0);
+    else if (cursor.sensor == 0)
+        cursor.next = getFirstValueNumber(0) + (from ? findMeasValue(from) : 0);
+    else if (cursor.sensor > 0)
+        cursor.next = getFirstValueNumber(cursor.sensor) + (from ? findSensorValue(cursor.sensor, from) : 0);
+}
+
+/*
+ * Writes the rows of the history tier of the page, see startHistoryRows()
+ * and appendSensorRows()
+ */
+bool appendHistoryRows(bool graph, ResponseWriter &out, pageCursor_t &cursor)
+{
+    HistoryTier_t tier = static_cast<HistoryTier_t>(cursor.tier);
+    if (tier == HistoryTier_t::HOURLY)
+        return appendRollupRows(g_rollup_hourly, cursor.window, graph, out, cursor);
+    if (tier == HistoryTier_t::DAILY)
+        return appendRollupRows(g_rollup_daily, cursor.window, graph, out, cursor);
+    return appendSensorRows(cursor.sensor, cursor.window, graph, out, cursor);
 }
 
 /*******************************************************************************
  * Web Pages
  ******************************************************************************/
 
-uint32_t sendPage_Index(WiFiClient *client)
+bool sendPage_Index(ResponseWriter &out, pageCursor_t &cursor)
 {
-    uint32_t send_size = 0;
-    String answer;
     // build page content
-    answer = getHtmlHeadStartSequence("Actual Temperature", 60);
-    answer += F(
-        "<script type=\"text/javascript\" src=\"https://www.gstatic.com/charts/loader.js\"></script>"
-        "<script type=\"text/javascript\">"
-        "google.charts.load('current', { 'packages': ['gauge'] });"
-        "google.charts.setOnLoadCallback(drawChart);"
-        "function drawChart() {"
-        "var data = google.visualization.arrayToDataTable(["
-        "['Label', 'Value'],['Temp °C',");
-    char buf[16];
-    sprintf(buf, "%.1f", g_temp_meas.getValue());
-    answer += buf;
-    answer += F(
-        "]]);"
-        "var options = {"
-        "min: 15, max: 40,"
-        "greenFrom: 19, greenTo: 26,"
-        "yellowFrom: 26, yellowTo: 29,"
-        "redFrom: 29, redTo: 40,"
-        "minorTicks: 5, majorTicks: [15, 20, 25, 30, 35, 40]"
-        "};"
-        "var chart = new google.visualization.Gauge(document.getElementById('chart_div'));"
-        "chart.draw(data, options);"
-        "}"
-        "</script>"
-        "</head>"
-        "<body>"
-        "<h1>Actual Temperature: ");
-    answer += getLocation();
-    answer += F("</h1>"
-                "<div id=\"chart_div\" style=\"width: 800px; height: 400px;\"></div>");
-    answer += getLinkList();
-    answer += getInfoText();
-    answer += F(
-        "</body>"
-        "</html>");
-    // .. and get the size
-    send_size += answer.length();
-    // Send the response to the client if required
-    if (client)
+    switch (cursor.step)
     {
-        client->print(answer);
+    case 0:
+        writeHtmlHeadStartSequence(out, F("Actual Temperature"), 60);
+        break;
+    case 1:
+        out.print(F(
+            "<script type=\"text/javascript\" src=\"https://www.gstatic.com/charts/loader.js\"></script>"
+            "<script type=\"text/javascript\">"
+            "google.charts.load('current', { 'packages': ['gauge'] });"
+            "google.charts.setOnLoadCallback(drawChart);"
+            "function drawChart() {"
+            "var data = google.visualization.arrayToDataTable(["
+            "['Label', 'Value'],['Temp °C',"));
+        out.printTemp(g_temp_meas.getValue(), 1);
+        out.print(F(
+            "]]);"
+            "var options = {"
+            "min: 15, max: 40,"
+            "greenFrom: 19, greenTo: 26,"
+            "yellowFrom: 26, yellowTo: 29,"
+            "redFrom: 29, redTo: 40,"
+            "minorTicks: 5, majorTicks: [15, 20, 25, 30, 35, 40]"
+            "};"
+            "var chart = new google.visualization.Gauge(document.getElementById('chart_div'));"
+            "chart.draw(data, options);"
+            "}"
+            "</script>"
+            "</head>"));
+        break;
+    default:
+        out.print(F("<body>"
+                    "<h1>Actual Temperature: "));
+        out.print(getLocation());
+        out.print(F("</h1>"
+                    "<div id=\"chart_div\" style=\"width: 800px; height: 400px;\"></div>"));
+        writeLinkList(out);
+        writeInfoText(out);
+        out.print(F(
+            "</body>"
+            "</html>"));
+        return true;
     }
-    return send_size;
-}
-
-void page_Index(WiFiClient &wifi_client)
-{
-    // get page size
-    uint32_t send_size = 0;
-    send_size += sendPage_Index(NULL);
-    // send HTTP header with size information
-    wifi_client.print(getHTTPTypeSizeHeader("text/html", send_size));
-    // send page
-    sendPage_Index(&wifi_client);
+    cursor.step++;
+    return false;
 }
 
-uint32_t sendPage_Info(WiFiClient *client)
+bool sendPage_Info(ResponseWriter &out, pageCursor_t &cursor)
 {
-    uint32_t send_size = 0;
-    // build page content
-    String answer;
-    answer = getHtmlHeadStartSequence("Information Page", 300 / 2);
-    answer += F(
-        "</head>"
-        "<body>"
-        "<h1>Information Page</h1>"
-        "<h2>Internet</h2>");
-    answer += F("<div class=\"data\">Hostname: ");
-    answer += WiFi.hostname();
-    answer += F("</div>");
-
-    answer += F("<div class=\"data\">IP address: ");
-    answer += WiFi.localIP().toString();
-    answer += F("</div>");
-
-    answer += F("<div class=\"data\">MAC address: ");
-    answer += WiFi.macAddress();
-    answer += F("</div>");
-
-    answer += F("<div class=\"data\">Page requests: ");
-    answer += g_prj_web_server.getRequestedPages();
-    answer += F("</div>");
-
-    answer += F("<h2>Measurement</h2>");
-
-    answer += F("<div class=\"data\">Location: ");
-    answer += getLocation();
-    answer += F("</div>");
-
-    answer += F("<div class=\"data\">DS18B20 serial code: ");
-    answer += g_temp_meas.getSerialCode();
-    answer += F("</div>");
-
-    answer += F("<div class=\"data\">Max. measurement buffer size: ");
-    answer += g_ringbuffer.content();
-    answer += F("</div>");
-
-    answer += F("<div class=\"data\">Added measurements to buffer: ");
-    answer += g_ringbuffer.size();
-    answer += F("</div>");
-
-    answer += F("<div class=\"data\">Measurement interval: ");
-    answer += g_timer_values.store_interval / 1000;
-    answer += F(" sec</div>");
-
-    answer += F("<div class=\"data\">Measurement range: ");
-    answer += RINGBUFFER_SIZE * (g_timer_values.store_interval / 1000.0) / (60.0 * 60.0 * 24.0);
-    answer += F(" days</div>");
-
-    answer += F("<div class=\"data\">Memory measurement buffer: ");
-    answer += RINGBUFFER_SIZE * sizeof(measValue_t);
-    answer += F(" byte</div>");
-
-    if (g_ringbuffer.size())
+    // build page content, a section per step
+    switch (cursor.step)
     {
-        answer += F("<div class=\"data\">Actual temperature: ");
-        answer += g_ringbuffer.readLast().temperature;
-        answer += F(" °C</div>");
+    case 0:
+        writeHtmlHeadStartSequence(out, F("Information Page"), 300 / 2);
+        out.print(F(
+            "</head>"
+            "<body>"
+            "<h1>Information Page</h1>"
+            "<h2>Internet</h2>"));
+        out.print(F("<div class=\"data\">Hostname: "));
+        out.print(WiFi.hostname());
+        out.print(F("</div>"));
 
-        answer += F("<div class=\"data\">Start logger time: ");
-        answer += convertEpochToIso8601(g_timer_values.start_timestamp);
-        answer += F("</div>");
+        out.print(F("<div class=\"data\">IP address: "));
+        out.print(WiFi.localIP().toString());
+        out.print(F("</div>"));
 
-        answer += F("<div class=\"data\">Newest measurement time: ");
-        answer += convertEpochToIso8601(g_ringbuffer.readLast().timestamp);
-        answer += F("</div>");
+        out.print(F("<div class=\"data\">MAC address: "));
+        out.print(WiFi.macAddress());
+        out.print(F("</div>"));
 
-        answer += F("<div class=\"data\">Oldest measurement time: ");
-        answer += convertEpochToIso8601(g_ringbuffer.readFirst().timestamp);
-        answer += F("</div>");
-    }
+        out.print(F("<div class=\"data\">Page requests: "));
+        out.print(g_prj_web_server.getRequestedPages());
+        out.print(F(", refused clients: "));
+        out.print(g_prj_web_server.getRefusedClients());
+        out.print(F(", timeouts: "));
+        out.print(g_prj_web_server.getTimeouts());
+        out.print(F("</div>"));
+        break;
 
-    answer += F("<div class=\"data\">Temperature correction value: ");
-    answer += getTempCorrection();
-    answer += F(" °K</div>");
+    case 1:
+        // time to the first chunk and to the end of the response of the last request
+        for (; cursor.row < g_prj_web_server.getPageCount(); cursor.row++)
+        {
+            const pageTiming_t &timing = g_prj_web_server.getPageTiming(cursor.row);
+            if (!timing.requests)
+            {
+                continue;
+            }
+            if (out.isFull())
+            {
+                return false;
+            }
+            out.print(F("<div class=\"data\">Page "));
+            out.print(*g_prj_web_server.getPagePath(cursor.row) ? g_prj_web_server.getPagePath(cursor.row) : "unknown");
+            out.printf(": %u requests, first chunk %u us (max. %u us), complete %u us (max. %u us), %u byte",
+                       timing.requests, timing.ttfb, timing.ttfb_max, timing.render, timing.render_max, timing.size);
+            out.printf(", heap %u byte (max. %u byte), fragmentation %u %% (max. %u %%), %u blocking writes</div>",
+                       timing.heap, timing.heap_max, timing.fragmentation, timing.fragmentation_max, timing.blocking_writes);
+        }
+        break;
+
+    case 2:
+        if (!cursor.row)
+        {
+            out.print(F("<h2>Measurement</h2>"));
 
-    answer += F("<h2>System</h2>");
-    answer += F("<div class=\"data\">Author: " SOFTWARE_AUTHOR "</div>");
-    answer += F("<div class=\"data\">Program version: " SOFTWARE_VERSION "</div>");
-    answer += F("<div class=\"data\">Release date: " RELEASE_DATE "</div>");
-    answer += F("<div class=\"data\">Compile time: " __DATE__ ", " __TIME__ "</div>");
+            out.print(F("<div class=\"data\">Location: "));
+            out.print(getLocation());
+            out.print(F("</div>"));
 
-    answer += F("<div class=\"data\">Compiler: ");
-    answer += __cplusplus;
-    answer += F("L</div>");
+            out.print(F("<div class=\"data\">DS18B20 serial code: "));
+            out.print(g_temp_meas.getSerialCode());
+            out.print(F("</div>"));
+            cursor.row = 1;
+        }
 
-    answer += F("<div class=\"data\">Free memory: ");
-    answer += system_get_free_heap_size();
-    answer += F("</div>");
+        // additional sensors with their own buffers
+        for (; cursor.row < g_temp_meas.getSensorCount(); cursor.row++)
+        {
+            if (out.isFull())
+            {
+                return false;
+            }
+            uint8_t sensor = cursor.row;
+            const char *serial_code = g_temp_meas.getSerialCode(sensor);
+            SensorBuffer_t *buffer = getSensorBuffer(sensor);
+            out.print(F("<div class=\"data\">Sensor "));
+            out.print(serial_code);
+            out.print(F(": "));
+            out.printTemp(g_temp_meas.getValue(sensor), 2);
+            out.print(F(" °C, "));
+            out.print(buffer ? buffer->size() : 0);
+            out.print(F(" of "));
+            out.print(buffer ? buffer->content() : 0);
+            out.print(F(" values, "));
+            out.print(g_temp_meas.getReadErrors(sensor));
+            out.print(F(" failed reads, "));
+            out.print(g_temp_meas.getRejectedSamples(sensor));
+            out.print(F(" rejected samples <a href=\"/graph?sensor="));
+            out.print(serial_code);
+            out.print(F("\">Graph</a> <a href=\"/measval.js?sensor="));
+            out.print(serial_code);
+            out.print(F("\">JSON</a></div>"));
+        }
+        break;
+
+    case 3:
+        out.print(F("<div class=\"data\">Measurement buffer capacity: "));
+        out.print(g_ringbuffer.content());
+#ifndef MEASBUFFER_COMPRESSED
+        out.print(F(" (sized by free heap, reserve "));
+        out.print(MEASBUFFER_HEAP_RESERVE);
+        out.print(F(" byte)"));
+#endif
+        out.print(F("</div>"));
+
+        out.print(F("<div class=\"data\">Added measurements to buffer: "));
+        out.print(g_ringbuffer.size());
+        out.print(F("</div>"));
+
+        out.print(F("<div class=\"data\">Sensor source: "));
+        out.print(g_temp_meas.getSourceName());
+        out.print(F("</div>"));
+
+        // mean CPU cost of the sample filter stages
+        out.print(F("<div class=\"data\">Sample filter:"));
+        for (size_t i = 0; i < SampleFilter_t::STAGES; i++)
+        {
+            const filterCost_t *cost = SampleFilter_t::getCost(i);
+            out.print(i ? F(", ") : F(" "));
+            out.print(SampleFilter_t::getName(i));
+            out.print(F(" "));
+            out.print(cost->calls ? cost->cycles / cost->calls : 0);
+            out.print(F(" cycles"));
+        }
+        out.print(F("</div>"));
+
+        out.print(F("<div class=\"data\">DS18B20 conversion time: "));
+        out.print(g_temp_meas.getConversionTime());
+        out.print(F(" ms (max. "));
+        out.print(g_temp_meas.getMaxConversionTime());
+        out.print(F(" ms), max. block time "));
+        out.print(g_temp_meas.getMaxBlockTime());
+        out.print(F(" us</div>"));
+        break;
+
+    case 4:
+        out.print(F("<div class=\"data\">Sampling governor: "));
+        out.printf("%s, %u bit, interval %u sec, rate %.2f °C/min, %u changes, duty cycle %.2f %%",
+                   g_temp_meas.getGovernorLevelName(), g_temp_meas.getResolution(),
+                   g_temp_meas.getMeasInterval() / 1000, g_temp_meas.getRateOfChange(),
+                   g_temp_meas.getLevelChanges(), g_temp_meas.getDutyCycle());
+        out.print(F("</div>"));
+
+        out.print(F("<div class=\"data\">Timer sampling: "));
+        out.printf("interval %u ms, jitter mean %u us, max. %u us, %u samples, %u lost, queue %u of %u",
+                   g_sampler.getInterval(), g_sampler.getMeanJitter(), g_sampler.getMaxJitter(),
+                   g_sampler.getSamples(), g_sampler.getDroppedSamples(), (unsigned int)g_sampler.getQueueSize(),
+                   (unsigned int)(SAMPLER_QUEUE_SIZE - 1));
+        out.print(F("</div>"));
+
+        out.print(F("<div class=\"data\">1-wire bus time per cycle: "));
+        out.print(g_temp_meas.getBusTime());
+        out.print(F(" us for "));
+        out.print(g_temp_meas.getSensorCount());
+        out.print(F(" sensors (max. "));
+        out.print(g_temp_meas.getMaxBusTime());
+        out.print(F(" us), CRC errors "));
+        out.print(g_temp_meas.getCrcErrors());
+        out.print(F(", failed reads "));
+        out.print(g_temp_meas.getReadErrors());
+        out.print(F(", rejected samples "));
+        out.print(g_temp_meas.getRejectedSamples());
+        out.print(F("</div>"));
+        break;
+
+    case 5:
+        // health of each sensor, the JSON version is "/health"
+        for (; cursor.row < g_temp_meas.getSensorCount(); cursor.row++)
+        {
+            if (out.isFull())
+            {
+                return false;
+            }
+            uint8_t sensor = cursor.row;
+            const sensorHealth_t &health = g_temp_meas.getHealth(sensor);
+            out.print(F("<div class=\"data\">Sensor health "));
+            out.print(g_temp_meas.getSerialCode(sensor));
+            out.printf(": %u reads, %u CRC errors, %u retries, %u disconnects, %u power on values, %u stuck%s, last read ",
+                       health.reads, health.crc_errors, health.retries, health.disconnects,
+                       health.power_on, health.stuck_events, health.stuck ? " (now)" : "");
+            if (health.last_good)
+            {
+                out.print((millis() - health.last_good) / 1000);
+                out.print(F(" sec ago</div>"));
+            }
+            else
+            {
+                out.print(F("never</div>"));
+            }
+        }
+        break;
+
+    case 6:
+        // alarm thresholds in the TH/TL registers of the sensors
+        if (!cursor.count)
+        {
+            out.print(F("<div class=\"data\">Alarm watch: "));
+            if (g_temp_meas.isAlarmWatch())
+            {
+                out.print(F("on, "));
+                out.print(g_temp_meas.getAlarmSearches());
+                out.print(F(" alarm searches</div>"));
+            }
+            else
+            {
+                out.print(F("off</div>"));
+            }
+            cursor.count = 1;
+        }
+        for (; cursor.row < g_temp_meas.getSensorCount(); cursor.row++)
+        {
+            uint8_t sensor = cursor.row;
+            const sensorAlarm_t &alarm = g_temp_meas.getAlarm(sensor);
+            if (!alarm.enabled)
+            {
+                continue;
+            }
+            if (out.isFull())
+            {
+                return false;
+            }
+            out.print(F("<div class=\"data\">Sensor alarm "));
+            out.print(g_temp_meas.getSerialCode(sensor));
+            out.printf(": %d..%d °C, %s, %u events", alarm.low, alarm.high,
+                       alarm.active ? "active" : "inactive", alarm.events);
+            if (alarm.last_event)
+            {
+                out.print(F(", last "));
+                out.print((millis() - alarm.last_event) / 1000);
+                out.print(F(" sec ago"));
+            }
+            out.print(F("</div>"));
+        }
+        break;
+
+    case 7:
+        out.print(F("<div class=\"data\">Conversion time histogram [ms]: "));
+        for (uint8_t bin = 0; bin < MEAS_LATENCY_BINS; bin++)
+        {
+            out.print(bin ? F(", ") : F(""));
+            out.print(bin < MEAS_LATENCY_BINS - 1 ? F("&lt;") : F("&ge;"));
+            out.print((bin < MEAS_LATENCY_BINS - 1 ? bin + 1 : bin) * MEAS_LATENCY_BIN_WIDTH);
+            out.print(F(": "));
+            out.print(g_temp_meas.getLatencyHistogram(bin));
+        }
+        out.print(F(" <a href=\"/health\">JSON</a></div>"));
+
+        out.print(F("<div class=\"data\">Measurement interval: "));
+        out.print(g_timer_values.store_interval / 1000);
+        out.print(F(" sec</div>"));
+
+        // the values are not equidistant in deadband mode, the average distance is used
+        out.print(F("<div class=\"data\">Measurement buffer range: "));
+        out.print(g_ringbuffer.content() * getMeasValueSpacing() / (60.0 * 60.0 * 24.0));
+        out.print(F(" days, average value distance "));
+        out.print(getMeasValueSpacing());
+        out.print(F(" sec</div>"));
+
+        out.print(F("<div class=\"data\">Store deadband: "));
+        if (getStoreDeadband() > 0.0)
+        {
+            out.print(getStoreDeadband());
+            out.print(F(" °C, heartbeat "));
+            out.print(getStoreHeartbeat() / 60);
+            out.print(F(" min, "));
+            out.print(getSkippedValues());
+            out.print(F(" skipped values"));
+        }
+        else
+        {
+            out.print(F("off"));
+        }
+        out.print(F("</div>"));
+
+        out.print(F("<div class=\"data\">Hourly rollup values: "));
+        out.print(g_rollup_hourly.size());
+        out.print(F(" of "));
+        out.print(g_rollup_hourly.content());
+        out.print(F("</div>"));
+
+        out.print(F("<div class=\"data\">Daily rollup values: "));
+        out.print(g_rollup_daily.size());
+        out.print(F(" of "));
+        out.print(g_rollup_daily.content());
+        out.print(F(", "));
+        out.print(g_rollup_store.getSaves());
+        out.print(F(" saves, loaded in "));
+        out.print(g_rollup_store.getLoadTime());
+        out.print(F(" ms</div>"));
+
+        out.print(F("<div class=\"data\">Memory measurement buffer: "));
+        out.print(getMeasBufferMemory());
+        out.print(F(" byte</div>"));
+        break;
+
+    case 8:
+        if (g_ringbuffer.size())
+        {
+            out.print(F("<div class=\"data\">Actual temperature: "));
+            out.printTemp(g_ringbuffer.readLast().temperature, 2);
+            out.print(F(" °C</div>"));
+
+            out.print(F("<div class=\"data\">Start logger time: "));
+            out.printTime(g_timer_values.start_timestamp);
+            out.print(F("</div>"));
+
+            out.print(F("<div class=\"data\">Newest measurement time: "));
+            out.printTime(g_ringbuffer.readLast().timestamp);
+            out.print(F("</div>"));
+
+            out.print(F("<div class=\"data\">Oldest measurement time: "));
+            out.printTime(g_ringbuffer.readFirst().timestamp);
+            out.print(F("</div>"));
+        }
+
+        out.print(F("<div class=\"data\">Flash log: "));
+        out.print(g_flashlog.getRestoredValues());
+        out.print(F(" values restored in "));
+        out.print(g_flashlog.getRecoveryTime());
+        out.print(F(" ms, "));
+        out.print(g_flashlog.getPageWrites());
+        out.print(F(" page writes</div>"));
+
+        out.print(F("<div class=\"data\">Archive: "));
+        out.print(g_archive.getSealedDays());
+        out.print(F(" days sealed, "));
+        out.print(g_archive.getDeletedFiles());
+        out.print(F(" files deleted by retention</div>"));
+
+        out.print(F("<div class=\"data\">Start: "));
+        if (g_rtc_snapshot.isWarmStart())
+        {
+            out.print(F("warm start by RTC snapshot in "));
+            out.print(g_rtc_snapshot.getRestoreTime());
+            out.print(F(" us"));
+        }
+        else
+        {
+            out.print(F("cold start"));
+        }
+        out.print(F("</div>"));
+
+        out.print(F("<div class=\"data\">Temperature correction value: "));
+        out.print(getTempCorrection());
+        out.print(F(" °K</div>"));
+        break;
+
+    default:
+        out.print(F("<h2>System</h2>"));
+        out.print(F("<div class=\"data\">Author: " SOFTWARE_AUTHOR "</div>"));
+        out.print(F("<div class=\"data\">Program version: " SOFTWARE_VERSION "</div>"));
+        out.print(F("<div class=\"data\">Release date: " RELEASE_DATE "</div>"));
+        out.print(F("<div class=\"data\">Compile time: " __DATE__ ", " __TIME__ "</div>"));
+
+        out.print(F("<div class=\"data\">Compiler: "));
+        out.print(__cplusplus);
+        out.print(F("L</div>"));
+
+        out.print(F("<div class=\"data\">Free memory: "));
+        out.print(system_get_free_heap_size());
+        out.print(F("</div>"));
 
 #ifdef ARDUINO_OTA_ENABLE
-    answer += F("<div class=\"data\">Arduino feature OTA: enabled</div>");
+        out.print(F("<div class=\"data\">Arduino feature OTA: enabled</div>"));
 #else
-    answer += F("<div class=\"data\">Arduino feature OTA: disabled</div>");
+        out.print(F("<div class=\"data\">Arduino feature OTA: disabled</div>"));
 #endif
 
-    answer += getLinkList();
-    answer += F("</body>");
-    answer += F("</html>");
+        writeLinkList(out);
+        out.print(F("</body>"));
+        out.print(F("</html>"));
+        return true;
+    }
+    cursor.row = 0;
+    cursor.count = 0;
+    cursor.step++;
+    return false;
+}
 
-    // .. and get the size
-    send_size += answer.length();
-    // Send the response to the client if required
-    if (client)
+bool sendPage_Graph(ResponseWriter &out, pageCursor_t &cursor)
+{
+    // build page content
+    switch (cursor.step)
     {
-        client->print(answer);
+    case 0:
+        startHistoryRows(cursor);
+        writeHtmlHeadStartSequence(out, F("Temperature Graph"), 300 / 2);
+        out.print(F(
+            "<script type=\"text/javascript\" src=\"https://www.gstatic.com/charts/loader.js\"></script>"
+            "<script type=\"text/javascript\">"
+            "google.load('visualization', '1', { packages: ['controls', 'charteditor'] });"
+            "google.setOnLoadCallback(drawChart);"
+            "function drawChart() {"
+            "var data = google.visualization.arrayToDataTable(["));
+        if (cursor.tier == static_cast<uint8_t>(HistoryTier_t::RAW))
+            out.print(F("['Date/Time','Temperature °C']"));
+        else
+            out.print(F("['Date/Time','Temperature °C','Min °C','Max °C']"));
+        break;
+
+    case 1:
+        // get list of temperature/time values, continued by the next step if the block is full
+        if (!appendHistoryRows(true, out, cursor))
+            return false;
+        break;
+
+    case 2:
+        // set the rest of the html page
+        out.print(F("]);"
+                    "var dash = new google.visualization.Dashboard(document.getElementById('dashboard'));"
+                    "var chart = new google.visualization.ChartWrapper({"
+                    "chartType: 'ComboChart',"
+                    "containerId: 'chart_div',"
+                    "options: {"
+                    "title: 'Temperature Diagram',"
+                    "width: '100%',"
+                    "height: 720,"
+                    "chartArea: { left: 100, top: 40, width: '80%', height: '65%', right: 20, bottom: 80 },"
+                    "legend: {"
+                    "position: 'none',"
+                    "alignment: 'center',"
+                    "textStyle: {"
+                    "fontSize: 12"
+                    "}"
+                    "},"
+                    "backgroundColor: '#FEFDDE',"
+                    "explorer: {"
+                    "actions: ['dragToZoom', 'rightClickToReset'],"
+                    "axis: 'horizontal',"
+                    "keepInBounds: true"
+                    "},"
+                    "hAxis: {"
+                    "title: 'Time'"
+                    "},"));
+
+        if (cursor.tier == static_cast<uint8_t>(HistoryTier_t::RAW) && g_ringbuffer.size() < 200)
+            out.print(F("pointSize: 3,"));
+        out.print(F("vAxis: {"
+                    "title: 'Temp [°C]'"
+                    "},"
+                    "series: {"
+                    "0: {"
+                    "curveType: 'function',"
+                    "color: '#0080FF'"
+                    "},"));
+        if (cursor.tier != static_cast<uint8_t>(HistoryTier_t::RAW))
+        {
+            // min/max lines of the rollup tiers
+            out.print(F("1: {"
+                        "color: '#80C0FF',"
+                        "lineDashStyle: [4, 4]"
+                        "},"
+                        "2: {"
+                        "color: '#FF8040',"
+                        "lineDashStyle: [4, 4]"
+                        "}"));
+        }
+        break;
+
+    case 3:
+        out.print(F("},"
+                    "}"
+                    "});"
+                    "var control = new google.visualization.ControlWrapper({"
+                    "controlType: 'ChartRangeFilter',"
+                    "containerId: 'control_div',"
+                    "options: {"
+                    "filterColumnIndex: 0,"
+                    "ui: {"
+                    "chartOptions: {"
+                    "height: 50,"
+                    "chartArea: {"
+                    "width: '100%',"
+                    "left: 20,"
+                    "right: 20"
+                    "}"
+                    "}"
+                    "}"
+                    "},"
+                    "state: {"
+                    "range: {"
+                    "start: "));
+        writeGraphDate(out, cursor.first);
+        out.print(F("}"
+                    "}"
+                    "});"
+                    "dash.bind([control], [chart]);"
+                    "dash.draw(data);"
+                    "}"
+                    "</script>"
+                    "</head>"));
+        break;
+
+    default:
+        out.print(F("<body>"
+                    "<h1>Temperature: "));
+        out.print(getLocation());
+        if (cursor.sensor)
+        {
+            out.print(F(", sensor "));
+            out.print(g_prj_web_server.getParameter("sensor"));
+        }
+        out.print(F("</h1>"
+                    "<div id=\"dashboard_div\">"
+                    "<div id=\"chart_div\"> </div>"
+                    "<div id=\"control_div\"> </div>"
+                    "</div>"));
+        writeLinkList(out);
+        writeInfoText(out);
+        out.print(F(
+            "</body>"
+            "</html>"));
+        return true;
     }
-    return send_size;
+    cursor.step++;
+    return false;
 }
 
-void page_Info(WiFiClient &wifi_client)
+bool sendPage_MeasValue(ResponseWriter &out, pageCursor_t &cursor)
 {
-    // get page size
-    uint32_t send_size = 0;
-    send_size += sendPage_Info(NULL);
-    // send HTTP header with size information
-    wifi_client.print(getHTTPTypeSizeHeader("text/html", send_size));
-    // send page
-    sendPage_Info(&wifi_client);
+    // build page content
+    switch (cursor.step)
+    {
+    case 0:
+        startHistoryRows(cursor);
+        out.print(F("["));
+        if (cursor.tier == static_cast<uint8_t>(HistoryTier_t::RAW))
+            out.print(F("[\"Date/Time\",\"Temperature °C\",\"Min °C\",\"Max °C\",\"Std. dev. °C\",\"Valid\",\"Rejected\"]"));
+        else
+            out.print(F("[\"Date/Time\",\"Temperature °C\",\"Min °C\",\"Max °C\"]"));
+        break;
+
+    case 1:
+        // continued by the next step if the block is full
+        if (!appendHistoryRows(false, out, cursor))
+            return false;
+        break;
+
+    default:
+        out.print(F("]"));
+        return true;
+    }
+    cursor.step++;
+    return false;
 }
 
-uint32_t sendPage_Graph(WiFiClient *client)
+bool sendPage_Stats(ResponseWriter &out, pageCursor_t &)
 {
-    uint32_t send_size = 0;
     // build page content
-    String answer;
-    answer = getHtmlHeadStartSequence("Temperature Graph", 300 / 2);
-    answer += F(
-        "<script type=\"text/javascript\" src=\"https://www.gstatic.com/charts/loader.js\"></script>"
-        "<script type=\"text/javascript\">"
-        "google.load('visualization', '1', { packages: ['controls', 'charteditor'] });"
-        "google.setOnLoadCallback(drawChart);"
-        "function drawChart() {"
-        "var data = google.visualization.arrayToDataTable([");
-    if (client)
+    timeWindow_t window = getRequestedWindow();
+    uint8_t sensor = (uint8_t)getRequestedSensor();
+    aggregate_t stats = getSensorStatistics(sensor, window.from, window.to);
+
+    out.print(F("{\"sensor\":\""));
+    out.print(g_temp_meas.getSerialCode(sensor));
+    out.print(F("\",\"from\":\""));
+    if (window.from)
+        out.printTime(window.from);
+    out.print(F("\",\"to\":\""));
+    if (window.to)
+        out.printTime(window.to);
+    out.print(F("\",\"count\":"));
+    out.print(stats.count);
+    if (stats.count)
     {
-        client->print(answer);
+        out.print(F(",\"min\":"));
+        out.printTemp(stats.min, 2);
+        out.print(F(",\"max\":"));
+        out.printTemp(stats.max, 2);
+        out.print(F(",\"avg\":"));
+        out.printTemp(divRound(stats.sum, stats.count), 2);
     }
-    send_size += answer.length();
-    answer.clear();
+    out.print(F("}"));
+    return true;
+}
 
-    // working variables for loop
-    char buf[64];
-    struct tm ts;
+bool sendPage_Archive(ResponseWriter &out, pageCursor_t &cursor)
+{
+    // the day stays open in the cursor, a step reads the values that fit into the block
+    static const size_t ARCHIVE_ROW_SIZE = 40;
+    archiveValue_t values[ARCHIVE_CHUNK_VALUES];
 
-    // get list of temperature/time values
-    answer += "['Date/Time','Temperature °C']";
-    for (size_t i = 0; i < g_ringbuffer.size(); i++)
+    // build page content
+    switch (cursor.step)
     {
-        // time/temperature value
-        time_t epoch = g_ringbuffer.readFirst(i).timestamp;
-        // gmtime is used to convert to localtime, because the eoch value is localtime
-        ts = *gmtime(&epoch);
-        sprintf(buf, ",[new Date(%04d,%d,%d,%d,%d,%d),%.1f]"
-                // set time, month starts at 0 (google graph requirement)
-                ,
-                ts.tm_year + 1900, ts.tm_mon, ts.tm_mday, ts.tm_hour, ts.tm_min, ts.tm_sec
-                // set temperature
-                ,
-                g_ringbuffer.readFirst(i).temperature);
-        answer += buf;
-
-        // send/clear buffer if buffersize limit is reached
-        if (answer.length() > HTTP_BLOCK_SIZE)
+    case 0:
+    {
+        time_t date = convertIso8601ToEpoch(g_prj_web_server.getParameter("date"));
+        out.print(F("[[\"Date/Time\",\"Temperature °C\"]"));
+        if (!date || !g_archive.openDay(date, cursor.reader))
         {
-            if (client)
-            {
-                client->print(answer);
-            }
-            send_size += answer.length();
-            answer.clear();
+            cursor.step = 2;
+            return false;
         }
+        break;
     }
 
-    // get rid of the rest of data list
-    if (client)
-    {
-        client->print(answer);
-    }
-    send_size += answer.length();
-    answer.clear();
-    // set the rest of the html page
-    answer += F("]);"
-                "var dash = new google.visualization.Dashboard(document.getElementById('dashboard'));"
-                "var chart = new google.visualization.ChartWrapper({"
-                "chartType: 'ComboChart',"
-                "containerId: 'chart_div',"
-                "options: {"
-                "title: 'Temperature Diagram',"
-                "width: '100%',"
-                "height: 720,"
-                "chartArea: { left: 100, top: 40, width: '80%', height: '65%', right: 20, bottom: 80 },"
-                "legend: {"
-                "position: 'none',"
-                "alignment: 'center',"
-                "textStyle: {"
-                "fontSize: 12"
-                "}"
-                "},"
-                "backgroundColor: '#FEFDDE',"
-                "explorer: {"
-                "actions: ['dragToZoom', 'rightClickToReset'],"
-                "axis: 'horizontal',"
-                "keepInBounds: true"
-                "},"
-                "hAxis: {"
-                "title: 'Time'"
-                "},");
-
-    if (g_ringbuffer.size() < 200)
-        answer += "pointSize: 3,";
-    answer += F("vAxis: {"
-                "title: 'Temp [°C]'"
-                "},"
-                "series: {"
-                "0: {"
-                "curveType: 'function',"
-                "color: '#0080FF'"
-                "}"
-                "},"
-                "}"
-                "});"
-                "var control = new google.visualization.ControlWrapper({"
-                "controlType: 'ChartRangeFilter',"
-                "containerId: 'control_div',"
-                "options: {"
-                "filterColumnIndex: 0,"
-                "ui: {"
-                "chartOptions: {"
-                "height: 50,"
-                "chartArea: {"
-                "width: '100%',"
-                "left: 20,"
-                "right: 20"
-                "}"
-                "}"
-                "}"
-                "},"
-                "state: {"
-                "range: {"
-                "start: new Date(");
-    time_t epoch = g_ringbuffer.readFirst().timestamp;
-    ts = *gmtime(&epoch);
-    sprintf(buf, "%4d,%d,%d,%d,%d,%d", ts.tm_year + 1900, ts.tm_mon, ts.tm_mday, ts.tm_hour, ts.tm_min, ts.tm_sec);
-    answer += buf;
-
-    // get rid of the rest of data list
-    if (client)
+    case 1:
     {
-        client->print(answer);
+        // the day is read in chunks from the flash
+        uint16_t count = g_archive.readValues(cursor.reader, values,
+                                              min(ARCHIVE_CHUNK_VALUES, out.available() / ARCHIVE_ROW_SIZE));
+        for (uint16_t i = 0; i < count; i++)
+        {
+            out.print(F(",\r\n[\"")).printTime(values[i].timestamp).print(F("\","));
+            out.printTemp(values[i].temperature, 2).print(']');
+        }
+        if (count)
+            return false;
+        cursor.reader.file.close();
+        break;
     }
-    send_size += answer.length();
-    answer.clear();
-
-    answer += F(")"
-                "}"
-                "}"
-                "});"
-                "dash.bind([control], [chart]);"
-                "dash.draw(data);"
-                "}"
-                "</script>"
-                "</head>"
-                "<body>"
-                "<h1>Temperature: ");
-    answer += getLocation();
-    answer += F("</h1>"
-                "<div id=\"dashboard_div\">"
-                "<div id=\"chart_div\"> </div>"
-                "<div id=\"control_div\"> </div>"
-                "</div>");
-    answer += getLinkList();
-    answer += getInfoText();
-    answer += F(
-        "</body>"
-        "</html>");
-
-    // .. and get the size
-    send_size += answer.length();
-    // Send the response to the client if required
-    if (client)
-    {
-        client->print(answer);
+
+    default:
+        out.print(F("]"));
+        return true;
     }
-    //DEBUG_PRINTLN(answer);
-    return send_size;
+    cursor.step++;
+    return false;
 }
 
-void page_Graph(WiFiClient &wifi_client)
+bool sendPage_ArchiveIndex(ResponseWriter &out, pageCursor_t &cursor)
 {
-    // get page size
-    uint32_t send_size = 0;
-    send_size += sendPage_Graph(NULL);
-    //DEBUG_PRINTF1("MeasAll size: %u\n", send_size);
-    // send HTTP header with size information
-    wifi_client.print(getHTTPTypeSizeHeader("text/html", send_size));
-    // send page
-    sendPage_Graph(&wifi_client);
+    // build page content
+    if (!cursor.step)
+    {
+        out.print(F("["));
+        cursor.step = 1;
+    }
+
+    // the index is read again by each step, the written days are skipped
+    uint16_t day_index = 0;
+    bool full = false;
+    g_archive.readDays([&](const archiveDay_t &day) {
+        if (full || day_index++ < cursor.row)
+            return;
+        if (out.isFull())
+        {
+            full = true;
+            return;
+        }
+        time_t epoch = day.date;
+        struct tm ts = *gmtime(&epoch);
+        out.printf("%s\r\n{\"date\":\"%04d-%02d-%02d\",\"count\":%u,\"min\":",
+                   cursor.row ? "," : "", ts.tm_year + 1900, ts.tm_mon + 1, ts.tm_mday, day.count);
+        out.printTemp(day.min, 2).print(F(",\"avg\":")).printTemp(day.avg, 2);
+        out.print(F(",\"max\":")).printTemp(day.max, 2).print('}');
+        cursor.row++;
+    });
+    if (full)
+        return false;
+    out.print(F("]"));
+    return true;
 }
 
-uint32_t sendPage_MeasValue(WiFiClient *client)
+bool sendPage_Health(ResponseWriter &out, pageCursor_t &cursor)
 {
-    uint32_t send_size = 0;
     // build page content
-    String answer;
-    answer = F("[");
-    answer += F("[\"Date/Time\",\"Temperature °C\"]");
-
-    for (size_t i = 0; i < g_ringbuffer.size(); i++)
+    switch (cursor.step)
     {
-        answer += ",\r\n[\"" + convertEpochToIso8601(g_ringbuffer.readFirst(i).timestamp) + "\"," + String(g_ringbuffer.readFirst(i).temperature) + "]";
+    case 0:
+        out.print(F("{\"uptime\":"));
+        out.print(millis() / 1000);
+        out.print(F(",\"conversion_time\":"));
+        out.print(g_temp_meas.getConversionTime());
+        out.print(F(",\"max_conversion_time\":"));
+        out.print(g_temp_meas.getMaxConversionTime());
+        out.print(F(",\"bus_time\":"));
+        out.print(g_temp_meas.getBusTime());
+        out.print(F(",\"max_bus_time\":"));
+        out.print(g_temp_meas.getMaxBusTime());
+        out.print(F(",\"crc_errors\":"));
+        out.print(g_temp_meas.getCrcErrors());
+        out.print(F(",\"sample_interval\":"));
+        out.print(g_sampler.getInterval());
+        out.print(F(",\"jitter_mean\":"));
+        out.print(g_sampler.getMeanJitter());
+        out.print(F(",\"jitter_max\":"));
+        out.print(g_sampler.getMaxJitter());
+        out.print(F(",\"samples\":"));
+        out.print(g_sampler.getSamples());
+        out.print(F(",\"lost_samples\":"));
+        out.print(g_sampler.getDroppedSamples());
+        out.print(F(",\"alarm_watch\":"));
+        out.print(g_temp_meas.isAlarmWatch() ? F("true") : F("false"));
+        out.print(F(",\"alarm_searches\":"));
+        out.print(g_temp_meas.getAlarmSearches());
+        out.print(F(",\"web_refused\":"));
+        out.print(g_prj_web_server.getRefusedClients());
+        out.print(F(",\"web_timeouts\":"));
+        out.print(g_prj_web_server.getTimeouts());
+        out.print(F(",\"latency_bin_width\":"));
+        out.print(MEAS_LATENCY_BIN_WIDTH);
+        out.print(F(",\"latency\":["));
+        for (uint8_t bin = 0; bin < MEAS_LATENCY_BINS; bin++)
+        {
+            out.print(bin ? F(",") : F(""));
+            out.print(g_temp_meas.getLatencyHistogram(bin));
+        }
+        out.print(F("],\"sensors\":["));
+        break;
 
-        // check if max buffer size is reached, than send a block
-        if (answer.length() > HTTP_BLOCK_SIZE)
+    case 1:
+        for (; cursor.row < g_temp_meas.getSensorCount(); cursor.row++)
         {
-            send_size += answer.length();
-            if (client)
+            if (out.isFull())
+                return false;
+            uint8_t sensor = cursor.row;
+            const sensorHealth_t &health = g_temp_meas.getHealth(sensor);
+            out.print(sensor ? F(",\r\n{\"rom\":\"") : F("\r\n{\"rom\":\""));
+            out.print(g_temp_meas.getSerialCode(sensor));
+            out.printf("\",\"reads\":%u,\"read_errors\":%u,\"crc_errors\":%u,\"retries\":%u",
+                       health.reads, health.read_errors, health.crc_errors, health.retries);
+            out.printf(",\"disconnects\":%u,\"power_on\":%u,\"rejected\":%u",
+                       health.disconnects, health.power_on, health.rejected);
+            out.printf(",\"stuck\":%s,\"stuck_events\":%u,\"last_good_age\":",
+                       health.stuck ? "true" : "false", health.stuck_events);
+            // age of the last good read [sec], null without read
+            if (health.last_good)
+                out.print((millis() - health.last_good) / 1000);
+            else
+                out.print(F("null"));
+            const sensorAlarm_t &alarm = g_temp_meas.getAlarm(sensor);
+            if (alarm.enabled)
             {
-                client->print(answer);
+                out.printf(",\"alarm\":{\"low\":%d,\"high\":%d,\"active\":%s,\"events\":%u}",
+                           alarm.low, alarm.high, alarm.active ? "true" : "false", alarm.events);
             }
-            //DEBUG_PRINT(answer);
-            answer = "";
+            out.print(F("}"));
         }
-    }
+        break;
 
-    answer += F("]");
-    // .. and get the size
-    send_size += answer.length();
-    // Send the response to the client if required
-    if (client)
-    {
-        client->print(answer);
-    }
-    //DEBUG_PRINTLN(answer);
-    return send_size;
-}
+    case 2:
+        // response times of the pages
+        if (!cursor.row)
+            out.print(F("],\"pages\":["));
+        for (; cursor.row < g_prj_web_server.getPageCount(); cursor.row++)
+        {
+            const pageTiming_t &timing = g_prj_web_server.getPageTiming(cursor.row);
+            if (!timing.requests)
+                continue;
+            if (out.isFull())
+                return false;
+            out.printf("%s\r\n{\"path\":\"%s\",\"requests\":%u,\"ttfb\":%u,\"ttfb_max\":%u",
+                       cursor.count ? "," : "", g_prj_web_server.getPagePath(cursor.row),
+                       timing.requests, timing.ttfb, timing.ttfb_max);
+            out.printf(",\"render\":%u,\"render_max\":%u,\"size\":%u",
+                       timing.render, timing.render_max, timing.size);
+            out.printf(",\"heap\":%u,\"heap_max\":%u,\"fragmentation\":%u,\"fragmentation_max\":%u,\"blocking_writes\":%u}",
+                       timing.heap, timing.heap_max, timing.fragmentation, timing.fragmentation_max, timing.blocking_writes);
+            cursor.count++;
+        }
+        break;
 
-void page_MeasValue(WiFiClient &wifi_client)
-{
-    // get page size
-    uint32_t send_size = 0;
-    send_size += sendPage_MeasValue(NULL);
-    // send HTTP header with size information
-    wifi_client.print(getHTTPTypeSizeHeader("application/json", send_size));
-    // send page
-    sendPage_MeasValue(&wifi_client);
+    default:
+        out.print(F("]}"));
+        return true;
+    }
+    cursor.row = 0;
+    cursor.count = 0;
+    cursor.step++;
+    return false;
 }
 
-uint32_t sendPage_Unknown(WiFiClient *client)
+bool sendPage_Unknown(ResponseWriter &out, pageCursor_t &)
 {
-    uint32_t send_size = 0;
     // build page content
-    String answer;
-    answer = F("<html>"
+    out.print(F("<html>"
                "<head>"
                "<title>404 Not Found</title>"
                "</head>"
@@ -528,60 +1157,27 @@ uint32_t sendPage_Unknown(WiFiClient *client)
                "<h1>Not Found</h1>"
                "<p>The requested URL was not found on this server.</p>"
                "</body>"
-               "</html>");
-    // .. and get the size
-    send_size += answer.length();
-    // Send the response to the client if required
-    if (client)
-    {
-        client->print(answer);
-    }
-    return send_size;
-}
-
-void page_Unknown(WiFiClient &wifi_client)
-{
-    // get page size
-    uint32_t send_size = 0;
-    send_size += sendPage_Unknown(NULL);
-    // send HTTP header with size information
-    wifi_client.print(getHTTPTypeSizeHeader("text/html", send_size));
-    // send page
-    sendPage_Unknown(&wifi_client);
+               "</html>"));
+    return true;
 }
 
-uint32_t sendPage_Restart(WiFiClient *client)
+bool sendPage_Restart(ResponseWriter &out, pageCursor_t &)
 {
-    uint32_t send_size = 0;
     // build page content
-    String answer;
-    answer = F("<html>"
+    out.print(F("<html>"
                "<head>"
                "<title>Temperature Logger Reset</title>"
                "</head>"
                "<body>"
                "<p>Temperature Logger Reset</p>"
                "</body>"
-               "</html>");
-    // .. and get the size
-    send_size += answer.length();
-    // Send the response to the client if required
-    if (client)
-    {
-        client->print(answer);
-    }
-    return send_size;
+               "</html>"));
+    return true;
 }
 
-void page_Restart(WiFiClient &wifi_client)
+void restartLogger(void)
 {
-    // get page size
-    uint32_t send_size = 0;
-    send_size += sendPage_Restart(NULL);
-    // send HTTP header with size information
-    wifi_client.print(getHTTPTypeSizeHeader("text/html", send_size));
-    // send page
-    sendPage_Unknown(&wifi_client);
     delay(250);
+    saveMeasBuffer();
     ESP.reset();
 }
@@ -10,11 +10,12 @@
 
 #include <ESP8266HTTPClient.h>
 
+#include "meas.h"
 #include "signal.hpp"
 #include "webserver.hpp"
 #include "wifiserver.hpp"
 
-static const String REQUEST_GET_START{"GET "};
+static const char REQUEST_GET_START[] = "GET ";
 
 
 
@@ -22,6 +23,10 @@ PrjWebServer::PrjWebServer(WiFiServer *wifi_server)
     : m_wifi_server{wifi_server}
     , m_page_request_counter{0}
 {
+    for (connection_t &connection : m_connections)
+    {
+        connection.state = ConnectionState_t::FREE;
+    }
 }
 
 PrjWebServer::~PrjWebServer()
@@ -30,159 +35,301 @@ PrjWebServer::~PrjWebServer()
 
 void PrjWebServer::processClient(void)
 {
-    // Check if a client has connected
-    WiFiClient wifi_client = m_wifi_server->available();
-    if (!wifi_client)
-    {
-        return;
-    }
-    else
-    {
+    acceptClient();
 
-        // get name of requested page
-        switch (getPageRequest(wifi_client))
+    // the connections share the time budget of a loop pass, the first
+    // connection changes with each pass
+    uint32_t loop_start = micros();
+    bool active = false;
+    m_first_connection = (m_first_connection + 1) % WEB_MAX_CONNECTIONS;
+    for (size_t i = 0; i < WEB_MAX_CONNECTIONS; i++)
+    {
+        connection_t &connection = m_connections[(m_first_connection + i) % WEB_MAX_CONNECTIONS];
+        switch (connection.state)
         {
-        case Request_t::REQUEST_INDEX:
-            webPageActivityLed.ledOn();
-            page_Index(wifi_client);
-            break;
-        case Request_t::REQUEST_INFO:
-            webPageActivityLed.ledOn();
-            page_Info(wifi_client);
-            break;
-        case Request_t::REQUEST_GRAPH:
-            webPageActivityLed.ledOn();
-            page_Graph(wifi_client);
-            break;
-        case Request_t::REQUEST_MEASVAL_JS:
-            webPageActivityLed.ledOn();
-            page_MeasValue(wifi_client);
+        case ConnectionState_t::READ_REQUEST:
+            readRequest(connection);
             break;
-        case Request_t::REQUEST_UNKNOWN:
-            webPageActivityLed.ledOn();
-            page_Unknown(wifi_client);
-            break;
-        case Request_t::REQUEST_RESTART:
-            webPageActivityLed.ledOn();
-            page_Restart(wifi_client);
-            break;
-        case Request_t::NO_REQUEST:
-            webPageActivityLed.ledOn();
-            // no request found
+        case ConnectionState_t::SEND_RESPONSE:
+            sendResponse(connection, loop_start);
             break;
         default:
-            webPageActivityLed.ledOn();
-            // help
-            Serial.println(F("ERROR: unknown page request answer!"));
-        };
+            break;
+        }
+        active |= connection.state != ConnectionState_t::FREE;
+    }
 
-        // and stop the client
-        wifi_client.stop();
+    if (active)
+        webPageActivityLed.ledOn();
+    else
         webPageActivityLed.ledOff();
+}
+
+int PrjWebServer::getRequestedPages(void)
+{
+    return m_page_request_counter;
+}
+
+String PrjWebServer::getParameter(const String &name)
+{
+    if (!m_current || !m_current->parameter)
+    {
+        return String();
     }
+    // parameter list syntax: name1=value1&name2=value2
+    const char *start = m_current->parameter;
+    while (*start)
+    {
+        const char *end = strchr(start, '&');
+        if (!end)
+        {
+            end = start + strlen(start);
+        }
+        const char *equal_sign = (const char *)memchr(start, '=', end - start);
+        if (equal_sign && (size_t)(equal_sign - start) == name.length()
+            && strncmp(start, name.c_str(), name.length()) == 0)
+        {
+            String value;
+            value.concat(equal_sign + 1, end - equal_sign - 1);
+            return value;
+        }
+        start = *end ? end + 1 : end;
+    }
+    return String();
 }
 
-/*
- * This function checks if a page request is received from a external
- * client. If a request is found the page will be returned
- */
-Request_t PrjWebServer::getPageRequest(WiFiClient &wifi_client)
+size_t PrjWebServer::getPageCount(void)
+{
+    return req_pages_size;
+}
+
+const char *PrjWebServer::getPagePath(size_t page)
+{
+    return req_pages[page].req_page;
+}
+
+const pageTiming_t &PrjWebServer::getPageTiming(size_t page)
+{
+    return m_page_timing[page];
+}
+
+uint32_t PrjWebServer::getRefusedClients(void)
+{
+    return m_refused_clients;
+}
+
+uint32_t PrjWebServer::getTimeouts(void)
+{
+    return m_timeouts;
+}
+
+/*****************************************************************************
+ * private methods
+ *****************************************************************************/
+
+void PrjWebServer::acceptClient(void)
 {
     // Check if a client has connected
+    WiFiClient wifi_client = m_wifi_server->available();
     if (!wifi_client)
     {
-        // no request found return immediatly
-        return Request_t::NO_REQUEST;
+        return;
     }
+    for (connection_t &connection : m_connections)
+    {
+        if (connection.state == ConnectionState_t::FREE)
+        {
+            connection.client = wifi_client;
+            connection.length = 0;
+            connection.last_progress = millis();
+            connection.state = ConnectionState_t::READ_REQUEST;
+            return;
+        }
+    }
+    // all connections are used, the client has to try it again
+    m_refused_clients++;
+    wifi_client.stop();
+}
 
-    // Read the first line of the request
-    String request_input = wifi_client.readStringUntil('\r');
-    wifi_client.flush();
+/*
+ * Reads the received part of the request line, the response is started
+ * after the end of the line
+ */
+void PrjWebServer::readRequest(connection_t &connection)
+{
+    while (connection.client.available())
+    {
+        char c = connection.client.read();
+        connection.last_progress = millis();
+        if (c == '\r' || c == '\n' || connection.length >= WEB_REQUEST_SIZE - 1)
+        {
+            // a longer request line is cut, its path is unknown
+            connection.request[connection.length] = '\0';
+            startResponse(connection);
+            return;
+        }
+        connection.request[connection.length++] = c;
+    }
 
-    // stop client, if request is empty
-    if (request_input == "")
+    // stop client, if the request is not complete
+    if (!connection.client.connected() || millis() - connection.last_progress > WEB_REQUEST_TIMEOUT)
     {
-        wifi_client.stop();
-        return Request_t::NO_REQUEST;
+        if (connection.client.connected())
+        {
+            m_timeouts++;
+        }
+        closeConnection(connection);
     }
+}
 
+/*
+ * Evaluates the request line and starts the response of the page
+ */
+void PrjWebServer::startResponse(connection_t &connection)
+{
     Serial.print("page requested");
 
     /* get path; end of path is either space or ?
        Syntax is e.g. GET /?show=1234 HTTP/1.1
-       String sPath="",sParam="", sCmd="";
-       String sGetstart="GET ";
-       int iStart, iEndSpace, iEndQuest;
+       path and parameters are terminated in the request buffer
     */
-    m_request_path.clear();
-    int param_startid;
-    int param_endif;
-    int param_end_query;
-    param_startid = request_input.indexOf(REQUEST_GET_START);
-    if (param_startid >= 0)
+    const char *path = "";
+    connection.parameter = nullptr;
+    if (strncmp(connection.request, REQUEST_GET_START, strlen(REQUEST_GET_START)) == 0)
     {
         Serial.print(" with parameter");
-        param_startid += REQUEST_GET_START.length();
-        param_endif = request_input.indexOf(" ", param_startid);
-        param_end_query = request_input.indexOf("?", param_startid);
-
+        char *start = connection.request + strlen(REQUEST_GET_START);
+        char *end = strchr(start, ' ');
         // are there parameters?
-        if (param_endif > 0)
+        if (end)
         {
-            if (param_end_query > 0)
-            {
-                // there are parameters
-                m_request_path = request_input.substring(param_startid, param_end_query);
-                m_request_parameter = request_input.substring(param_end_query + 1, param_endif);
-
-                if (!m_request_parameter.isEmpty())
-                {
-
-                    //if(sParam.lastIndexOf)
-
-                    // check for:
-                    // - range=[6|12|24|48]
-                    //   = sParam.indexOf("range=",0);
-                    // - calibration=<float>
-                    //   = sParam.indexOf("calibartion=",0);
-                    // - hostname=<name>
-                    //   = sParam.indexOf("hostname=",0);
-                    //
-                    // if(sParam.length) {
-                    //   int equalSign = sParam.indexOf("=", 0);
-                }
-            }
-            else
+            *end = '\0';
+            char *query = strchr(start, '?');
+            if (query)
             {
-                // NO parameters
-                m_request_path = request_input.substring(param_startid, param_endif);
+                // there are parameters, they are evaluated by the pages, see getParameter()
+                *query = '\0';
+                connection.parameter = query + 1;
             }
+            path = start;
         }
     }
 
     m_page_request_counter++;
 
-    // search the requrest page in name in supported list
+    // search the requrest page in name in supported list, the last page is
+    // the unknown page
+    connection.page = req_pages_size - 1;
     for (size_t i = 0; i < req_pages_size; i++)
     {
-        if (m_request_path == req_pages[i].req_page)
+        if (strcmp(path, req_pages[i].req_page) == 0)
         {
-            Serial.printf(" - request for %s\n", req_pages[i].req_page);
-            return req_pages[i].req_id;
+            Serial.printf(" - request for %s", req_pages[i].req_page);
+            connection.page = i;
+            break;
         }
     }
+    Serial.println();
+
+    // a page of an unknown sensor is not found, too
+    m_current = &connection;
+    String serial_code = getParameter("sensor");
+    m_current = nullptr;
+    if (!serial_code.isEmpty() && g_temp_meas.findSensor(serial_code) < 0)
+    {
+        connection.page = req_pages_size - 1;
+    }
 
-    return Request_t::REQUEST_UNKNOWN;
+    connection.request_start = micros();
+    connection.free_heap = ESP.getFreeHeap();
+    connection.complete = false;
+    connection.cursor = pageCursor_t();
+    connection.writer.begin(&connection.client, req_pages[connection.page].content_type,
+                            req_pages[connection.page].req_id != Request_t::REQUEST_UNKNOWN);
+    connection.state = ConnectionState_t::SEND_RESPONSE;
 }
 
-int PrjWebServer::getRequestedPages(void)
+/*
+ * Sends the written step and writes the next one, until the client does not
+ * take more data or the time budget of the loop pass is used
+ */
+void PrjWebServer::sendResponse(connection_t &connection, uint32_t loop_start)
 {
-    return m_page_request_counter;
+    // the rest of the request header is not evaluated
+    uint8_t discard[32];
+    while (connection.client.available())
+    {
+        connection.client.read(discard, sizeof(discard));
+    }
+
+    // at least one step per pass, the others are within the budget
+    do
+    {
+        if (!connection.writer.send())
+        {
+            // the send buffer of the client is full
+            break;
+        }
+        if (connection.complete)
+        {
+            updatePageTiming(connection);
+            bool restart = req_pages[connection.page].req_id == Request_t::REQUEST_RESTART;
+            closeConnection(connection);
+            if (restart)
+            {
+                restartLogger();
+            }
+            return;
+        }
+
+        m_current = &connection;
+        connection.complete = req_pages[connection.page].pageHandler(connection.writer, connection.cursor);
+        m_current = nullptr;
+        if (connection.complete)
+            connection.writer.end();
+        else
+            connection.writer.endStep();
+        connection.last_progress = millis();
+    } while (micros() - loop_start < WEB_LOOP_BUDGET);
+
+    // a step is not taken by the client within the timeout
+    if (!connection.client.connected() || millis() - connection.last_progress > WEB_SEND_TIMEOUT)
+    {
+        if (connection.client.connected())
+        {
+            m_timeouts++;
+        }
+        closeConnection(connection);
+    }
 }
 
-void PrjWebServer::incrementPageRequestCounter(void)
+void PrjWebServer::closeConnection(connection_t &connection)
 {
-    m_page_request_counter++;
+    // an archive day of an aborted page is still open
+    connection.cursor.reader.file.close();
+    connection.client.stop();
+    connection.state = ConnectionState_t::FREE;
+}
+
+void PrjWebServer::updatePageTiming(connection_t &connection)
+{
+    uint32_t render = micros() - connection.request_start;
+    uint32_t first_chunk = connection.writer.getFirstChunkTime();
+    uint32_t min_free_heap = connection.writer.getMinFreeHeap();
+    pageTiming_t &timing = m_page_timing[connection.page];
+    timing.requests++;
+    timing.ttfb = first_chunk ? first_chunk - connection.request_start : render;
+    timing.render = render;
+    timing.size = connection.writer.size();
+    timing.ttfb_max = timing.ttfb > timing.ttfb_max ? timing.ttfb : timing.ttfb_max;
+    timing.render_max = render > timing.render_max ? render : timing.render_max;
+    // the free heap before the request is the reference, a page without
+    // heap allocations keeps it flat
+    timing.heap = connection.free_heap > min_free_heap ? connection.free_heap - min_free_heap : 0;
+    timing.fragmentation = ESP.getHeapFragmentation();
+    timing.heap_max = timing.heap > timing.heap_max ? timing.heap : timing.heap_max;
+    timing.fragmentation_max = timing.fragmentation > timing.fragmentation_max ? timing.fragmentation : timing.fragmentation_max;
+    timing.blocking_writes += connection.writer.getBlockingWrites();
 }
 
 
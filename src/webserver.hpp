@@ -9,27 +9,50 @@
 
 #include <WiFiServer.h>
 
+#include "archive.h"
+#include "responsewriter.h"
+
+// Requested time window of a page, values are local time epochs
+typedef struct
+{
+    time_t from; // oldest requested time, 0: no limit
+    time_t to;   // newest requested time, 0: no limit
+} timeWindow_t;
+
+// state of a page response, the pages are written in steps and continued
+// with the next step after the previous one was sent
+typedef struct
+{
+    uint8_t step;           // step of the page, 0: first step
+    uint8_t tier;           // history tier of the rows, selected by the first step
+    int8_t sensor;          // requested sensor, set by the first step
+    uint16_t row;           // next row of the step
+    uint16_t count;         // amount of written rows of the step
+    timeWindow_t window;    // requested time window, set by the first step
+    uint32_t next;          // number of the next history row, see getFirstValueNumber()
+    time_t first;           // timestamp of the first written row, 0: no row
+    archiveReader_t reader; // opened archive day
+} pageCursor_t;
+
 /*
  * declare here the web pages; 
  * declared outside of the class PrjWebServer, in case of easier handling.
+ * A page writes its next step to the writer and returns true after the last
+ * step.
  */
-uint32_t sendPage_Index(WiFiClient *client);
-void page_Index(WiFiClient &wifi_client);
-
-uint32_t sendPage_Info(WiFiClient *client);
-void page_Info(WiFiClient &wifi_client);
-
-uint32_t sendPage_Graph(WiFiClient *client);
-void page_Graph(WiFiClient &wifi_client);
-
-uint32_t sendPage_MeasValue(WiFiClient *client);
-void page_MeasValue(WiFiClient &wifi_client);
-
-uint32_t sendPage_Unknown(WiFiClient *client);
-void page_Unknown(WiFiClient &wifi_client);
-
-uint32_t sendPage_Restart(WiFiClient *client);
-void page_Restart(WiFiClient &wifi_client);
+bool sendPage_Index(ResponseWriter &out, pageCursor_t &cursor);
+bool sendPage_Info(ResponseWriter &out, pageCursor_t &cursor);
+bool sendPage_Graph(ResponseWriter &out, pageCursor_t &cursor);
+bool sendPage_MeasValue(ResponseWriter &out, pageCursor_t &cursor);
+bool sendPage_Stats(ResponseWriter &out, pageCursor_t &cursor);
+bool sendPage_Archive(ResponseWriter &out, pageCursor_t &cursor);
+bool sendPage_ArchiveIndex(ResponseWriter &out, pageCursor_t &cursor);
+bool sendPage_Health(ResponseWriter &out, pageCursor_t &cursor);
+bool sendPage_Unknown(ResponseWriter &out, pageCursor_t &cursor);
+bool sendPage_Restart(ResponseWriter &out, pageCursor_t &cursor);
+
+/// restarts the logger after the restart page was sent
+void restartLogger(void);
 
 // Request values
 enum class Request_t
@@ -40,9 +63,56 @@ enum class Request_t
     REQUEST_GRAPH,      // handle page graph ("/graph")
     REQUEST_MEASVAL_JS, // get a json list with all measurement values ("/measval.js")
     REQUEST_RESTART,    // restart temperature logger, clears the measurement queue ("/restart")
+    REQUEST_STATS,      // get min/max/avg of a time window as json ("/stats")
+    REQUEST_ARCHIVE,    // get the archived values of a day as json ("/archive")
+    REQUEST_ARCHIVE_INDEX, // get the list of the archived days as json ("/archive/index")
+    REQUEST_HEALTH,     // get the sensor and 1-wire bus health counters as json ("/health")
     REQUEST_UNKNOWN     // request for unknown page
 };
 
+// response times and heap usage of a page, the pages are sent as chunked
+// response while they are rendered
+typedef struct
+{
+    uint32_t requests;      // amount of requests
+    uint32_t ttfb;          // time from the request to the first chunk of the last response [us]
+    uint32_t ttfb_max;      // max. time to the first chunk [us]
+    uint32_t render;        // time to render and send the last response [us]
+    uint32_t render_max;    // max. time to render and send a response [us]
+    uint32_t size;          // size of the last page without HTTP header [byte]
+    uint32_t heap;          // heap used by the last request: free heap before it - lowest free heap [byte]
+    uint32_t heap_max;      // max. heap used by a request [byte]
+    uint8_t fragmentation;  // heap fragmentation after the last request [%]
+    uint8_t fragmentation_max; // max. heap fragmentation after a request [%]
+    uint32_t blocking_writes; // amount of page steps that did not fit into the write buffer
+} pageTiming_t;
+
+// state of a client connection
+enum class ConnectionState_t
+{
+    FREE,           // connection is not used
+    READ_REQUEST,   // request line is received
+    SEND_RESPONSE   // page is written and sent
+};
+
+// client connection, the request is parsed and the response is sent over
+// several calls of processClient()
+typedef struct
+{
+    ConnectionState_t state;
+    WiFiClient client;
+    char request[WEB_REQUEST_SIZE]; // request line, path and parameters are terminated in place
+    uint8_t length;             // length of the received request line
+    const char *parameter;      // parameters of the request, see getParameter()
+    size_t page;                // index of the requested page in req_pages
+    bool complete;              // last step of the page is written
+    uint32_t last_progress;     // millis() of the last received data or sent step
+    uint32_t request_start;     // micros() after the request was read
+    uint32_t free_heap;         // free heap before the response [byte]
+    ResponseWriter writer;      // buffer of the current step
+    pageCursor_t cursor;        // state of the page
+} connection_t;
+
 class PrjWebServer
 {
 private:
@@ -52,53 +122,89 @@ public:
     PrjWebServer(WiFiServer *wifi_server);
     ~PrjWebServer();
 
-    void processClient(void);
-
     /**
-     * @brief Get the Page Request object
-     * 
-     * @param wifi_client 
-     * @return Request_t 
+     * @brief Accepts new clients, reads the requests and sends the next
+     * steps of the responses; a connection is served until the client does
+     * not take more data or WEB_LOOP_BUDGET is used, it is continued with the
+     * next call
      */
-    Request_t getPageRequest(WiFiClient &wifi_client);
+    void processClient(void);
 
     /**
-     * @brief Increment page requoired counter
+     * @brief Get the Page Request Counter object
      * 
+     * @return int 
      */
-    void incrementPageRequestCounter(void);
+    int getRequestedPages(void);
 
     /**
-     * @brief Get the Page Request Counter object
+     * @brief Get the value of a request parameter, e.g. "range" of "/graph?range=24"
      * 
-     * @return int 
+     * @param name name of the parameter
+     * @return String value of the parameter, empty if the parameter is not set
      */
-    int getRequestedPages(void);
+    String getParameter(const String &name);
+
+    /// amount of pages with response times
+    size_t getPageCount(void);
+
+    /// path of a page, "" for the unknown pages
+    const char *getPagePath(size_t page);
+
+    /// response times of a page
+    const pageTiming_t &getPageTiming(size_t page);
+
+    /// amount of clients that were refused, because all connections were used
+    uint32_t getRefusedClients(void);
+
+    /// amount of connections that were closed by a timeout
+    uint32_t getTimeouts(void);
 
 private:
-    String m_request_path = ""; // input request from client
-    String m_request_parameter = "";
     uint32_t m_page_request_counter = 0;
+    uint32_t m_refused_clients = 0;
+    uint32_t m_timeouts = 0;
 
     // Web function pointer for page handling
-    typedef void (*pageHandler_t)(WiFiClient &);
+    typedef bool (*pageHandler_t)(ResponseWriter &, pageCursor_t &);
 
     typedef struct
     {
         Request_t req_id;
         char req_page[32];
+        const char *content_type;
         pageHandler_t pageHandler;
     } req_pages_t;
 
-    const req_pages_t req_pages[6] = {
-        {Request_t::REQUEST_INDEX, "/", &page_Index},
-        {Request_t::REQUEST_INFO, "/info", &page_Info},
-        {Request_t::REQUEST_GRAPH, "/graph", &page_Graph},
-        {Request_t::REQUEST_MEASVAL_JS, "/measval.js", &page_MeasValue},
-        {Request_t::REQUEST_RESTART, "/restart", &page_Restart},
-        {Request_t::REQUEST_UNKNOWN, "", &page_Unknown},
+    const req_pages_t req_pages[10] = {
+        {Request_t::REQUEST_INDEX, "/", "text/html", &sendPage_Index},
+        {Request_t::REQUEST_INFO, "/info", "text/html", &sendPage_Info},
+        {Request_t::REQUEST_GRAPH, "/graph", "text/html", &sendPage_Graph},
+        {Request_t::REQUEST_MEASVAL_JS, "/measval.js", "application/json", &sendPage_MeasValue},
+        {Request_t::REQUEST_RESTART, "/restart", "text/html", &sendPage_Restart},
+        {Request_t::REQUEST_STATS, "/stats", "application/json", &sendPage_Stats},
+        {Request_t::REQUEST_ARCHIVE, "/archive", "application/json", &sendPage_Archive},
+        {Request_t::REQUEST_ARCHIVE_INDEX, "/archive/index", "application/json", &sendPage_ArchiveIndex},
+        {Request_t::REQUEST_HEALTH, "/health", "application/json", &sendPage_Health},
+        {Request_t::REQUEST_UNKNOWN, "", "text/html", &sendPage_Unknown},
     };
     const size_t req_pages_size = sizeof(req_pages) / sizeof(req_pages[0]);
+
+    // response times of the pages, index of req_pages
+    pageTiming_t m_page_timing[sizeof(req_pages) / sizeof(req_pages[0])] = {};
+
+    // client connections, the writers are part of it, no heap is used
+    connection_t m_connections[WEB_MAX_CONNECTIONS];
+    size_t m_first_connection = 0;    // connection that is served first by processClient()
+    // connection of the page that is written, for getParameter()
+    connection_t *m_current = nullptr;
+
+    void acceptClient(void);
+    void readRequest(connection_t &connection);
+    void startResponse(connection_t &connection);
+    void sendResponse(connection_t &connection, uint32_t loop_start);
+    void closeConnection(connection_t &connection);
+    void updatePageTiming(connection_t &connection);
 };
 
 extern PrjWebServer g_prj_web_server;
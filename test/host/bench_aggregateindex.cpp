@@ -0,0 +1,112 @@
+/*
+ * File         test/host/bench_aggregateindex.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Window min/max/sum queries of the AggregateIndex compared
+ *              with a scan of the values, full wrapped 14 days buffer.
+ */
+
+#include <cstdio>
+
+#include "aggregateindex.hpp"
+#include "benchmark.h"
+#include "measbuffer.hpp"
+#include "traces.h"
+
+
+typedef RingBuffer<measValue_t, RINGBUFFER_SIZE> BenchBuffer_t;
+
+static BenchBuffer_t g_bench_buffer(measValue_t{});
+
+static int32_t readSlot(size_t slot)
+{
+    return g_bench_buffer.readSlot(slot).temperature;
+}
+
+static AggregateIndex<AGGREGATE_LEAF_SIZE> g_bench_index(&readSlot);
+
+// window of the offsets [first, last) by the index, split at the buffer end like getMeasStats()
+static aggregate_t queryIndex(size_t first, size_t last)
+{
+    size_t first_slot = g_bench_buffer.slot(first);
+    size_t last_slot = first_slot + (last - first);
+    if (last_slot <= g_bench_buffer.content())
+    {
+        return g_bench_index.query(first_slot, last_slot);
+    }
+    return mergeAggregate(g_bench_index.query(first_slot, g_bench_buffer.content()),
+                          g_bench_index.query(0, last_slot - g_bench_buffer.content()));
+}
+
+// window of the offsets [first, last) by a scan of the values
+static aggregate_t queryScan(size_t first, size_t last)
+{
+    aggregate_t result = {0, 0, 0, 0};
+    BenchBuffer_t::iterator end(&g_bench_buffer, last);
+    for (BenchBuffer_t::iterator it(&g_bench_buffer, first); it != end; ++it)
+    {
+        aggregate_t value = {it->temperature, it->temperature, it->temperature, 1};
+        result = mergeAggregate(result, value);
+    }
+    return result;
+}
+
+static void benchWindow(const char *name, size_t window)
+{
+    TraceRandom random(7);
+    size_t first = 0;
+    auto next = [&]() { first = random.next() % (g_bench_buffer.size() - window + 1); };
+
+    double index_ns = measureNs(20000, [&]() {
+        next();
+        keepValue(queryIndex(first, first + window));
+    });
+    double scan_ns = measureNs(window > 1000 ? 2000 : 20000, [&]() {
+        next();
+        keepValue(queryScan(first, first + window));
+    });
+    char label[64];
+    std::snprintf(label, sizeof(label), "%s, index", name);
+    printResult(label, index_ns, "ns/query");
+    std::snprintf(label, sizeof(label), "%s, scan", name);
+    printResult(label, scan_ns, "ns/query");
+}
+
+int main()
+{
+    g_bench_index.resize(g_bench_buffer.content());
+    std::vector<traceValue_t> values = generateTrace(Trace_t::ROOM, RINGBUFFER_SIZE * 3 / 2, 360);
+    double add_ns = measureNs(1, [&]() {
+        g_bench_buffer.clear();
+        g_bench_index.clear();
+        for (const traceValue_t &value : values)
+        {
+            g_bench_buffer.add(measValue_t{value.timestamp, value.temperature, {}});
+            g_bench_index.update(g_bench_buffer.slot(g_bench_buffer.size() - 1));
+        }
+    }) / values.size();
+
+    // the results of both paths have to be identical
+    TraceRandom random(5);
+    for (int i = 0; i < 1000; i++)
+    {
+        size_t first = random.next() % g_bench_buffer.size();
+        size_t last = first + random.next() % (g_bench_buffer.size() - first + 1);
+        aggregate_t a = queryIndex(first, last);
+        aggregate_t b = queryScan(first, last);
+        if (a.count != b.count || a.sum != b.sum || (a.count && (a.min != b.min || a.max != b.max)))
+        {
+            std::printf("ERROR: index and scan differ at [%u, %u)!\n", (unsigned int)first, (unsigned int)last);
+            return 1;
+        }
+    }
+
+    std::printf("AggregateIndex<%u>, %u values (wrapped), tree %u byte\n", (unsigned int)AGGREGATE_LEAF_SIZE,
+                (unsigned int)g_bench_buffer.size(), (unsigned int)g_bench_index.memorySize());
+    printResult("add + update", add_ns, "ns/value");
+    benchWindow("1 hour (10 values)", 10);
+    benchWindow("1 day (240 values)", 240);
+    benchWindow("7 days (1680 values)", 1680);
+    benchWindow("14 days (3360 values)", RINGBUFFER_SIZE);
+    return 0;
+}
@@ -0,0 +1,66 @@
+/*
+ * File         test/host/bench_compressedringbuffer.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Bytes per sample and decode throughput of the
+ *              CompressedRingBuffer with the temperature traces, compared
+ *              with the uncompressed record of the RingBuffer.
+ */
+
+#include <cstdio>
+
+#include "benchmark.h"
+#include "compressedringbuffer.hpp"
+#include "traces.h"
+
+
+// size of the RAM buffer of the logger, 256 byte blocks (COMPRESSED_BLOCK_SIZE)
+typedef CompressedRingBuffer<traceValue_t, 128, 256> BenchBuffer_t;
+
+static void benchTrace(Trace_t trace, uint32_t interval)
+{
+    static BenchBuffer_t buffer(traceValue_t{0, 0});
+    buffer.clear();
+    // more values than the buffer holds, the oldest blocks are dropped
+    std::vector<traceValue_t> values = generateTrace(trace, 100000, interval);
+    for (const traceValue_t &value : values)
+    {
+        buffer.add(value);
+    }
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "%s, %u sec: bytes per sample", getTraceName(trace), interval);
+    printResult(name, (double)sizeof(BenchBuffer_t) / buffer.size(), "byte");
+    std::snprintf(name, sizeof(name), "%s, %u sec: samples in %u byte", getTraceName(trace), interval,
+                  (unsigned int)sizeof(BenchBuffer_t));
+    printResult(name, buffer.size(), "");
+
+    // sequential decode of the whole buffer
+    size_t offset = 0;
+    double ns = measureNs(buffer.size(), [&]() {
+        keepValue(buffer.readFirst(offset));
+        offset = offset + 1 < buffer.size() ? offset + 1 : 0;
+    });
+    std::snprintf(name, sizeof(name), "%s, %u sec: sequential decode", getTraceName(trace), interval);
+    printResult(name, 1000.0 / ns, "Msamples/s");
+
+    // time lookup, decodes a block up to the element
+    TraceRandom random(3);
+    time_t first = buffer.readFirst(0).timestamp;
+    time_t range = buffer.readLast(0).timestamp - first;
+    ns = measureNs(2000, [&]() { keepValue(buffer.lowerBound(first + random.next() % range)); });
+    std::snprintf(name, sizeof(name), "%s, %u sec: lowerBound", getTraceName(trace), interval);
+    printResult(name, ns, "ns/call");
+}
+
+int main()
+{
+    // measValue_t on the ESP8266: 64 bit time_t, temperature and quality
+    std::printf("CompressedRingBuffer<128 blocks, 256 byte>, uncompressed measValue_t 18 byte\n");
+    for (Trace_t trace : {Trace_t::ROOM, Trace_t::COLD_STORAGE, Trace_t::OUTDOOR})
+    {
+        benchTrace(trace, 360);
+        benchTrace(trace, 15);
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+/*
+ * File         test/host/bench_filter.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         CPU cost of the stages of the sample filter, each stage alone
+ *              and the chain SampleFilter_t of meas.h, with the room trace
+ *              and single sample spikes.
+ */
+
+#include <cstdio>
+
+#include "benchmark.h"
+#include "filter.hpp"
+#include "meas.h"
+#include "traces.h"
+
+
+// samples of the room trace in 1/128 °C, each 50th sample is a spike of +20 °C
+static std::vector<int32_t> makeSamples(void)
+{
+    std::vector<int32_t> samples;
+    for (const traceValue_t &value : generateTrace(Trace_t::ROOM, 100000, 5))
+    {
+        int32_t sample = centiToFixed(value.temperature);
+        samples.push_back(samples.size() % 50 == 49 ? sample + 20 * TEMP_FIXED_SCALE : sample);
+    }
+    return samples;
+}
+
+// time per sample of a filter and the amount of output values 10 °C above the trace
+template <typename _FILTER>
+static void benchFilter(const char *name, const std::vector<int32_t> &samples)
+{
+    _FILTER filter = {};
+    size_t i = 0;
+    double ns = measureNs(samples.size(), [&]() {
+        int32_t value;
+        if (filter.process(samples[i], value))
+        {
+            keepValue(value);
+        }
+        i = i + 1 < samples.size() ? i + 1 : 0;
+    });
+
+    _FILTER check = {};
+    uint32_t spikes = 0;
+    for (size_t s = 0; s < samples.size(); s++)
+    {
+        int32_t value;
+        spikes += check.process(samples[s], value) && value > samples[s - s % 50] + 10 * TEMP_FIXED_SCALE;
+    }
+    char label[64];
+    std::snprintf(label, sizeof(label), "%s: time", name);
+    printResult(label, ns, "ns/sample");
+    std::snprintf(label, sizeof(label), "%s: spikes > 10 °C in the output", name);
+    printResult(label, spikes, "");
+}
+
+int main()
+{
+    std::vector<int32_t> samples = makeSamples();
+    std::printf("filter stages, %u samples of the room trace, %u spikes of +20 °C\n",
+                (unsigned int)samples.size(), (unsigned int)samples.size() / 50);
+    benchFilter<FilterChain<>>("no stage", samples);
+    benchFilter<FilterChain<MedianFilter<FILTER_MEDIAN_WINDOW>>>("median<5>", samples);
+    benchFilter<FilterChain<HampelFilter<FILTER_MEDIAN_WINDOW, FILTER_HAMPEL_K, 32>>>("hampel<5>", samples);
+    benchFilter<FilterChain<MedianFilter<15>>>("median<15>", samples);
+    benchFilter<FilterChain<HampelFilter<15, FILTER_HAMPEL_K, 32>>>("hampel<15>", samples);
+    benchFilter<FilterChain<EmaFilter<FILTER_EMA_ALPHA>>>("ema", samples);
+    benchFilter<FilterChain<DecimateFilter<FILTER_DECIMATE>>>("decimate<64>", samples);
+    benchFilter<SampleFilter_t>("SampleFilter_t", samples);
+    benchFilter<FilterChain<HampelFilter<FILTER_MEDIAN_WINDOW, FILTER_HAMPEL_K, 32>, EmaFilter<FILTER_EMA_ALPHA>,
+                            DecimateFilter<FILTER_DECIMATE>>>("hampel + ema + decimate", samples);
+    return 0;
+}
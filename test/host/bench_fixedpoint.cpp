@@ -0,0 +1,47 @@
+/*
+ * File         test/host/bench_fixedpoint.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Formatting of the stored temperatures: formatTemp() of
+ *              fixedpoint.hpp compared with the float path of the web pages
+ *              before (sprintf("%.1f"), String(float)).
+ */
+
+#include <cstdio>
+
+#include "benchmark.h"
+#include "fixedpoint.hpp"
+#include "traces.h"
+
+
+int main()
+{
+    std::vector<traceValue_t> values = generateTrace(Trace_t::OUTDOOR, 10000, 360);
+    size_t i = 0;
+    auto next = [&]() -> int16_t {
+        i = i + 1 < values.size() ? i + 1 : 0;
+        return values[i].temperature;
+    };
+    char buf[TEMP_FORMAT_SIZE];
+
+    std::printf("temperature formatting, %u values of the outdoor trace\n", (unsigned int)values.size());
+    double fixed1 = measureNs(values.size(), [&]() { keepValue(formatTemp(buf, next(), 1)[0]); });
+    double fixed2 = measureNs(values.size(), [&]() { keepValue(formatTemp(buf, next(), 2)[0]); });
+    double float1 = measureNs(values.size(), [&]() {
+        std::snprintf(buf, sizeof(buf), "%.1f", next() / 100.0f);
+        keepValue(buf[0]);
+    });
+    double float2 = measureNs(values.size(), [&]() {
+        std::snprintf(buf, sizeof(buf), "%.2f", next() / 100.0f);
+        keepValue(buf[0]);
+    });
+    double string1 = measureNs(values.size(), [&]() { keepValue(String(next() / 100.0f, 1)); });
+
+    printResult("formatTemp(1 decimal)", fixed1, "ns/value");
+    printResult("formatTemp(2 decimals)", fixed2, "ns/value");
+    printResult("snprintf(\"%.1f\", float)", float1, "ns/value");
+    printResult("snprintf(\"%.2f\", float)", float2, "ns/value");
+    printResult("String(float, 1)", string1, "ns/value");
+    printResult("speedup formatTemp vs snprintf, 1 decimal", float1 / fixed1, "x");
+    return 0;
+}
@@ -0,0 +1,84 @@
+/*
+ * File         test/host/bench_ringbuffer.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Iteration of the full measurement buffer: indexed access by
+ *              readFirst(), iterators and the two contiguous spans.
+ */
+
+#include <algorithm>
+#include <cstdio>
+
+#include "benchmark.h"
+#include "measbuffer.hpp"
+
+
+typedef RingBuffer<measValue_t, RINGBUFFER_MAX_SIZE, OverflowOverwrite, HeapStorage> BenchBuffer_t;
+
+// sum of the temperatures by readFirst(), the loop of the page renderers
+static int32_t sumIndexed(BenchBuffer_t &buffer)
+{
+    int32_t sum = 0;
+    for (size_t i = 0; i < buffer.size(); i++)
+    {
+        sum += buffer.readFirst(i).temperature;
+    }
+    return sum;
+}
+
+static int32_t sumIterator(BenchBuffer_t &buffer)
+{
+    int32_t sum = 0;
+    for (const measValue_t &value : buffer)
+    {
+        sum += value.temperature;
+    }
+    return sum;
+}
+
+static int32_t sumSpans(BenchBuffer_t &buffer)
+{
+    int32_t sum = 0;
+    for (BenchBuffer_t::span_t span : {buffer.firstSpan(), buffer.secondSpan()})
+    {
+        for (size_t i = 0; i < span.size; i++)
+        {
+            sum += span.data[i].temperature;
+        }
+    }
+    return sum;
+}
+
+int main()
+{
+    static BenchBuffer_t buffer(measValue_t{});
+    buffer.resize(RINGBUFFER_MAX_SIZE);
+    // full buffer, the head is in the middle: two spans
+    for (size_t i = 0; i < RINGBUFFER_MAX_SIZE * 3 / 2; i++)
+    {
+        buffer.add(measValue_t{(time_t)(1600000000 + i * 360), (int16_t)(2000 + i % 100), {}});
+    }
+    if (sumIndexed(buffer) != sumSpans(buffer) || sumIterator(buffer) != sumSpans(buffer))
+    {
+        std::printf("ERROR: the sums differ!\n");
+        return 1;
+    }
+
+    std::printf("RingBuffer<measValue_t, HeapStorage>, full with %u values of %u byte\n",
+                (unsigned int)buffer.size(), (unsigned int)sizeof(measValue_t));
+    double indexed = measureNs(200, [&]() { keepValue(sumIndexed(buffer)); }) / buffer.size();
+    double iterator = measureNs(200, [&]() { keepValue(sumIterator(buffer)); }) / buffer.size();
+    double spans = measureNs(200, [&]() { keepValue(sumSpans(buffer)); }) / buffer.size();
+    printResult("readFirst(i)", indexed, "ns/value");
+    printResult("range-for iterator", iterator, "ns/value");
+    printResult("firstSpan + secondSpan", spans, "ns/value");
+    printResult("speedup spans vs readFirst", indexed / spans, "x");
+
+    // time lookup of the web pages
+    double lookup = measureNs(10000, [&]() {
+        keepValue(std::lower_bound(buffer.begin(), buffer.end(), (time_t)1600600000,
+                                   [](const measValue_t &value, time_t time) { return value.timestamp < time; }));
+    });
+    printResult("std::lower_bound by timestamp", lookup, "ns/call");
+    return 0;
+}
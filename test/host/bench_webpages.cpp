@@ -0,0 +1,83 @@
+/*
+ * File         test/host/bench_webpages.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Time to first byte and total time of each web page with a
+ *              full 14 days measurement buffer, one client at a time.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "hostcontrol.h"
+#include "measbuffer.hpp"
+#include "traces.h"
+#include "webserver.hpp"
+#include "WiFiClient.h"
+
+
+static const char *const PAGES[] = {"/", "/info", "/graph", "/measval.js", "/stats?range=24",
+                                    "/archive/index", "/health", "/unknown"};
+static const int RUNS = 21;
+
+typedef struct
+{
+    uint64_t ttfb;      // connect until the first response byte [us]
+    uint64_t total;     // connect until the close by the server [us]
+    size_t size;        // response size [byte]
+} pageResult_t;
+
+// requests a page and runs the server until the response is complete
+static pageResult_t requestPage(const char *page)
+{
+    char request[64];
+    std::snprintf(request, sizeof(request), "GET %s HTTP/1.1\r\n\r\n", page);
+    // the network takes all data, only the CPU time of the server is measured
+    std::shared_ptr<HostConnection> connection = hostConnect(request, 1 << 20);
+    for (int pass = 0; pass < 10000 && connection->server_open; pass++)
+    {
+        g_prj_web_server.processClient();
+    }
+    return pageResult_t{connection->first_byte_time - connection->connect_time,
+                        connection->close_time - connection->connect_time, connection->response.size()};
+}
+
+static uint64_t median(std::vector<uint64_t> values)
+{
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+int main()
+{
+    hostSetFsRoot(".host_build/fs_bench_webpages", true);
+    hostSetSerialOutput(false);
+    initMeasBuffer();
+    restoreMeasBuffer();
+    for (const traceValue_t &value : generateTrace(Trace_t::ROOM, RINGBUFFER_SIZE, 360))
+    {
+        storeMeasValue(measValue_t{value.timestamp, value.temperature, {}});
+    }
+
+    std::printf("web pages, %u stored values, median of %d requests\n", (unsigned int)RINGBUFFER_SIZE, RUNS);
+    std::printf("  %-20s %10s %10s %10s\n", "page", "TTFB [us]", "total [us]", "size [B]");
+    hostSetRealTime(true);
+    for (const char *page : PAGES)
+    {
+        std::vector<uint64_t> ttfb;
+        std::vector<uint64_t> total;
+        size_t size = 0;
+        for (int run = 0; run < RUNS; run++)
+        {
+            pageResult_t result = requestPage(page);
+            ttfb.push_back(result.ttfb);
+            total.push_back(result.total);
+            size = result.size;
+        }
+        std::printf("  %-20s %10u %10u %10u\n", page, (unsigned int)median(ttfb), (unsigned int)median(total),
+                    (unsigned int)size);
+    }
+    hostSetRealTime(false);
+    return 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * File         test/host/bench_webserver_load.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Load test of the web server: concurrent clients request the
+ *              pages in a loop, the network takes the data at a given rate.
+ *              Reports throughput, latency of the fast clients, responses
+ *              of the slow clients and the longest loop pass.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "hostcontrol.h"
+#include "measbuffer.hpp"
+#include "traces.h"
+#include "webserver.hpp"
+#include "WiFiClient.h"
+
+
+static const char *const REQUESTS[] = {"GET / HTTP/1.1\r\n\r\n", "GET /measval.js HTTP/1.1\r\n\r\n",
+                                       "GET /info HTTP/1.1\r\n\r\n", "GET /graph HTTP/1.1\r\n\r\n",
+                                       "GET /stats?range=24 HTTP/1.1\r\n\r\n", "GET /health HTTP/1.1\r\n\r\n"};
+static const size_t REQUEST_COUNT = sizeof(REQUESTS) / sizeof(REQUESTS[0]);
+// receive window of a client, 2 TCP segments
+static const double CLIENT_WINDOW = 2 * 1460;
+// duration of a run [us]
+static const uint64_t RUN_TIME = 2000000;
+// wait time of a refused client until the next try [us]
+static const uint64_t RETRY_TIME = 10000;
+// network rates [byte/us]: WiFi client 1 MB/s, a phone with bad reception 20 kB/s
+static const double FAST = 1.0;
+static const double SLOW = 0.02;
+
+typedef struct
+{
+    double rate;                                // bytes per us the network takes
+    double window;                              // bytes the network takes now
+    size_t request;                             // index of the next request
+    uint64_t start;                             // hostMicros() of the first try of the request
+    uint64_t retry;                             // hostMicros() of the next try, 0: no wait
+    std::shared_ptr<HostConnection> connection; // connection of the current try
+} loadClient_t;
+
+typedef struct
+{
+    uint32_t requests;      // amount of complete responses
+    uint32_t slow_requests; // amount of complete responses of the slow clients
+    uint32_t refused;       // amount of tries refused by the server
+    uint64_t max_pass;      // longest processClient() call [us]
+    std::vector<uint64_t> latency; // first try until the close of the responses of the fast clients [us]
+} loadResult_t;
+
+static void connectClient(loadClient_t &client)
+{
+    client.connection = hostConnect(REQUESTS[client.request], (size_t)client.window);
+    client.retry = 0;
+}
+
+// clients with the given rates request the pages in a loop for RUN_TIME
+static loadResult_t runLoad(const std::vector<double> &rates)
+{
+    loadResult_t result = {0, 0, 0, 0, {}};
+    std::vector<loadClient_t> clients;
+    uint64_t now = hostMicros();
+    for (double rate : rates)
+    {
+        clients.push_back(loadClient_t{rate, CLIENT_WINDOW, clients.size() % REQUEST_COUNT, now, 0, nullptr});
+        connectClient(clients.back());
+    }
+
+    uint64_t end = now + RUN_TIME;
+    uint64_t last = now;
+    while ((now = hostMicros()) < end)
+    {
+        for (loadClient_t &client : clients)
+        {
+            client.window = std::min(CLIENT_WINDOW, client.window + client.rate * (now - last));
+            if (client.retry)
+            {
+                if (now >= client.retry)
+                {
+                    connectClient(client);
+                }
+                continue;
+            }
+            client.connection->window = (size_t)client.window;
+            if (client.connection->server_open)
+            {
+                continue;
+            }
+            if (client.connection->response.empty())
+            {
+                result.refused++;
+                client.retry = now + RETRY_TIME;
+                continue;
+            }
+            result.requests++;
+            if (client.rate < FAST)
+            {
+                result.slow_requests++;
+            }
+            else
+            {
+                result.latency.push_back(client.connection->close_time - client.start);
+            }
+            client.request = (client.request + 1) % REQUEST_COUNT;
+            client.start = now;
+            connectClient(client);
+        }
+        last = now;
+
+        uint64_t pass_start = hostMicros();
+        g_prj_web_server.processClient();
+        result.max_pass = std::max(result.max_pass, hostMicros() - pass_start);
+        for (loadClient_t &client : clients)
+        {
+            // the data written in the pass is sent
+            if (!client.retry && client.connection->server_open)
+            {
+                client.window = (double)client.connection->window;
+            }
+        }
+    }
+
+    // the open connections are aborted by their clients
+    for (loadClient_t &client : clients)
+    {
+        if (client.connection)
+        {
+            client.connection->client_open = false;
+        }
+    }
+    for (int pass = 0; pass < 10; pass++)
+    {
+        g_prj_web_server.processClient();
+    }
+    return result;
+}
+
+static void printLoad(const char *name, const std::vector<double> &rates)
+{
+    loadResult_t result = runLoad(rates);
+    std::sort(result.latency.begin(), result.latency.end());
+    uint64_t p50 = result.latency.empty() ? 0 : result.latency[result.latency.size() / 2];
+    uint64_t p99 = result.latency.empty() ? 0 : result.latency[result.latency.size() * 99 / 100];
+    std::printf("  %-18s %8.1f %10.2f %10.2f %6u %8u %10.2f\n", name, result.requests * 1e6 / RUN_TIME, p50 / 1000.0,
+                p99 / 1000.0, (unsigned int)result.slow_requests, (unsigned int)result.refused,
+                result.max_pass / 1000.0);
+}
+
+int main()
+{
+    hostSetFsRoot(".host_build/fs_bench_webserver_load", true);
+    hostSetSerialOutput(false);
+    initMeasBuffer();
+    restoreMeasBuffer();
+    for (const traceValue_t &value : generateTrace(Trace_t::ROOM, RINGBUFFER_SIZE, 360))
+    {
+        storeMeasValue(measValue_t{value.timestamp, value.temperature, {}});
+    }
+
+    std::printf("web server load, %u connections, %u requests in a loop per client, %.1f s per run\n",
+                (unsigned int)WEB_MAX_CONNECTIONS, (unsigned int)REQUEST_COUNT, RUN_TIME / 1e6);
+    std::printf("  %-18s %8s %10s %10s %6s %8s %10s\n", "clients", "req/s", "p50 [ms]", "p99 [ms]", "slow",
+                "refused", "pass [ms]");
+    hostSetRealTime(true);
+    printLoad("1 fast", {FAST});
+    printLoad("2 fast", {FAST, FAST});
+    printLoad("3 fast", {FAST, FAST, FAST});
+    printLoad("5 fast", {FAST, FAST, FAST, FAST, FAST});
+    printLoad("8 fast", std::vector<double>(8, FAST));
+    printLoad("1 slow", {SLOW});
+    printLoad("1 slow + 2 fast", {SLOW, FAST, FAST});
+    printLoad("2 slow + 3 fast", {SLOW, SLOW, FAST, FAST, FAST});
+    hostSetRealTime(false);
+    return 0;
+}
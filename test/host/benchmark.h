@@ -0,0 +1,59 @@
+/*
+ * File         test/host/benchmark.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Time measurement of the host benchmarks. The host is much
+ *              faster than the ESP8266 (80 MHz, no FPU), only the ratios of
+ *              the results are meaningful.
+ *
+ *    Usage:    double ns = measureNs(1000, [&]() { buffer.readFirst(i++); });
+ *              printResult("readFirst", ns, "ns/call");
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+
+/// keeps a result alive, the compiler must not remove the measured code
+template <typename _T>
+inline void keepValue(const _T &value)
+{
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+/**
+ * @brief Calls a function repeatedly and returns the time per call, the
+ * best of 5 runs is used
+ *
+ * @param calls amount of calls per run
+ * @param function measured function
+ * @return double time per call [ns]
+ */
+template <typename _FUNCTION>
+double measureNs(size_t calls, _FUNCTION function)
+{
+    double best = 0.0;
+    for (int run = 0; run < 5; run++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < calls; i++)
+        {
+            function();
+        }
+        std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+        double ns = duration.count() / calls;
+        if (!run || ns < best)
+        {
+            best = ns;
+        }
+    }
+    return best;
+}
+
+/// prints a benchmark result line
+inline void printResult(const char *name, double value, const char *unit)
+{
+    std::printf("  %-44s %12.2f %s\n", name, value, unit);
+}
@@ -0,0 +1,135 @@
+/*
+ * File         test/host/pipeline.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Runs the measurement pipeline of the logger on the host like
+ *              setup() and loop() of main.cpp: trace source, timer driven
+ *              sampling, averages, store windows, measurement buffer, flash
+ *              log, archive and RTC snapshot. The simulated time runs as
+ *              fast as the PC computes, a Ticker runs at its simulated time.
+ *
+ *    Usage:    hostSetFsRoot(".host_build/fs_sim", true);
+ *              writeCsvTrace(MEAS_TRACE_FILE, generateTrace(Trace_t::ROOM, 10000, 15));
+ *              beginPipeline(1600000000);
+ *              runPipeline(14 * 86400);
+ *              saveMeasBuffer();
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <TimeLib.h>
+#include <vector>
+
+#include "measbuffer.hpp"
+#include "meas.h"
+#include "parameter.hpp"
+#include "sampler.h"
+#include "timehelper.h"
+#include "traces.h"
+
+
+// parameter list of the host, see shim/hostparameter.cpp
+extern ParameterList_t g_host_parameter;
+
+// counters of the pipeline since beginPipeline()
+typedef struct
+{
+    uint32_t loops;         // amount of loop() passes
+    uint32_t samples;       // amount of samples added to the averages
+    uint32_t stored;        // amount of store windows of sensor 0
+} pipelineStats_t;
+
+static pipelineStats_t g_pipeline_stats;
+// simulated time of the next store window [us]
+static uint64_t g_pipeline_next_store;
+
+
+/**
+ * @brief Writes a trace as CSV file to LittleFS, sensor n gets the values
+ * of the trace plus n * 0.5 °C
+ *
+ * @param path file name on LittleFS
+ * @param values trace values, one record per conversion
+ * @param sensors amount of sensors per record
+ * @return true the file was written
+ */
+inline bool writeCsvTrace(const char *path, const std::vector<traceValue_t> &values, uint8_t sensors = 1)
+{
+    File file = LittleFS.open(path, "w");
+    if (!file)
+    {
+        return false;
+    }
+    file.print("# time,temperatures [°C]\n");
+    for (const traceValue_t &value : values)
+    {
+        String line = String((long long)value.timestamp);
+        for (uint8_t sensor = 0; sensor < sensors; sensor++)
+        {
+            line += ",";
+            line += String(value.temperature / 100.0 + sensor * 0.5, 4);
+        }
+        line += "\n";
+        file.print(line);
+    }
+    file.close();
+    return true;
+}
+
+/**
+ * @brief Starts the pipeline like setup(): enumerates the sensors, sizes and
+ * restores the measurement buffer and starts the sampling
+ *
+ * @param start UTC time of the start
+ */
+inline void beginPipeline(time_t start)
+{
+    g_pipeline_stats = {0, 0, 0};
+    setTime(start);
+    g_temp_meas.begin();
+    initMeasBuffer();
+    restoreMeasBuffer();
+
+    g_timer_values.store_interval = MEASURMENT_DOMAIN * 1000;
+    g_timer_values.meas_interval = TIME_MEASUREMENT_DISTANCE * 1000;
+    g_timer_values.start_timestamp = now();
+    // the first value is stored after some scans, like in setup(); an empty
+    // buffer stores the first processed sample
+    g_timer_values.next_store_temp = millis() + 35000;
+    g_pipeline_next_store = hostMicros() + 35000 * 1000ULL;
+
+    g_sampler.begin(g_temp_meas.getMeasInterval());
+}
+
+/**
+ * @brief Runs loop() passes for a simulated time: read ahead of the source,
+ * samples of the Sampler, store windows; the store time is counted in 64
+ * bit, a run can be longer than the 49 days of millis()
+ *
+ * @param seconds simulated time [sec]
+ * @param loop_interval simulated time between two loop() passes [ms]
+ */
+inline void runPipeline(uint32_t seconds, uint32_t loop_interval = 250)
+{
+    uint64_t end = hostMicros() + seconds * 1000000ULL;
+    while (hostMicros() < end)
+    {
+        // the Tickers run between the loop() passes
+        hostAdvance(loop_interval);
+        g_timer_values.now = millis();
+        g_pipeline_stats.loops++;
+
+        g_temp_meas.readAhead();
+        g_pipeline_stats.samples += g_sampler.process();
+
+        if (hostMicros() >= g_pipeline_next_store || isFirstMeasWindow())
+        {
+            g_pipeline_next_store = hostMicros() + g_timer_values.store_interval * 1000ULL;
+            g_timer_values.next_store_temp = g_timer_values.now + g_timer_values.store_interval;
+            storeMeasWindow(now());
+            g_pipeline_stats.stored++;
+        }
+    }
+}
@@ -0,0 +1,208 @@
+/*
+ * File         test/host/shim/Arduino.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the Arduino core of the ESP8266.
+ */
+
+#include <cstdarg>
+
+#include "Arduino.h"
+#include "user_interface.h"
+
+
+HardwareSerial Serial;
+EspClass ESP;
+
+// simulated ESP8266
+static size_t g_max_free_block = 40 * 1024;
+static rst_info g_reset_info = {REASON_DEFAULT_RST, 0, 0, 0, 0, 0, 0};
+static uint32_t g_rtc_memory[128];
+static bool g_serial_output = true;
+
+
+uint32_t millis(void)
+{
+    return (uint32_t)(hostMicros() / 1000);
+}
+
+uint32_t micros(void)
+{
+    return (uint32_t)hostMicros();
+}
+
+void delay(unsigned long ms)
+{
+    hostAdvance(ms);
+}
+
+void yield(void) {}
+
+void hostSetMaxFreeBlock(size_t size)
+{
+    g_max_free_block = size;
+}
+
+void hostSetResetReason(uint32_t reason)
+{
+    g_reset_info.reason = reason;
+}
+
+void hostSetSerialOutput(bool enable)
+{
+    g_serial_output = enable;
+}
+
+/*****************************************************************************
+ * HardwareSerial
+ *****************************************************************************/
+
+int HardwareSerial::available(void)
+{
+    return 0;
+}
+
+int HardwareSerial::read(void)
+{
+    return -1;
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    if (g_serial_output)
+    {
+        std::putchar(c);
+    }
+    return 1;
+}
+
+size_t HardwareSerial::print(const String &value)
+{
+    return print(value.c_str());
+}
+
+size_t HardwareSerial::print(const char *value)
+{
+    if (g_serial_output)
+    {
+        std::fputs(value, stdout);
+    }
+    return std::strlen(value);
+}
+
+size_t HardwareSerial::print(char value)
+{
+    return write((uint8_t)value);
+}
+
+size_t HardwareSerial::print(int value)
+{
+    return print(String(value));
+}
+
+size_t HardwareSerial::print(unsigned int value)
+{
+    return print(String(value));
+}
+
+size_t HardwareSerial::print(long value)
+{
+    return print(String(value));
+}
+
+size_t HardwareSerial::print(unsigned long value)
+{
+    return print(String(value));
+}
+
+size_t HardwareSerial::print(double value, int decimals)
+{
+    return print(String(value, (unsigned char)decimals));
+}
+
+size_t HardwareSerial::println(void)
+{
+    return print("\r\n");
+}
+
+size_t HardwareSerial::printf(const char *format, ...)
+{
+    char buffer[512];
+    va_list args;
+    va_start(args, format);
+    int length = std::vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    print(buffer);
+    return length > 0 ? (size_t)length : 0;
+}
+
+/*****************************************************************************
+ * EspClass
+ *****************************************************************************/
+
+uint32_t EspClass::getFreeHeap(void)
+{
+    return g_max_free_block + g_max_free_block / 8;
+}
+
+uint32_t EspClass::getMaxFreeBlockSize(void)
+{
+    return g_max_free_block;
+}
+
+uint8_t EspClass::getHeapFragmentation(void)
+{
+    return 11;
+}
+
+uint32_t EspClass::getChipId(void)
+{
+    return 0x00c0ffee;
+}
+
+bool EspClass::rtcUserMemoryRead(uint32_t offset, uint32_t *data, size_t size)
+{
+    if (offset * 4 + size > sizeof(g_rtc_memory))
+    {
+        return false;
+    }
+    std::memcpy(data, &g_rtc_memory[offset], size);
+    return true;
+}
+
+bool EspClass::rtcUserMemoryWrite(uint32_t offset, uint32_t *data, size_t size)
+{
+    if (offset * 4 + size > sizeof(g_rtc_memory))
+    {
+        return false;
+    }
+    std::memcpy(&g_rtc_memory[offset], data, size);
+    return true;
+}
+
+rst_info *EspClass::getResetInfoPtr(void)
+{
+    return &g_reset_info;
+}
+
+uint32_t system_get_free_heap_size(void)
+{
+    return ESP.getFreeHeap();
+}
+
+String EspClass::getResetReason(void)
+{
+    return g_reset_info.reason == REASON_SOFT_RESTART ? "Software/System restart" : "Power On";
+}
+
+void EspClass::restart(void)
+{
+    std::printf("ESP.restart()\n");
+    std::exit(0);
+}
+
+void EspClass::reset(void)
+{
+    std::printf("ESP.reset()\n");
+    std::exit(0);
+}
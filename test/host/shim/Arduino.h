@@ -0,0 +1,139 @@
+/*
+ * File         test/host/shim/Arduino.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the Arduino core of the ESP8266, the logger
+ *              sources are compiled for the PC without changes.
+ *              millis()/micros() return a simulated time that is advanced
+ *              by delay() or hostAdvance(), the Tickers run at their
+ *              simulated times (see hostcontrol.h).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "WString.h"
+#include "hostcontrol.h"
+#include "user_interface.h"
+
+
+typedef int8_t int8;
+typedef uint8_t uint8;
+typedef int16_t int16;
+typedef uint16_t uint16;
+typedef int32_t int32;
+typedef uint32_t uint32;
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define PROGMEM
+#define PGM_P const char *
+#define PSTR(s) (s)
+#define F(s) ((const __FlashStringHelper *)(s))
+#define FPSTR(p) ((const __FlashStringHelper *)(p))
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define strlen_P strlen
+#define strcmp_P strcmp
+#define strncmp_P strncmp
+#define memcpy_P memcpy
+#define strcpy_P strcpy
+#define strncpy_P strncpy
+#define sprintf_P sprintf
+#define snprintf_P snprintf
+#define vsnprintf_P vsnprintf
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+using std::isnan;
+using std::max;
+using std::min;
+
+constexpr uint8_t HIGH = 1;
+constexpr uint8_t LOW = 0;
+constexpr uint8_t INPUT = 0;
+constexpr uint8_t OUTPUT = 1;
+
+// NodeMCU pins
+constexpr uint8_t D0 = 16;
+constexpr uint8_t D1 = 5;
+constexpr uint8_t D2 = 4;
+constexpr uint8_t D3 = 0;
+constexpr uint8_t D4 = 2;
+constexpr uint8_t D5 = 14;
+constexpr uint8_t D6 = 12;
+constexpr uint8_t D7 = 13;
+constexpr uint8_t D8 = 15;
+
+/// simulated time since start [ms], wraps after 49 days like on the ESP8266
+uint32_t millis(void);
+
+/// simulated time since start [us]
+uint32_t micros(void);
+
+/// advances the simulated time, the due Tickers run
+void delay(unsigned long ms);
+
+void yield(void);
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t)
+{
+    return LOW;
+}
+
+
+class HardwareSerial
+{
+public:
+    void begin(unsigned long) {}
+    int available(void);
+    int read(void);
+    void flush(void) {}
+    size_t write(uint8_t c);
+    size_t print(const String &value);
+    size_t print(const char *value);
+    size_t print(char value);
+    size_t print(int value);
+    size_t print(unsigned int value);
+    size_t print(long value);
+    size_t print(unsigned long value);
+    size_t print(double value, int decimals = 2);
+    size_t println(void);
+    template <typename _T>
+    size_t println(const _T &value)
+    {
+        return print(value) + println();
+    }
+    size_t printf(const char *format, ...);
+};
+
+extern HardwareSerial Serial;
+
+
+class EspClass
+{
+public:
+    uint32_t getFreeHeap(void);
+    uint32_t getMaxFreeBlockSize(void);
+    uint8_t getHeapFragmentation(void);
+    uint32_t getChipId(void);
+    bool rtcUserMemoryRead(uint32_t offset, uint32_t *data, size_t size);
+    bool rtcUserMemoryWrite(uint32_t offset, uint32_t *data, size_t size);
+    struct rst_info *getResetInfoPtr(void);
+    String getResetReason(void);
+    [[noreturn]] void restart(void);
+    [[noreturn]] void reset(void);
+};
+
+extern EspClass ESP;
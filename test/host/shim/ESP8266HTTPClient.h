@@ -0,0 +1,11 @@
+/*
+ * File         test/host/shim/ESP8266HTTPClient.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the HTTP client header of the ESP8266 core,
+ *              the logger includes it without using the client.
+ */
+
+#pragma once
+
+#include "ESP8266WiFi.h"
@@ -0,0 +1,62 @@
+/*
+ * File         test/host/shim/ESP8266WiFi.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the WiFi API of the ESP8266 core, the types
+ *              used by the logger headers and a connected station.
+ */
+
+#pragma once
+
+#include "Arduino.h"
+#include "WiFiClient.h"
+#include "WiFiServer.h"
+
+
+class IPAddress
+{
+private:
+    uint8_t m_address[4];
+
+public:
+    IPAddress() : m_address{0, 0, 0, 0} {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : m_address{a, b, c, d} {}
+
+    String toString(void) const
+    {
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", m_address[0], m_address[1], m_address[2], m_address[3]);
+        return String(buffer);
+    }
+};
+
+enum wl_status_t
+{
+    WL_IDLE_STATUS = 0,
+    WL_CONNECTED = 3,
+    WL_DISCONNECTED = 6
+};
+
+// station of the simulated ESP8266, always connected
+class ESP8266WiFiClass
+{
+public:
+    wl_status_t status(void)
+    {
+        return WL_CONNECTED;
+    }
+    String hostname(void)
+    {
+        return String("templogger");
+    }
+    IPAddress localIP(void)
+    {
+        return IPAddress(192, 168, 1, 50);
+    }
+    String macAddress(void)
+    {
+        return String("5C:CF:7F:00:00:01");
+    }
+};
+
+extern ESP8266WiFiClass WiFi;
@@ -0,0 +1,402 @@
+/*
+ * File         test/host/shim/FS.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the file system API of the ESP8266 core.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <unistd.h>
+
+#include "FS.h"
+#include "LittleFS.h"
+
+
+namespace stdfs = std::filesystem;
+
+fs::FS LittleFS;
+
+// directory of the LittleFS files on the PC
+static stdfs::path g_fs_root = stdfs::temp_directory_path() / "esp8266_littlefs";
+// size of the file system of eagle.flash.4m2m.ld
+static size_t g_fs_size = 0x1FA000;
+// amount of data the file writes take, see hostSetFsWriteLimit()
+static size_t g_fs_write_limit = SIZE_MAX;
+// LittleFS block size of the ESP8266 core, each file uses at least one block
+static const size_t FS_BLOCK_SIZE = 8192;
+
+
+void hostSetFsRoot(const char *path, bool clear)
+{
+    g_fs_root = path;
+    std::error_code error;
+    if (clear)
+    {
+        stdfs::remove_all(g_fs_root, error);
+    }
+    stdfs::create_directories(g_fs_root, error);
+}
+
+void hostSetFsSize(size_t size)
+{
+    g_fs_size = size;
+}
+
+void hostSetFsWriteLimit(size_t bytes)
+{
+    g_fs_write_limit = bytes;
+}
+
+// path on the PC of a LittleFS path
+static stdfs::path hostPath(const char *path)
+{
+    while (*path == '/')
+    {
+        path++;
+    }
+    return g_fs_root / path;
+}
+
+namespace fs
+{
+
+// opened file
+class FileImpl
+{
+public:
+    std::FILE *m_file;
+    std::string m_name;     // file name without directory
+
+    FileImpl(std::FILE *file, const std::string &name) : m_file{file}, m_name{name} {}
+
+    ~FileImpl()
+    {
+        if (m_file)
+        {
+            std::fclose(m_file);
+        }
+    }
+};
+
+/*****************************************************************************
+ * File
+ *****************************************************************************/
+
+File::operator bool() const
+{
+    return m_impl && m_impl->m_file;
+}
+
+size_t File::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t File::write(const uint8_t *buffer, size_t size)
+{
+    if (!*this)
+    {
+        return 0;
+    }
+    // a full file system takes a part of the data
+    size_t written = std::fwrite(buffer, 1, std::min(size, g_fs_write_limit), m_impl->m_file);
+    g_fs_write_limit -= g_fs_write_limit == SIZE_MAX ? 0 : written;
+    return written;
+}
+
+size_t File::print(const String &value)
+{
+    return write((const uint8_t *)value.c_str(), value.length());
+}
+
+int File::available(void)
+{
+    return *this ? (int)(size() - position()) : 0;
+}
+
+int File::read(void)
+{
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int File::peek(void)
+{
+    int c = read();
+    if (c >= 0)
+    {
+        std::fseek(m_impl->m_file, -1, SEEK_CUR);
+    }
+    return c;
+}
+
+size_t File::read(uint8_t *buffer, size_t size)
+{
+    if (!*this)
+    {
+        return 0;
+    }
+    // a read after a write needs a positioning call
+    std::fseek(m_impl->m_file, 0, SEEK_CUR);
+    return std::fread(buffer, 1, size, m_impl->m_file);
+}
+
+void File::flush(void)
+{
+    if (*this)
+    {
+        std::fflush(m_impl->m_file);
+    }
+}
+
+bool File::seek(uint32_t pos, SeekMode mode)
+{
+    if (!*this)
+    {
+        return false;
+    }
+    int whence = mode == SeekSet ? SEEK_SET : mode == SeekCur ? SEEK_CUR : SEEK_END;
+    long offset = mode == SeekEnd ? -(long)pos : (long)pos;
+    // like LittleFS, a position behind the end is not possible
+    long target = mode == SeekSet ? offset : mode == SeekCur ? (long)position() + offset : (long)size() + offset;
+    if (target < 0 || target > (long)size())
+    {
+        return false;
+    }
+    return std::fseek(m_impl->m_file, offset, whence) == 0;
+}
+
+size_t File::position(void) const
+{
+    return *this ? (size_t)std::ftell(m_impl->m_file) : 0;
+}
+
+size_t File::size(void) const
+{
+    if (!*this)
+    {
+        return 0;
+    }
+    long pos = std::ftell(m_impl->m_file);
+    std::fseek(m_impl->m_file, 0, SEEK_END);
+    long size = std::ftell(m_impl->m_file);
+    std::fseek(m_impl->m_file, pos, SEEK_SET);
+    return (size_t)size;
+}
+
+bool File::truncate(uint32_t size)
+{
+    if (!*this)
+    {
+        return false;
+    }
+    std::fflush(m_impl->m_file);
+    return ftruncate(fileno(m_impl->m_file), size) == 0;
+}
+
+void File::close(void)
+{
+    m_impl.reset();
+}
+
+const char *File::name(void) const
+{
+    return m_impl ? m_impl->m_name.c_str() : "";
+}
+
+bool File::isFile(void) const
+{
+    return (bool)*this;
+}
+
+bool File::isDirectory(void) const
+{
+    return false;
+}
+
+String File::readString(void)
+{
+    std::string value;
+    int c;
+    while ((c = read()) >= 0)
+    {
+        value += (char)c;
+    }
+    return String(value);
+}
+
+String File::readStringUntil(char terminator)
+{
+    std::string value;
+    int c;
+    while ((c = read()) >= 0 && c != terminator)
+    {
+        value += (char)c;
+    }
+    return String(value);
+}
+
+/*****************************************************************************
+ * Dir
+ *****************************************************************************/
+
+bool Dir::next(void)
+{
+    if (m_next >= m_names.size())
+    {
+        return false;
+    }
+    m_next++;
+    return true;
+}
+
+String Dir::fileName(void)
+{
+    return m_next ? String(m_names[m_next - 1]) : String();
+}
+
+size_t Dir::fileSize(void)
+{
+    std::error_code error;
+    size_t size = isFile() ? stdfs::file_size(hostPath((m_path + "/" + m_names[m_next - 1]).c_str()), error) : 0;
+    return error ? 0 : size;
+}
+
+bool Dir::isFile(void)
+{
+    return m_next && stdfs::is_regular_file(hostPath((m_path + "/" + m_names[m_next - 1]).c_str()));
+}
+
+bool Dir::isDirectory(void)
+{
+    return m_next && stdfs::is_directory(hostPath((m_path + "/" + m_names[m_next - 1]).c_str()));
+}
+
+File Dir::openFile(const char *mode)
+{
+    return m_next ? LittleFS.open((m_path + "/" + m_names[m_next - 1]).c_str(), mode) : File();
+}
+
+bool Dir::rewind(void)
+{
+    m_next = 0;
+    return true;
+}
+
+/*****************************************************************************
+ * FS
+ *****************************************************************************/
+
+bool FS::begin(void)
+{
+    std::error_code error;
+    stdfs::create_directories(g_fs_root, error);
+    return !error;
+}
+
+void FS::end(void) {}
+
+bool FS::format(void)
+{
+    hostSetFsRoot(g_fs_root.c_str(), true);
+    return true;
+}
+
+bool FS::info(FSInfo &info)
+{
+    // each file and directory uses whole blocks
+    size_t used = 2 * FS_BLOCK_SIZE;
+    std::error_code error;
+    for (const stdfs::directory_entry &entry : stdfs::recursive_directory_iterator(g_fs_root, error))
+    {
+        size_t size = entry.is_regular_file() ? entry.file_size() : 0;
+        used += std::max<size_t>(1, (size + FS_BLOCK_SIZE - 1) / FS_BLOCK_SIZE) * FS_BLOCK_SIZE;
+    }
+    info.totalBytes = g_fs_size;
+    info.usedBytes = std::min(used, g_fs_size);
+    info.blockSize = FS_BLOCK_SIZE;
+    info.pageSize = 256;
+    info.maxOpenFiles = 5;
+    info.maxPathLength = 32;
+    return true;
+}
+
+File FS::open(const char *path, const char *mode)
+{
+    stdfs::path file_path = hostPath(path);
+    std::string file_mode = mode;
+    if (file_mode[0] != 'r')
+    {
+        // like LittleFS, the missing directories of a new file are created
+        std::error_code error;
+        stdfs::create_directories(file_path.parent_path(), error);
+    }
+    if (stdfs::is_directory(file_path))
+    {
+        return File();
+    }
+    file_mode += "b";
+    std::FILE *file = std::fopen(file_path.c_str(), file_mode.c_str());
+    if (!file)
+    {
+        return File();
+    }
+    return File(std::make_shared<FileImpl>(file, file_path.filename().string()));
+}
+
+bool FS::exists(const char *path)
+{
+    return stdfs::exists(hostPath(path));
+}
+
+Dir FS::openDir(const char *path)
+{
+    std::vector<std::string> names;
+    std::error_code error;
+    for (const stdfs::directory_entry &entry : stdfs::directory_iterator(hostPath(path), error))
+    {
+        names.push_back(entry.path().filename().string());
+    }
+    // LittleFS returns the entries sorted by name
+    std::sort(names.begin(), names.end());
+    std::string dir_path = path;
+    while (!dir_path.empty() && dir_path.back() == '/')
+    {
+        dir_path.pop_back();
+    }
+    return Dir(dir_path, names);
+}
+
+bool FS::remove(const char *path)
+{
+    std::error_code error;
+    return stdfs::is_regular_file(hostPath(path)) && stdfs::remove(hostPath(path), error);
+}
+
+bool FS::rename(const char *from, const char *to)
+{
+    std::error_code error;
+    if (!stdfs::exists(hostPath(from)))
+    {
+        return false;
+    }
+    stdfs::rename(hostPath(from), hostPath(to), error);
+    return !error;
+}
+
+bool FS::mkdir(const char *path)
+{
+    std::error_code error;
+    stdfs::create_directories(hostPath(path), error);
+    return !error;
+}
+
+bool FS::rmdir(const char *path)
+{
+    std::error_code error;
+    return stdfs::remove(hostPath(path), error);
+}
+
+} // namespace fs
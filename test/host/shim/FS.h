@@ -0,0 +1,143 @@
+/*
+ * File         test/host/shim/FS.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the file system API of the ESP8266 core, the
+ *              files are stored in a directory of the PC (see hostSetFsRoot()).
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Arduino.h"
+
+
+namespace fs
+{
+
+enum SeekMode
+{
+    SeekSet = 0,
+    SeekCur = 1,
+    SeekEnd = 2
+};
+
+struct FSInfo
+{
+    size_t totalBytes;
+    size_t usedBytes;
+    size_t blockSize;
+    size_t pageSize;
+    size_t maxOpenFiles;
+    size_t maxPathLength;
+};
+
+class FileImpl;
+
+class File
+{
+private:
+    std::shared_ptr<FileImpl> m_impl;
+
+public:
+    File() {}
+    File(std::shared_ptr<FileImpl> impl) : m_impl{impl} {}
+
+    explicit operator bool() const;
+    size_t write(uint8_t c);
+    size_t write(const uint8_t *buffer, size_t size);
+    size_t print(const String &value);
+    int available(void);
+    int read(void);
+    int peek(void);
+    size_t read(uint8_t *buffer, size_t size);
+    void flush(void);
+    bool seek(uint32_t pos, SeekMode mode = SeekSet);
+    size_t position(void) const;
+    size_t size(void) const;
+    bool truncate(uint32_t size);
+    void close(void);
+    const char *name(void) const;
+    bool isFile(void) const;
+    bool isDirectory(void) const;
+    String readString(void);
+    String readStringUntil(char terminator);
+};
+
+class Dir
+{
+private:
+    std::string m_path;                 // path of the directory on LittleFS
+    std::vector<std::string> m_names;   // entries of the directory
+    size_t m_next;                      // index of the next entry, 0: before the first entry
+
+public:
+    Dir() : m_next{0} {}
+    Dir(const std::string &path, const std::vector<std::string> &names) : m_path{path}, m_names{names}, m_next{0} {}
+
+    bool next(void);
+    String fileName(void);
+    size_t fileSize(void);
+    bool isFile(void);
+    bool isDirectory(void);
+    File openFile(const char *mode);
+    bool rewind(void);
+};
+
+class FS
+{
+public:
+    bool begin(void);
+    void end(void);
+    bool format(void);
+    bool info(FSInfo &info);
+    File open(const char *path, const char *mode);
+    File open(const String &path, const char *mode)
+    {
+        return open(path.c_str(), mode);
+    }
+    bool exists(const char *path);
+    bool exists(const String &path)
+    {
+        return exists(path.c_str());
+    }
+    Dir openDir(const char *path);
+    Dir openDir(const String &path)
+    {
+        return openDir(path.c_str());
+    }
+    bool remove(const char *path);
+    bool remove(const String &path)
+    {
+        return remove(path.c_str());
+    }
+    bool rename(const char *from, const char *to);
+    bool rename(const String &from, const String &to)
+    {
+        return rename(from.c_str(), to.c_str());
+    }
+    bool mkdir(const char *path);
+    bool mkdir(const String &path)
+    {
+        return mkdir(path.c_str());
+    }
+    bool rmdir(const char *path);
+    bool rmdir(const String &path)
+    {
+        return rmdir(path.c_str());
+    }
+};
+
+} // namespace fs
+
+using fs::Dir;
+using fs::File;
+using fs::FS;
+using fs::FSInfo;
+using fs::SeekCur;
+using fs::SeekEnd;
+using fs::SeekMode;
+using fs::SeekSet;
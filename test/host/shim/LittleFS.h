@@ -0,0 +1,13 @@
+/*
+ * File         test/host/shim/LittleFS.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of LittleFS, see FS.h.
+ */
+
+#pragma once
+
+#include "FS.h"
+
+
+extern fs::FS LittleFS;
@@ -0,0 +1,115 @@
+/*
+ * File         test/host/shim/Ticker.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the Ticker and the simulated time.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "Ticker.h"
+#include "hostcontrol.h"
+
+
+// simulated time since start [us]
+static uint64_t g_host_micros = 0;
+
+// delay of the callbacks behind their due time [us], see hostSetTickerLatency()
+static uint32_t g_ticker_latency = 0;
+
+// all Tickers, a function static is constructed before the global Tickers
+static std::vector<Ticker *> &tickers(void)
+{
+    static std::vector<Ticker *> list;
+    return list;
+}
+
+Ticker::Ticker() : m_due{0}, m_period{0}, m_repeat{false}, m_active{false}
+{
+    tickers().push_back(this);
+}
+
+Ticker::~Ticker()
+{
+    std::vector<Ticker *> &list = tickers();
+    list.erase(std::remove(list.begin(), list.end(), this), list.end());
+}
+
+void Ticker::detach(void)
+{
+    m_active = false;
+}
+
+void Ticker::arm(uint32_t ms, bool repeat, std::function<void(void)> callback)
+{
+    m_callback = callback;
+    m_period = ms * 1000ULL;
+    m_due = g_host_micros + m_period;
+    m_repeat = repeat;
+    m_active = true;
+}
+
+// the simulated time follows the PC time, see hostSetRealTime()
+static bool g_real_time = false;
+static std::chrono::steady_clock::time_point g_real_last;
+
+uint64_t hostMicros(void)
+{
+    if (g_real_time)
+    {
+        // whole microseconds are added, the rest is kept for the next call
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        uint64_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - g_real_last).count();
+        g_real_last += std::chrono::microseconds(elapsed);
+        g_host_micros += elapsed;
+    }
+    return g_host_micros;
+}
+
+void hostSetRealTime(bool enable)
+{
+    hostMicros();
+    g_real_time = enable;
+    g_real_last = std::chrono::steady_clock::now();
+}
+
+void hostSetTickerLatency(uint32_t us)
+{
+    g_ticker_latency = us;
+}
+
+void hostAdvance(uint32_t ms)
+{
+    uint64_t end = g_host_micros + ms * 1000ULL;
+    for (;;)
+    {
+        // the earliest due Ticker, Tickers with the same time run in the order of their construction
+        Ticker *next = nullptr;
+        for (Ticker *ticker : tickers())
+        {
+            if (ticker->m_active && ticker->m_due <= end && (!next || ticker->m_due < next->m_due))
+            {
+                next = ticker;
+            }
+        }
+        if (!next)
+        {
+            break;
+        }
+        g_host_micros = std::max(g_host_micros, next->m_due + g_ticker_latency);
+        if (next->m_repeat)
+        {
+            next->m_due += next->m_period ? next->m_period : 1000;
+        }
+        else
+        {
+            next->m_active = false;
+        }
+        // the callback may attach the Ticker again
+        std::function<void(void)> callback = next->m_callback;
+        callback();
+    }
+    g_host_micros = std::max(g_host_micros, end);
+}
@@ -0,0 +1,74 @@
+/*
+ * File         test/host/shim/Ticker.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the Ticker of the ESP8266 core, the callbacks
+ *              run in hostAdvance() at their simulated times.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+
+class Ticker
+{
+private:
+    std::function<void(void)> m_callback;
+    uint64_t m_due;             // simulated time of the next call [us]
+    uint64_t m_period;          // time between the calls [us]
+    bool m_repeat;              // false: the ticker is detached after the call
+    bool m_active;              // the ticker is attached
+
+    void arm(uint32_t ms, bool repeat, std::function<void(void)> callback);
+
+    friend void hostAdvance(uint32_t ms);
+
+public:
+    typedef void (*callback_t)(void);
+
+    Ticker();
+    ~Ticker();
+    Ticker(const Ticker &) = delete;
+    Ticker &operator=(const Ticker &) = delete;
+
+    void attach_ms(uint32_t ms, callback_t callback)
+    {
+        arm(ms, true, callback);
+    }
+
+    template <typename _TArg>
+    void attach_ms(uint32_t ms, void (*callback)(_TArg), _TArg arg)
+    {
+        arm(ms, true, [callback, arg]() { callback(arg); });
+    }
+
+    void once_ms(uint32_t ms, callback_t callback)
+    {
+        arm(ms, false, callback);
+    }
+
+    template <typename _TArg>
+    void once_ms(uint32_t ms, void (*callback)(_TArg), _TArg arg)
+    {
+        arm(ms, false, [callback, arg]() { callback(arg); });
+    }
+
+    void attach(float seconds, callback_t callback)
+    {
+        attach_ms((uint32_t)(seconds * 1000), callback);
+    }
+
+    void once(float seconds, callback_t callback)
+    {
+        once_ms((uint32_t)(seconds * 1000), callback);
+    }
+
+    void detach(void);
+
+    bool active(void) const
+    {
+        return m_active;
+    }
+};
@@ -0,0 +1,110 @@
+/*
+ * File         test/host/shim/TimeLib.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the Time library by Paul Stoffregen.
+ */
+
+#include "TimeLib.h"
+#include "hostcontrol.h"
+
+
+static time_t g_time_base = 0;          // time of setTime()
+static uint64_t g_time_set_micros = 0;  // simulated time of setTime() [us]
+static timeStatus_t g_time_status = timeNotSet;
+
+
+time_t now(void)
+{
+    return g_time_base + (time_t)((hostMicros() - g_time_set_micros) / 1000000);
+}
+
+void setTime(time_t t)
+{
+    g_time_base = t;
+    g_time_set_micros = hostMicros();
+    g_time_status = timeSet;
+}
+
+timeStatus_t timeStatus(void)
+{
+    return g_time_status;
+}
+
+void setSyncProvider(getExternalTime) {}
+
+void setSyncInterval(time_t) {}
+
+time_t makeTime(const tmElements_t &tm)
+{
+    struct tm ts = {};
+    ts.tm_sec = tm.Second;
+    ts.tm_min = tm.Minute;
+    ts.tm_hour = tm.Hour;
+    ts.tm_mday = tm.Day;
+    ts.tm_mon = tm.Month - 1;
+    ts.tm_year = tm.Year + 70;
+    return timegm(&ts);
+}
+
+void breakTime(time_t time, tmElements_t &tm)
+{
+    struct tm ts;
+    gmtime_r(&time, &ts);
+    tm.Second = ts.tm_sec;
+    tm.Minute = ts.tm_min;
+    tm.Hour = ts.tm_hour;
+    tm.Wday = ts.tm_wday + 1;
+    tm.Day = ts.tm_mday;
+    tm.Month = ts.tm_mon + 1;
+    tm.Year = ts.tm_year - 70;
+}
+
+int second(time_t t)
+{
+    tmElements_t tm;
+    breakTime(t, tm);
+    return tm.Second;
+}
+
+int minute(time_t t)
+{
+    tmElements_t tm;
+    breakTime(t, tm);
+    return tm.Minute;
+}
+
+int hour(time_t t)
+{
+    tmElements_t tm;
+    breakTime(t, tm);
+    return tm.Hour;
+}
+
+int day(time_t t)
+{
+    tmElements_t tm;
+    breakTime(t, tm);
+    return tm.Day;
+}
+
+int weekday(time_t t)
+{
+    tmElements_t tm;
+    breakTime(t, tm);
+    return tm.Wday;
+}
+
+int month(time_t t)
+{
+    tmElements_t tm;
+    breakTime(t, tm);
+    return tm.Month;
+}
+
+int year(time_t t)
+{
+    tmElements_t tm;
+    breakTime(t, tm);
+    return tmYearToCalendar(tm.Year);
+}
@@ -0,0 +1,92 @@
+/*
+ * File         test/host/shim/TimeLib.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the Time library by Paul Stoffregen, now()
+ *              follows the simulated time of millis().
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+
+
+typedef enum
+{
+    timeNotSet,
+    timeNeedsSync,
+    timeSet
+} timeStatus_t;
+
+typedef struct
+{
+    uint8_t Second;
+    uint8_t Minute;
+    uint8_t Hour;
+    uint8_t Wday;   // day of week, sunday is day 1
+    uint8_t Day;
+    uint8_t Month;
+    uint8_t Year;   // offset from 1970
+} tmElements_t;
+
+typedef time_t (*getExternalTime)(void);
+
+#define SECS_PER_MIN ((time_t)(60UL))
+#define SECS_PER_HOUR ((time_t)(3600UL))
+#define SECS_PER_DAY ((time_t)(SECS_PER_HOUR * 24UL))
+#define SECS_PER_WEEK ((time_t)(SECS_PER_DAY * 7UL))
+#define CalendarYrToTm(Y) ((Y) - 1970)
+#define tmYearToCalendar(Y) ((Y) + 1970)
+
+time_t now(void);
+void setTime(time_t t);
+timeStatus_t timeStatus(void);
+void setSyncProvider(getExternalTime provider);
+void setSyncInterval(time_t interval);
+
+time_t makeTime(const tmElements_t &tm);
+void breakTime(time_t time, tmElements_t &tm);
+
+int second(time_t t);
+int minute(time_t t);
+int hour(time_t t);
+int day(time_t t);
+int weekday(time_t t);
+int month(time_t t);
+int year(time_t t);
+
+inline int second(void)
+{
+    return second(now());
+}
+
+inline int minute(void)
+{
+    return minute(now());
+}
+
+inline int hour(void)
+{
+    return hour(now());
+}
+
+inline int day(void)
+{
+    return day(now());
+}
+
+inline int weekday(void)
+{
+    return weekday(now());
+}
+
+inline int month(void)
+{
+    return month(now());
+}
+
+inline int year(void)
+{
+    return year(now());
+}
@@ -0,0 +1,282 @@
+/*
+ * File         test/host/shim/WString.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the Arduino String, based on std::string.
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+
+#include "WString.h"
+
+
+// digits of an unsigned value in a base 2..36
+static std::string formatUnsigned(unsigned long long value, unsigned char base)
+{
+    if (base < 2 || base > 36)
+    {
+        base = 10;
+    }
+    std::string digits;
+    do
+    {
+        unsigned int digit = value % base;
+        digits.insert(digits.begin(), (char)(digit < 10 ? '0' + digit : 'a' + digit - 10));
+        value /= base;
+    } while (value);
+    return digits;
+}
+
+static std::string formatSigned(long long value, unsigned char base)
+{
+    if (value < 0 && base == 10)
+    {
+        return "-" + formatUnsigned(0ULL - (unsigned long long)value, base);
+    }
+    // like the Arduino core, other bases show the two's complement
+    return formatUnsigned((unsigned long long)value, base);
+}
+
+static std::string formatFloat(double value, unsigned char decimals)
+{
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+    return buffer;
+}
+
+String::String(unsigned char value, unsigned char base) : m_value{formatUnsigned(value, base)} {}
+String::String(int value, unsigned char base)
+    : m_value{base == 10 ? formatSigned(value, base) : formatUnsigned((unsigned int)value, base)}
+{
+}
+String::String(unsigned int value, unsigned char base) : m_value{formatUnsigned(value, base)} {}
+String::String(long value, unsigned char base) : m_value{formatSigned(value, base)} {}
+String::String(unsigned long value, unsigned char base) : m_value{formatUnsigned(value, base)} {}
+String::String(long long value, unsigned char base) : m_value{formatSigned(value, base)} {}
+String::String(unsigned long long value, unsigned char base) : m_value{formatUnsigned(value, base)} {}
+String::String(float value, unsigned char decimals) : m_value{formatFloat(value, decimals)} {}
+String::String(double value, unsigned char decimals) : m_value{formatFloat(value, decimals)} {}
+
+bool String::reserve(unsigned int size)
+{
+    m_value.reserve(size);
+    return true;
+}
+
+bool String::concat(const String &value)
+{
+    m_value += value.m_value;
+    return true;
+}
+
+bool String::concat(const char *value)
+{
+    m_value += value ? value : "";
+    return true;
+}
+
+bool String::concat(const char *value, unsigned int length)
+{
+    if (value)
+    {
+        m_value.append(value, length);
+    }
+    return true;
+}
+
+bool String::concat(char value)
+{
+    m_value += value;
+    return true;
+}
+
+String &String::operator+=(const String &value)
+{
+    concat(value);
+    return *this;
+}
+
+String &String::operator+=(const char *value)
+{
+    concat(value);
+    return *this;
+}
+
+String &String::operator+=(char value)
+{
+    concat(value);
+    return *this;
+}
+
+String &String::operator+=(int value)
+{
+    return *this += String(value);
+}
+
+String &String::operator+=(unsigned int value)
+{
+    return *this += String(value);
+}
+
+String &String::operator+=(long value)
+{
+    return *this += String(value);
+}
+
+String &String::operator+=(unsigned long value)
+{
+    return *this += String(value);
+}
+
+String &String::operator+=(float value)
+{
+    return *this += String(value);
+}
+
+String &String::operator+=(double value)
+{
+    return *this += String(value);
+}
+
+bool String::equalsIgnoreCase(const String &value) const
+{
+    return m_value.size() == value.m_value.size()
+           && std::equal(m_value.begin(), m_value.end(), value.m_value.begin(), [](char a, char b) {
+                  return std::tolower((unsigned char)a) == std::tolower((unsigned char)b);
+              });
+}
+
+bool String::startsWith(const String &prefix) const
+{
+    return m_value.compare(0, prefix.m_value.size(), prefix.m_value) == 0;
+}
+
+bool String::endsWith(const String &suffix) const
+{
+    return m_value.size() >= suffix.m_value.size()
+           && m_value.compare(m_value.size() - suffix.m_value.size(), suffix.m_value.size(), suffix.m_value) == 0;
+}
+
+int String::indexOf(char value, unsigned int from) const
+{
+    size_t pos = m_value.find(value, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::indexOf(const String &value, unsigned int from) const
+{
+    size_t pos = m_value.find(value.m_value, from);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(char value) const
+{
+    size_t pos = m_value.rfind(value);
+    return pos == std::string::npos ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int from) const
+{
+    return substring(from, m_value.size());
+}
+
+String String::substring(unsigned int from, unsigned int to) const
+{
+    if (from > to)
+    {
+        std::swap(from, to);
+    }
+    if (from >= m_value.size())
+    {
+        return String();
+    }
+    return String(m_value.substr(from, std::min<size_t>(to, m_value.size()) - from));
+}
+
+void String::replace(char find, char replace)
+{
+    std::replace(m_value.begin(), m_value.end(), find, replace);
+}
+
+void String::replace(const String &find, const String &replace)
+{
+    if (find.isEmpty())
+    {
+        return;
+    }
+    size_t pos = 0;
+    while ((pos = m_value.find(find.m_value, pos)) != std::string::npos)
+    {
+        m_value.replace(pos, find.m_value.size(), replace.m_value);
+        pos += replace.m_value.size();
+    }
+}
+
+void String::remove(unsigned int index)
+{
+    if (index < m_value.size())
+    {
+        m_value.erase(index);
+    }
+}
+
+void String::remove(unsigned int index, unsigned int count)
+{
+    if (index < m_value.size())
+    {
+        m_value.erase(index, count);
+    }
+}
+
+void String::trim(void)
+{
+    size_t first = m_value.find_first_not_of(" \t\r\n\f\v");
+    size_t last = m_value.find_last_not_of(" \t\r\n\f\v");
+    m_value = first == std::string::npos ? std::string() : m_value.substr(first, last - first + 1);
+}
+
+void String::toLowerCase(void)
+{
+    for (char &c : m_value)
+    {
+        c = (char)std::tolower((unsigned char)c);
+    }
+}
+
+void String::toUpperCase(void)
+{
+    for (char &c : m_value)
+    {
+        c = (char)std::toupper((unsigned char)c);
+    }
+}
+
+String operator+(const String &left, const String &right)
+{
+    String result(left);
+    result += right;
+    return result;
+}
+
+String operator+(const String &left, const char *right)
+{
+    String result(left);
+    result += right;
+    return result;
+}
+
+String operator+(const char *left, const String &right)
+{
+    String result(left);
+    result += right;
+    return result;
+}
+
+String operator+(const String &left, char right)
+{
+    String result(left);
+    result += right;
+    return result;
+}
@@ -0,0 +1,95 @@
+/*
+ * File         test/host/shim/WString.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the Arduino String, based on std::string.
+ */
+
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+
+class __FlashStringHelper;
+
+
+class String
+{
+private:
+    std::string m_value;
+
+public:
+    String(const char *value = "") : m_value{value ? value : ""} {}
+    String(const __FlashStringHelper *value) : String((const char *)value) {}
+    String(const std::string &value) : m_value{value} {}
+    explicit String(char value) : m_value(1, value) {}
+    explicit String(unsigned char value, unsigned char base = 10);
+    explicit String(int value, unsigned char base = 10);
+    explicit String(unsigned int value, unsigned char base = 10);
+    explicit String(long value, unsigned char base = 10);
+    explicit String(unsigned long value, unsigned char base = 10);
+    explicit String(long long value, unsigned char base = 10);
+    explicit String(unsigned long long value, unsigned char base = 10);
+    explicit String(float value, unsigned char decimals = 2);
+    explicit String(double value, unsigned char decimals = 2);
+
+    const char *c_str(void) const { return m_value.c_str(); }
+    unsigned int length(void) const { return m_value.length(); }
+    bool isEmpty(void) const { return m_value.empty(); }
+    void clear(void) { m_value.clear(); }
+    bool reserve(unsigned int size);
+    char charAt(unsigned int index) const { return index < m_value.length() ? m_value[index] : 0; }
+    char operator[](unsigned int index) const { return charAt(index); }
+    char &operator[](unsigned int index) { return m_value[index]; }
+
+    bool concat(const String &value);
+    bool concat(const char *value);
+    bool concat(const char *value, unsigned int length);
+    bool concat(char value);
+    String &operator+=(const String &value);
+    String &operator+=(const char *value);
+    String &operator+=(char value);
+    String &operator+=(int value);
+    String &operator+=(unsigned int value);
+    String &operator+=(long value);
+    String &operator+=(unsigned long value);
+    String &operator+=(float value);
+    String &operator+=(double value);
+
+    bool equals(const String &value) const { return m_value == value.m_value; }
+    bool equalsIgnoreCase(const String &value) const;
+    bool operator==(const String &value) const { return m_value == value.m_value; }
+    bool operator==(const char *value) const { return m_value == (value ? value : ""); }
+    bool operator!=(const String &value) const { return m_value != value.m_value; }
+    bool operator!=(const char *value) const { return !(*this == value); }
+    bool operator<(const String &value) const { return m_value < value.m_value; }
+    bool operator>(const String &value) const { return m_value > value.m_value; }
+    int compareTo(const String &value) const { return m_value.compare(value.m_value); }
+    bool startsWith(const String &prefix) const;
+    bool endsWith(const String &suffix) const;
+
+    int indexOf(char value, unsigned int from = 0) const;
+    int indexOf(const String &value, unsigned int from = 0) const;
+    int lastIndexOf(char value) const;
+    String substring(unsigned int from) const;
+    String substring(unsigned int from, unsigned int to) const;
+
+    void replace(char find, char replace);
+    void replace(const String &find, const String &replace);
+    void remove(unsigned int index);
+    void remove(unsigned int index, unsigned int count);
+    void trim(void);
+    void toLowerCase(void);
+    void toUpperCase(void);
+
+    long toInt(void) const { return std::strtol(m_value.c_str(), nullptr, 10); }
+    float toFloat(void) const { return std::strtof(m_value.c_str(), nullptr); }
+    double toDouble(void) const { return std::strtod(m_value.c_str(), nullptr); }
+};
+
+String operator+(const String &left, const String &right);
+String operator+(const String &left, const char *right);
+String operator+(const char *left, const String &right);
+String operator+(const String &left, char right);
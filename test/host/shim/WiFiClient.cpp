@@ -0,0 +1,139 @@
+/*
+ * File         test/host/shim/WiFiClient.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the TCP client and server of the ESP8266 core.
+ */
+
+#include <deque>
+
+#include "ESP8266WiFi.h"
+#include "hostcontrol.h"
+
+
+ESP8266WiFiClass WiFi;
+
+// connections of hostConnect(), not yet accepted by the server
+static std::deque<std::shared_ptr<HostConnection>> g_pending_connections;
+
+
+std::shared_ptr<HostConnection> hostConnect(const char *request, size_t window)
+{
+    std::shared_ptr<HostConnection> connection = std::make_shared<HostConnection>();
+    connection->request = request;
+    connection->window = window;
+    connection->connect_time = hostMicros();
+    g_pending_connections.push_back(connection);
+    return connection;
+}
+
+/*****************************************************************************
+ * WiFiServer
+ *****************************************************************************/
+
+WiFiClient WiFiServer::available(void)
+{
+    if (g_pending_connections.empty())
+    {
+        return WiFiClient();
+    }
+    WiFiClient client(g_pending_connections.front());
+    g_pending_connections.pop_front();
+    return client;
+}
+
+/*****************************************************************************
+ * WiFiClient
+ *****************************************************************************/
+
+uint8_t WiFiClient::connected(void)
+{
+    return m_connection && m_connection->client_open && m_connection->server_open;
+}
+
+int WiFiClient::available(void)
+{
+    return connected() ? (int)(m_connection->request.size() - m_connection->request_pos) : 0;
+}
+
+int WiFiClient::read(void)
+{
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t *buffer, size_t size)
+{
+    size_t length = min(size, (size_t)available());
+    if (length)
+    {
+        m_connection->request.copy((char *)buffer, length, m_connection->request_pos);
+        m_connection->request_pos += length;
+    }
+    return (int)length;
+}
+
+String WiFiClient::readStringUntil(char terminator)
+{
+    // the host has no timeout, the read ends with the available data
+    String result;
+    int c;
+    while ((c = read()) >= 0 && c != terminator)
+    {
+        result += (char)c;
+    }
+    return result;
+}
+
+size_t WiFiClient::availableForWrite(void)
+{
+    return connected() ? m_connection->window : 0;
+}
+
+size_t WiFiClient::write(const uint8_t *buffer, size_t size)
+{
+    // a write larger than the window waits on the ESP8266 until the data is
+    // sent, the host takes all data
+    if (!connected() || !size)
+    {
+        return 0;
+    }
+    if (m_connection->response.empty())
+    {
+        m_connection->first_byte_time = hostMicros();
+    }
+    m_connection->response.append((const char *)buffer, size);
+    m_connection->window -= min(size, m_connection->window);
+    return size;
+}
+
+size_t WiFiClient::print(const char *text)
+{
+    return write((const uint8_t *)text, std::strlen(text));
+}
+
+size_t WiFiClient::print(const __FlashStringHelper *text)
+{
+    return print((const char *)text);
+}
+
+size_t WiFiClient::print(const String &text)
+{
+    return write((const uint8_t *)text.c_str(), text.length());
+}
+
+bool WiFiClient::flush(unsigned int timeout)
+{
+    // the written data is sent at once on the host
+    (void)timeout;
+    return true;
+}
+
+void WiFiClient::stop(void)
+{
+    if (m_connection && m_connection->server_open)
+    {
+        m_connection->server_open = false;
+        m_connection->close_time = hostMicros();
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * File         test/host/shim/WiFiClient.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the TCP client of the ESP8266 core. A client
+ *              is one end of a simulated connection, the other end is held
+ *              by the test (see hostConnect() in hostcontrol.h): the test
+ *              gives the request data and the amount of data the network
+ *              takes, the response is collected in the connection.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "Arduino.h"
+
+
+// simulated TCP connection, shared by the WiFiClient copies and the test
+struct HostConnection
+{
+    std::string request;        // data of the client, not yet read by the server
+    size_t request_pos = 0;     // next byte of the request to read
+    std::string response;       // data written by the server
+    size_t window = 0;          // amount of data the network takes now, see availableForWrite()
+    bool client_open = true;    // the client keeps the connection open
+    bool server_open = true;    // the server did not stop the connection
+    uint64_t connect_time = 0;  // hostMicros() of the connect
+    uint64_t first_byte_time = 0; // hostMicros() of the first response byte
+    uint64_t close_time = 0;    // hostMicros() of the stop by the server
+};
+
+
+class WiFiClient
+{
+private:
+    std::shared_ptr<HostConnection> m_connection;
+
+public:
+    WiFiClient() {}
+    explicit WiFiClient(std::shared_ptr<HostConnection> connection) : m_connection{connection} {}
+
+    explicit operator bool(void) const
+    {
+        return m_connection != nullptr;
+    }
+
+    uint8_t connected(void);
+    int available(void);
+    int read(void);
+    int read(uint8_t *buffer, size_t size);
+    String readStringUntil(char terminator);
+    void setTimeout(unsigned long timeout) { (void)timeout; }
+    size_t availableForWrite(void);
+    size_t write(const uint8_t *buffer, size_t size);
+    size_t print(const char *text);
+    size_t print(const __FlashStringHelper *text);
+    size_t print(const String &text);
+    bool flush(unsigned int timeout = 0);
+    void stop(void);
+};
@@ -0,0 +1,23 @@
+/*
+ * File         test/host/shim/WiFiServer.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the TCP server of the ESP8266 core, the
+ *              connections of hostConnect() are accepted in their order.
+ */
+
+#pragma once
+
+#include "WiFiClient.h"
+
+
+class WiFiServer
+{
+public:
+    explicit WiFiServer(uint16_t) {}
+
+    void begin(void) {}
+
+    /// next connection of hostConnect(), an empty client if there is none
+    WiFiClient available(void);
+};
@@ -0,0 +1,42 @@
+/*
+ * File         test/host/shim/WiFiUdp.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the UDP API of the ESP8266 core, no packet is
+ *              sent or received.
+ */
+
+#pragma once
+
+#include "ESP8266WiFi.h"
+
+
+class WiFiUDP
+{
+public:
+    uint8_t begin(uint16_t)
+    {
+        return 1;
+    }
+    void stop(void) {}
+    int beginPacket(IPAddress, uint16_t)
+    {
+        return 0;
+    }
+    size_t write(const uint8_t *, size_t)
+    {
+        return 0;
+    }
+    int endPacket(void)
+    {
+        return 0;
+    }
+    int parsePacket(void)
+    {
+        return 0;
+    }
+    int read(uint8_t *, size_t)
+    {
+        return 0;
+    }
+};
@@ -0,0 +1,37 @@
+/*
+ * File         test/host/shim/coredecls.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the CRC32 of the ESP8266 core: polynomial
+ *              0x04c11db7, MSB first, no final XOR; a CRC can be continued
+ *              with the result of the last call.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+inline uint32_t crc32(const void *data, size_t length, uint32_t crc = 0xffffffff)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    while (length--)
+    {
+        uint8_t c = *bytes++;
+        for (uint32_t i = 0x80; i > 0; i >>= 1)
+        {
+            bool bit = crc & 0x80000000;
+            if (c & i)
+            {
+                bit = !bit;
+            }
+            crc <<= 1;
+            if (bit)
+            {
+                crc ^= 0x04c11db7;
+            }
+        }
+    }
+    return crc;
+}
@@ -0,0 +1,85 @@
+/*
+ * File         test/host/shim/hostcontrol.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Control of the simulated ESP8266 by the host tests: time,
+ *              heap, reset reason, file system, serial output and the
+ *              connections of the web clients.
+ *
+ *    Usage:    hostSetFsRoot(".host_build/fs_test", true);
+ *              setTime(1600000000);
+ *              g_temp_meas.begin();
+ *              hostAdvance(60000); // one minute, the Tickers run
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+
+/// simulated time since start [us], does not wrap
+uint64_t hostMicros(void);
+
+/**
+ * @brief Advances the simulated time, the due Tickers run at their times
+ * in the order of their deadlines
+ *
+ * @param ms time step [ms]
+ */
+void hostAdvance(uint32_t ms);
+
+/**
+ * @brief Delays the following Ticker callbacks behind their due time, e.g.
+ * by a locked interrupt; the period of a Ticker is not changed
+ *
+ * @param us delay [us], 0: the callbacks run at their due time
+ */
+void hostSetTickerLatency(uint32_t us);
+
+/**
+ * @brief Lets the simulated time follow the time of the PC in addition to
+ * hostAdvance(), micros() measures the CPU time of the code, e.g. the
+ * response times of the web server
+ *
+ * @param enable true: the simulated time runs with the PC time
+ */
+void hostSetRealTime(bool enable);
+
+/// sets the largest free heap block, is used by ESP.getMaxFreeBlockSize()
+void hostSetMaxFreeBlock(size_t size);
+
+/// sets the reset reason of ESP.getResetInfoPtr(), e.g. REASON_SOFT_RESTART
+void hostSetResetReason(uint32_t reason);
+
+/**
+ * @brief Sets the directory that holds the files of LittleFS
+ *
+ * @param path directory, is created if it does not exist
+ * @param clear true: all files of the directory are removed
+ */
+void hostSetFsRoot(const char *path, bool clear);
+
+/// sets the size of the simulated file system [bytes], used by LittleFS.info()
+void hostSetFsSize(size_t size);
+
+/// amount of data the following file writes take [bytes], a full file system; SIZE_MAX: no limit
+void hostSetFsWriteLimit(size_t bytes);
+
+/// false: the output of Serial is discarded
+void hostSetSerialOutput(bool enable);
+
+struct HostConnection;
+
+/**
+ * @brief Connects a web client, the connection is accepted by the next
+ * WiFiServer::available()
+ *
+ * @param request data sent by the client, e.g. "GET /info HTTP/1.1\r\n\r\n"
+ * @param window amount of data the network takes, reduced by each write;
+ *        the test sets HostConnection::window again to simulate the
+ *        acknowledged data
+ * @return std::shared_ptr<HostConnection> state of the connection
+ */
+std::shared_ptr<HostConnection> hostConnect(const char *request, size_t window);
@@ -0,0 +1,83 @@
+/*
+ * File         test/host/shim/hostparameter.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Host version of the parameter list, the values are set by the
+ *              tests in g_host_parameter instead of the EEPROM.
+ */
+
+#include "parameter.hpp"
+#include "parameterlist.h"
+
+
+ParameterList_t g_host_parameter = {
+    PARAMETER_LIST_VERSION, "host", "", "templog-host", "host", 0.0, "", 0.0, 60, "", 0, PARAMETER_BUFFER_SIZE,
+};
+
+
+String getSsidName(void)
+{
+    return g_host_parameter.ssid;
+}
+
+String getPassword(void)
+{
+    return g_host_parameter.password;
+}
+
+String getHostname(void)
+{
+    return g_host_parameter.hostname;
+}
+
+String getLocation(void)
+{
+    return g_host_parameter.location;
+}
+
+float getTempCorrection(void)
+{
+    return g_host_parameter.temp_correction;
+}
+
+float getSensorCorrection(uint8_t sensor)
+{
+    const char *value = sensor ? getListEntry(g_host_parameter.sensor_corrections, sensor - 1) : nullptr;
+    return value ? atof(value) : 0.0;
+}
+
+float getStoreDeadband(void)
+{
+    return g_host_parameter.store_deadband > 0.0 ? g_host_parameter.store_deadband : 0.0;
+}
+
+uint32_t getStoreHeartbeat(void)
+{
+    return (g_host_parameter.store_heartbeat > 0 ? g_host_parameter.store_heartbeat : STORE_HEARTBEAT_DEFAULT) * 60;
+}
+
+bool getSensorAlarm(uint8_t sensor, int8_t &low, int8_t &high)
+{
+    return parseSensorAlarm(g_host_parameter.sensor_alarms, sensor, low, high);
+}
+
+bool isAlarmWatch(void)
+{
+    return g_host_parameter.alarm_watch == 1;
+}
+
+bool isEepromListValid(void)
+{
+    return true;
+}
+
+void saveConfig(void) {}
+
+void loadConfig(void) {}
+
+bool initializeParameterList(void)
+{
+    return true;
+}
+
+void logParameterList(const char *) {}
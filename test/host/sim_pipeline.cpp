@@ -0,0 +1,92 @@
+/*
+ * File         test/host/sim_pipeline.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Runs the measurement pipeline on the host at accelerated
+ *              speed with a recorded trace or the generated room trace and
+ *              reports the storage results; see "make host-sim".
+ *
+ *    Usage:    sim_pipeline [days] [trace file (CSV or binary, see tracesource.h)]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include "benchmark.h"
+#include "flashlog.h"
+#include "archive.h"
+#include "pipeline.h"
+
+
+static const char *SIM_FS_ROOT = ".host_build/fs_sim";
+
+// copies a trace of the PC to LittleFS
+static bool copyTrace(const char *source, const char *path)
+{
+    std::ifstream input(source, std::ios::binary);
+    if (!input)
+    {
+        return false;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    File file = LittleFS.open(path, "w");
+    return file && file.write((const uint8_t *)data.data(), data.size()) == data.size();
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t days = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 14;
+    days = days ? days : 14;
+    hostSetFsRoot(SIM_FS_ROOT, true);
+    if (argc > 2)
+    {
+        if (!copyTrace(argv[2], MEAS_TRACE_FILE))
+        {
+            std::printf("ERROR: trace %s not readable!\n", argv[2]);
+            return 1;
+        }
+    }
+    else
+    {
+        // one day of the room trace at the normal sampling interval, replayed again and again
+        writeCsvTrace(MEAS_TRACE_FILE, generateTrace(Trace_t::ROOM, 86400 / TIME_MEASUREMENT_DISTANCE,
+                                                     TIME_MEASUREMENT_DISTANCE));
+    }
+
+    hostSetSerialOutput(false);
+    auto start = std::chrono::steady_clock::now();
+    beginPipeline(1600000000);
+    runPipeline(days * 86400);
+    saveMeasBuffer();
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+
+    FSInfo info;
+    LittleFS.info(info);
+    double mean = 0.0;
+    for (const measValue_t &value : g_ringbuffer)
+    {
+        mean += value.temperature;
+    }
+    mean = g_ringbuffer.size() ? mean / g_ringbuffer.size() / TEMP_CENTI_SCALE : 0.0;
+
+    std::printf("pipeline: %s, %u sensors, %u days\n", g_temp_meas.getSourceName(), g_temp_meas.getSensorCount(),
+                days);
+    printResult("wall time", wall.count(), "s");
+    printResult("speedup", days * 86400.0 / wall.count(), "x real time");
+    printResult("samples", g_pipeline_stats.samples, "");
+    printResult("dropped samples", g_sampler.getDroppedSamples(), "");
+    printResult("governor level changes", g_temp_meas.getLevelChanges(), "");
+    printResult("store windows", g_pipeline_stats.stored, "");
+    printResult("values skipped by the deadband", getSkippedValues(), "");
+    printResult("measurement buffer", g_ringbuffer.size(), "values");
+    printResult("measurement buffer RAM", getMeasBufferMemory(), "byte");
+    printResult("mean of the buffer", mean, "°C");
+    printResult("hourly rollups", g_rollup_hourly.size(), "");
+    printResult("daily rollups", g_rollup_daily.size(), "");
+    printResult("flash log page writes", g_flashlog.getPageWrites(), "");
+    printResult("archive sealed days", g_archive.getSealedDays(), "");
+    printResult("LittleFS used", info.usedBytes, "byte");
+    return 0;
+}
@@ -0,0 +1,186 @@
+/*
+ * File         test/host/test_archive.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Tests of the archive: sealing of a day, compaction of a
+ *              finished month, failed writes, corrupt day files, retention.
+ */
+
+#include <LittleFS.h>
+#include <TimeLib.h>
+
+#include "archive.h"
+#include "hostcontrol.h"
+#include "measbuffer.hpp"
+#include "unittest.h"
+
+
+// 2020-01-01 00:00:00 UTC
+static const time_t START_TIME = 1577836800;
+static const time_t VALUE_INTERVAL = 360;
+static time_t g_next_value = START_TIME;
+
+// stores the values until the time, the temperature is the minute of the day
+static void storeValuesUntil(time_t end)
+{
+    for (; g_next_value < end; g_next_value += VALUE_INTERVAL)
+    {
+        storeMeasValue(measValue_t{g_next_value, (int16_t)(g_next_value % SECS_PER_DAY / 60), {}});
+    }
+}
+
+static time_t makeDate(int year, int month, int day)
+{
+    tmElements_t tm = {};
+    tm.Day = day;
+    tm.Month = month;
+    tm.Year = CalendarYrToTm(year);
+    return makeTime(tm);
+}
+
+// amount of values of an archived day, 0: not archived or unreadable
+static uint16_t readDay(time_t date)
+{
+    archiveReader_t reader;
+    if (!g_archive.openDay(date, reader))
+    {
+        return 0;
+    }
+    archiveValue_t values[50];
+    uint16_t count = 0;
+    uint16_t read;
+    while ((read = g_archive.readValues(reader, values, 50)) > 0)
+    {
+        for (uint16_t i = 0; i < read; i++)
+        {
+            CHECK_EQUAL(date + (count + i) * VALUE_INTERVAL, values[i].timestamp);
+        }
+        count += read;
+    }
+    reader.file.close();
+    return count;
+}
+
+static bool hasTempFiles(void)
+{
+    Dir dir = LittleFS.openDir(ARCHIVE_DIRECTORY);
+    while (dir.next())
+    {
+        if (dir.fileName().endsWith(".tmp"))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void testSeal(void)
+{
+    // a day is sealed with the first value of the next day
+    storeValuesUntil(makeDate(2020, 1, 2));
+    CHECK(!LittleFS.exists(ARCHIVE_DIRECTORY "/2020-01-01.arc"));
+    storeValuesUntil(makeDate(2020, 1, 2) + 1);
+    CHECK(LittleFS.exists(ARCHIVE_DIRECTORY "/2020-01-01.arc"));
+    CHECK_EQUAL(1, g_archive.getSealedDays());
+    CHECK_EQUAL(240, readDay(makeDate(2020, 1, 1)));
+
+    archiveDay_t day = {};
+    CHECK_EQUAL(1, g_archive.readDays([&](const archiveDay_t &element) { day = element; }));
+    CHECK_EQUAL(makeDate(2020, 1, 1), day.date);
+    CHECK_EQUAL(0, day.min);
+    CHECK_EQUAL(1434, day.max);
+    CHECK_EQUAL(717, day.avg);
+}
+
+static void testCompact(void)
+{
+    // the days of January are compacted into one month file with the first day of February
+    storeValuesUntil(makeDate(2020, 2, 1) + 1);
+    CHECK(LittleFS.exists(ARCHIVE_DIRECTORY "/2020-01.arc"));
+    CHECK(!LittleFS.exists(ARCHIVE_DIRECTORY "/2020-01-01.arc"));
+    CHECK(!LittleFS.exists(ARCHIVE_DIRECTORY "/2020-01-31.arc"));
+    CHECK_EQUAL(240, readDay(makeDate(2020, 1, 1)));
+    CHECK_EQUAL(240, readDay(makeDate(2020, 1, 31)));
+    CHECK_EQUAL(31, g_archive.readDays([](const archiveDay_t &) {}));
+    CHECK(!hasTempFiles());
+}
+
+static void testWriteFailure(void)
+{
+    // a full file system: the seal and the compaction fail, no data is removed
+    uint32_t sealed = g_archive.getSealedDays();
+    storeValuesUntil(makeDate(2020, 2, 29) + 1);
+    hostSetFsWriteLimit(1000);
+    storeValuesUntil(makeDate(2020, 3, 1) + 1);
+    CHECK_EQUAL(sealed + 28, g_archive.getSealedDays());
+    CHECK(!LittleFS.exists(ARCHIVE_DIRECTORY "/2020-02-29.arc"));
+    CHECK(!LittleFS.exists(ARCHIVE_DIRECTORY "/2020-02.arc"));
+    CHECK(LittleFS.exists(ARCHIVE_DIRECTORY "/2020-02-01.arc"));
+    CHECK(!hasTempFiles());
+    CHECK_EQUAL(240, readDay(makeDate(2020, 2, 28)));
+
+    // the compaction is repeated with the next day
+    hostSetFsWriteLimit(SIZE_MAX);
+    storeValuesUntil(makeDate(2020, 3, 2) + 1);
+    CHECK(LittleFS.exists(ARCHIVE_DIRECTORY "/2020-02.arc"));
+    CHECK(!LittleFS.exists(ARCHIVE_DIRECTORY "/2020-02-01.arc"));
+    CHECK_EQUAL(240, readDay(makeDate(2020, 2, 28)));
+    CHECK_EQUAL(0, readDay(makeDate(2020, 2, 29)));
+}
+
+static void testCorruptDay(void)
+{
+    storeValuesUntil(makeDate(2020, 3, 5) + 1);
+
+    // a bit error in the values of a day ..
+    File file = LittleFS.open(ARCHIVE_DIRECTORY "/2020-03-03.arc", "r+");
+    file.seek(file.size() - 1);
+    uint8_t data = file.read() ^ 0x01;
+    file.seek(file.size() - 1);
+    file.write(&data, 1);
+    file.close();
+    // .. and a short day file
+    file = LittleFS.open(ARCHIVE_DIRECTORY "/2020-03-04.arc", "r+");
+    file.truncate(file.size() / 2);
+    file.close();
+
+    // the compaction keeps the valid days only
+    storeValuesUntil(makeDate(2020, 4, 1) + 1);
+    CHECK(LittleFS.exists(ARCHIVE_DIRECTORY "/2020-03.arc"));
+    CHECK_EQUAL(240, readDay(makeDate(2020, 3, 2)));
+    CHECK_EQUAL(0, readDay(makeDate(2020, 3, 3)));
+    CHECK_EQUAL(0, readDay(makeDate(2020, 3, 4)));
+    CHECK_EQUAL(240, readDay(makeDate(2020, 3, 5)));
+}
+
+static void testRetention(void)
+{
+    // the month files older than ARCHIVE_RETENTION_MONTHS are deleted
+    uint32_t deleted = g_archive.getDeletedFiles();
+    g_next_value = makeDate(2021, 2, 1);
+    storeValuesUntil(makeDate(2021, 2, 1) + 1);
+    CHECK_EQUAL(deleted + 1, g_archive.getDeletedFiles());
+    CHECK(!LittleFS.exists(ARCHIVE_DIRECTORY "/2020-01.arc"));
+    CHECK(LittleFS.exists(ARCHIVE_DIRECTORY "/2020-02.arc"));
+
+    // a full file system deletes the oldest files, too
+    hostSetFsSize(0);
+    g_next_value = makeDate(2021, 2, 2);
+    storeValuesUntil(makeDate(2021, 2, 2) + 1);
+    CHECK(!LittleFS.exists(ARCHIVE_DIRECTORY "/2020-02.arc"));
+    CHECK(!LittleFS.exists(ARCHIVE_DIRECTORY "/2020-03.arc"));
+}
+
+int main()
+{
+    hostSetFsRoot(".host_build/fs_test_archive", true);
+    hostSetSerialOutput(false);
+    initMeasBuffer();
+    restoreMeasBuffer();
+    testSeal();
+    testCompact();
+    testWriteFailure();
+    testCorruptDay();
+    testRetention();
+    return TEST_RESULT();
+}
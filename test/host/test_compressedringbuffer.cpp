@@ -0,0 +1,129 @@
+/*
+ * File         test/host/test_compressedringbuffer.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Tests of the CompressedRingBuffer: read cache after the
+ *              start and after clear(), round trip of all encodings, drop
+ *              of the oldest block, lowerBound.
+ */
+
+#include <deque>
+
+#include "compressedringbuffer.hpp"
+#include "traces.h"
+#include "unittest.h"
+
+
+typedef CompressedRingBuffer<traceValue_t, 4, 64> TestBuffer_t;
+
+static void testFirstReadAfterStart(void)
+{
+    // the read cache must not be used before the first decode
+    TestBuffer_t buffer(traceValue_t{0, 0});
+    buffer.add({1600000000, 2150});
+    CHECK_EQUAL(1600000000, buffer.readFirst(0).timestamp);
+    CHECK_EQUAL(2150, buffer.readFirst(0).temperature);
+    CHECK_EQUAL(0, buffer.lowerBound(0));
+
+    TestBuffer_t buffer2(traceValue_t{0, 0});
+    buffer2.add({1600000000, 2150});
+    buffer2.add({1600000360, 2160});
+    buffer2.add({1600000720, 2170});
+    CHECK_EQUAL(1600000360, buffer2.readFirst(1).timestamp);
+    CHECK_EQUAL(2160, buffer2.readFirst(1).temperature);
+    CHECK_EQUAL(1600000720, buffer2.readFirst(2).timestamp);
+
+    TestBuffer_t buffer3(traceValue_t{0, 0});
+    buffer3.add({1600000000, 2150});
+    buffer3.add({1600000360, 2160});
+    CHECK_EQUAL(0, buffer3.lowerBound(0));
+    CHECK_EQUAL(1, buffer3.lowerBound(1600000001));
+    CHECK_EQUAL(2, buffer3.lowerBound(1600000361));
+}
+
+static void testReadAfterClear(void)
+{
+    TestBuffer_t buffer(traceValue_t{0, 0});
+    buffer.add({1600000000, 2150});
+    buffer.add({1600000360, 2160});
+    CHECK_EQUAL(1600000360, buffer.readFirst(1).timestamp);
+    buffer.clear();
+    CHECK(buffer.isEmpty());
+    buffer.add({1700000000, -500});
+    buffer.add({1700000015, -490});
+    CHECK_EQUAL(1700000015, buffer.readFirst(1).timestamp);
+    CHECK_EQUAL(1700000000, buffer.readFirst(0).timestamp);
+    CHECK_EQUAL(-500, buffer.readFirst(0).temperature);
+}
+
+static void testRoundTrip(void)
+{
+    // irregular distances and large steps use all prefix codes
+    TestBuffer_t buffer(traceValue_t{0, 0});
+    std::deque<traceValue_t> reference;
+    TraceRandom random(7);
+    time_t timestamp = 1600000000;
+    int16_t temperature = 2000;
+    for (int i = 0; i < 2000; i++)
+    {
+        uint32_t kind = random.next() % 8;
+        timestamp += kind < 5 ? 360 : kind < 6 ? 15 : kind < 7 ? 3600 : 200000;
+        int32_t step = kind < 4 ? 0 : kind < 6 ? (int32_t)(random.next() % 60) - 30 : (int32_t)(random.next() % 4000) - 2000;
+        temperature = (int16_t)(temperature + step);
+        buffer.add({timestamp, temperature});
+        reference.push_back({timestamp, temperature});
+        // the buffer drops whole blocks, the newest values must be kept
+        while (reference.size() > buffer.size())
+        {
+            reference.pop_front();
+        }
+    }
+    CHECK(buffer.isFull());
+    CHECK_EQUAL(reference.size(), buffer.size());
+
+    // sequential reads
+    size_t errors = 0;
+    for (size_t i = 0; i < reference.size(); i++)
+    {
+        const traceValue_t &value = buffer.readFirst(i);
+        errors += value.timestamp != reference[i].timestamp || value.temperature != reference[i].temperature;
+    }
+    CHECK_EQUAL(0, errors);
+
+    // random reads, readLast and iterators
+    errors = 0;
+    for (size_t i = 0; i < 500; i++)
+    {
+        size_t offset = random.next() % reference.size();
+        errors += buffer.readFirst(offset).timestamp != reference[offset].timestamp;
+        errors += buffer.readLast(offset).timestamp != reference[reference.size() - 1 - offset].timestamp;
+    }
+    CHECK_EQUAL(0, errors);
+    size_t offset = 0;
+    errors = 0;
+    for (const traceValue_t &value : buffer)
+    {
+        errors += value.temperature != reference[offset++].temperature;
+    }
+    CHECK_EQUAL(reference.size(), offset);
+    CHECK_EQUAL(0, errors);
+
+    // lowerBound of existing timestamps and of the gaps
+    errors = 0;
+    for (size_t i = 0; i < reference.size(); i += 7)
+    {
+        errors += buffer.lowerBound(reference[i].timestamp) != i;
+        errors += buffer.lowerBound(reference[i].timestamp + 1) != i + 1;
+    }
+    CHECK_EQUAL(0, errors);
+    CHECK_EQUAL(0, buffer.lowerBound(0));
+    CHECK_EQUAL(buffer.size(), buffer.lowerBound(reference.back().timestamp + 1));
+}
+
+int main()
+{
+    testFirstReadAfterStart();
+    testReadAfterClear();
+    testRoundTrip();
+    return TEST_RESULT();
+}
@@ -0,0 +1,70 @@
+/*
+ * File         test/host/test_fixedpoint.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Tests of the fixed point temperatures: conversions, rounding
+ *              and formatTemp() compared with the float formatting.
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "fixedpoint.hpp"
+#include "unittest.h"
+
+
+static bool isFormatted(int32_t centi, uint8_t decimals, const char *expected)
+{
+    char buf[TEMP_FORMAT_SIZE];
+    return std::strcmp(formatTemp(buf, centi, decimals), expected) == 0;
+}
+
+static void testConversion(void)
+{
+    CHECK_EQUAL(3, divRound(5, 2));
+    CHECK_EQUAL(-3, divRound(-5, 2));
+    CHECK_EQUAL(0, divRound(-4, 10));
+    // 21.5625 °C of the DS18B20 (1/16 °C)
+    CHECK_EQUAL(2156, fixedToCenti(rawToFixed(345)));
+    CHECK_EQUAL(-1006, fixedToCenti(rawToFixed(-161)));
+    CHECK_EQUAL(INT16_MAX, fixedToCenti(INT32_MAX / 128));
+    CHECK_EQUAL(celsiusToFixed(-0.5), centiToFixed(-50));
+
+    // the stored 1/100 °C of all 12 bit values of the DS18B20 keep the raw value
+    size_t errors = 0;
+    for (int16_t raw = -55 * 16; raw <= 125 * 16; raw++)
+    {
+        errors += divRound(centiToFixed(fixedToCenti(rawToFixed(raw))), TEMP_FIXED_SCALE / 16) != raw;
+    }
+    CHECK_EQUAL(0, errors);
+}
+
+static void testFormat(void)
+{
+    CHECK(isFormatted(2156, 2, "21.56"));
+    CHECK(isFormatted(2156, 1, "21.6"));
+    CHECK(isFormatted(2156, 0, "22"));
+    CHECK(isFormatted(5, 2, "0.05"));
+    CHECK(isFormatted(-5, 2, "-0.05"));
+    CHECK(isFormatted(-4, 1, "0.0"));
+    CHECK(isFormatted(-1006, 1, "-10.1"));
+    CHECK(isFormatted(0, 0, "0"));
+    CHECK(isFormatted(INT32_MIN + 1, 2, "-21474836.47"));
+
+    // 2 decimals are exact, equal to the float formatting of the range of the sensor
+    char expected[32];
+    size_t errors = 0;
+    for (int32_t centi = -5500; centi <= 12500; centi++)
+    {
+        std::snprintf(expected, sizeof(expected), "%.2f", centi / 100.0);
+        errors += !isFormatted(centi, 2, expected);
+    }
+    CHECK_EQUAL(0, errors);
+}
+
+int main()
+{
+    testConversion();
+    testFormat();
+    return TEST_RESULT();
+}
@@ -0,0 +1,155 @@
+/*
+ * File         test/host/test_flashlog.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Tests of the FlashLog: restore after a restart, torn page
+ *              writes at the end of the current segment, partial pages
+ *              completed in place.
+ */
+
+#include <LittleFS.h>
+#include <vector>
+
+#include "flashlog.h"
+#include "hostcontrol.h"
+#include "unittest.h"
+
+
+static std::vector<measValue_t> g_restored;
+
+static void restoreValue(const measValue_t &value)
+{
+    g_restored.push_back(value);
+}
+
+// writes values with the timestamps first .. first + count - 1
+static void addValues(FlashLog &log, time_t first, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        log.add(measValue_t{first + (time_t)i, (int16_t)i, {}});
+    }
+}
+
+// restarts the log and returns the amount of restored values in time order
+static size_t restart(FlashLog &log)
+{
+    g_restored.clear();
+    CHECK(log.begin());
+    size_t count = log.restore(&restoreValue);
+    for (size_t i = 1; i < g_restored.size(); i++)
+    {
+        CHECK(g_restored[i].timestamp > g_restored[i - 1].timestamp);
+    }
+    return count;
+}
+
+static size_t segmentSize(void)
+{
+    File file = LittleFS.open(FLASHLOG_DIRECTORY "/00.log", "r");
+    return file ? file.size() : 0;
+}
+
+static void testRestore(void)
+{
+    FlashLog log;
+    CHECK(log.begin());
+    addValues(log, 1000, 3 * FLASHLOG_PAGE_VALUES + 5);
+    log.flush();
+    CHECK_EQUAL(4, log.getPageWrites());
+    // 16 byte header and 18 byte values, see FLASHLOG_PAGE_VALUES
+    CHECK_EQUAL(4 * (16 + FLASHLOG_PAGE_VALUES * sizeof(measValue_t)), segmentSize());
+
+    FlashLog restarted;
+    CHECK_EQUAL(3 * FLASHLOG_PAGE_VALUES + 5, restart(restarted));
+}
+
+static void testTornPage(void)
+{
+    // a bit error in the last page of the current segment, e.g. an interrupted write
+    size_t position = segmentSize() - (16 + FLASHLOG_PAGE_VALUES * sizeof(measValue_t)) + 16;
+    File file = LittleFS.open(FLASHLOG_DIRECTORY "/00.log", "r+");
+    file.seek(position);
+    uint8_t data = file.read() ^ 0x01;
+    file.seek(position);
+    file.write(&data, 1);
+    file.close();
+
+    // the segment is used up to its last valid page, the next page starts a new segment
+    FlashLog log;
+    CHECK_EQUAL(3 * FLASHLOG_PAGE_VALUES, restart(log));
+    addValues(log, 2000, FLASHLOG_PAGE_VALUES);
+    CHECK(LittleFS.exists(FLASHLOG_DIRECTORY "/01.log"));
+
+    FlashLog restarted;
+    CHECK_EQUAL(4 * FLASHLOG_PAGE_VALUES, restart(restarted));
+    CHECK_EQUAL(2000 + FLASHLOG_PAGE_VALUES - 1, g_restored.back().timestamp);
+
+    // a partial page at the end of the current segment
+    file = LittleFS.open(FLASHLOG_DIRECTORY "/01.log", "a");
+    file.write((const uint8_t *)g_restored.data(), 100);
+    file.close();
+    FlashLog partial;
+    CHECK_EQUAL(4 * FLASHLOG_PAGE_VALUES, restart(partial));
+    addValues(partial, 3000, FLASHLOG_PAGE_VALUES);
+    FlashLog last;
+    CHECK_EQUAL(5 * FLASHLOG_PAGE_VALUES, restart(last));
+    CHECK_EQUAL(3000 + FLASHLOG_PAGE_VALUES - 1, g_restored.back().timestamp);
+}
+
+// size of all segment files [byte]
+static size_t logSize(void)
+{
+    size_t size = 0;
+    for (uint8_t segment = 0; segment < FLASHLOG_SEGMENTS; segment++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "%s/%02u.log", FLASHLOG_DIRECTORY, segment);
+        File file = LittleFS.open(name, "r");
+        size += file ? file.size() : 0;
+    }
+    return size;
+}
+
+static void testPartialPage(void)
+{
+    const size_t page_size = 16 + FLASHLOG_PAGE_VALUES * sizeof(measValue_t);
+    FlashLog log;
+    size_t restored = restart(log);
+    size_t size = logSize();
+
+    // the restart saves of a partial page use one page of the segment
+    addValues(log, 4000, 5);
+    log.flush();
+    CHECK_EQUAL(size + page_size, logSize());
+    FlashLog second;
+    CHECK_EQUAL(restored + 5, restart(second));
+    addValues(second, 4005, 5);
+    second.flush();
+    // a flush without new values does not write
+    second.flush();
+    CHECK_EQUAL(1, second.getPageWrites());
+    CHECK_EQUAL(size + page_size, logSize());
+
+    // the page is completed in place, the next values start the next page
+    FlashLog third;
+    CHECK_EQUAL(restored + 10, restart(third));
+    addValues(third, 4010, FLASHLOG_PAGE_VALUES - 10 + 1);
+    CHECK_EQUAL(1, third.getPageWrites());
+    CHECK_EQUAL(size + page_size, logSize());
+    third.flush();
+    CHECK_EQUAL(size + 2 * page_size, logSize());
+    FlashLog last;
+    CHECK_EQUAL(restored + FLASHLOG_PAGE_VALUES + 1, restart(last));
+    CHECK_EQUAL(4000 + FLASHLOG_PAGE_VALUES, g_restored.back().timestamp);
+}
+
+int main()
+{
+    hostSetFsRoot(".host_build/fs_test_flashlog", true);
+    hostSetSerialOutput(false);
+    testRestore();
+    testTornPage();
+    testPartialPage();
+    return TEST_RESULT();
+}
@@ -0,0 +1,373 @@
+/*
+ * File         test/host/test_meas.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Tests of the sample processing of the Measurement: store
+ *              window statistics, error values, spike filter, alarms, the
+ *              alarm watch mode and the levels of the sampling governor.
+ */
+
+#include <cstring>
+
+#include "hostcontrol.h"
+#include "meas.h"
+#include "unittest.h"
+
+
+// sensors without bus, the samples are given to processSample() directly
+class TestSource : public SensorSource
+{
+private:
+    uint8_t m_count; // amount of sensors
+
+public:
+    TestSource(uint8_t count) : m_count{count} {}
+
+    uint8_t begin(SerialCode_t *codes, uint8_t max_count) override
+    {
+        uint8_t count = m_count < max_count ? m_count : max_count;
+        for (uint8_t i = 0; i < count; i++)
+        {
+            const SerialCode_t code = {0x28, 1, 2, 3, 4, 5, i, 0};
+            std::memcpy(codes[i], code, sizeof(SerialCode_t));
+            codes[i][7] = crc8(codes[i], 7);
+        }
+        return count;
+    }
+    void startConversion(void) override {}
+    bool isConversionComplete(void) override { return true; }
+    uint32_t getConversionWait(uint8_t resolution) override { return 750 >> (12 - resolution); }
+    bool readScratchPad(const uint8_t *code, uint8_t *scratchpad) override { return false; }
+    void writeScratchPad(const uint8_t *code, uint8_t th, uint8_t tl, uint8_t config) override {}
+    uint8_t alarmSearch(SerialCode_t *codes, uint8_t max_count) override { return 0; }
+    const char *getName(void) override { return "test"; }
+};
+
+// sensors with a scratchpad: TH/TL/configuration registers and the alarm search of the DS18B20
+class WatchSource : public TestSource
+{
+public:
+    int16_t m_raw[2] = {20 * 16, 20 * 16};  // temperature [1/16 °C]
+    uint8_t m_registers[2][3] = {};         // TH, TL, configuration
+    uint32_t m_config_writes = 0;           // amount of scratchpad writes
+    uint32_t m_reads = 0;                   // amount of scratchpad reads
+
+    WatchSource() : TestSource(2) {}
+
+    bool readScratchPad(const uint8_t *code, uint8_t *scratchpad) override
+    {
+        uint8_t i = code[6];
+        m_reads++;
+        scratchpad[0] = m_raw[i] & 0xFF;
+        scratchpad[1] = (m_raw[i] >> 8) & 0xFF;
+        scratchpad[2] = m_registers[i][0];
+        scratchpad[3] = m_registers[i][1];
+        scratchpad[4] = m_registers[i][2];
+        scratchpad[5] = 0xFF;
+        scratchpad[6] = 0;
+        scratchpad[7] = 0x10;
+        scratchpad[8] = crc8(scratchpad, 8);
+        return true;
+    }
+    void writeScratchPad(const uint8_t *code, uint8_t th, uint8_t tl, uint8_t config) override
+    {
+        uint8_t i = code[6];
+        m_registers[i][0] = th;
+        m_registers[i][1] = tl;
+        m_registers[i][2] = config;
+        m_config_writes++;
+    }
+    uint8_t alarmSearch(SerialCode_t *codes, uint8_t max_count) override
+    {
+        // the integer part of the temperature is compared with TH/TL
+        SerialCode_t all[2];
+        begin(all, 2);
+        uint8_t count = 0;
+        for (uint8_t i = 0; i < 2 && count < max_count; i++)
+        {
+            int16_t integer = m_raw[i] >> 4;
+            if (integer <= (int8_t)m_registers[i][1] || integer >= (int8_t)m_registers[i][0])
+            {
+                std::memcpy(codes[count++], all[i], sizeof(SerialCode_t));
+            }
+        }
+        return count;
+    }
+};
+
+static TestSource g_test_source(1);
+static Measurement g_meas(g_test_source);
+static uint32_t g_sample_time = 1000;
+// two sensors for the governor
+static TestSource g_governor_source(2);
+static Measurement g_governor(g_governor_source);
+static uint32_t g_governor_time = 1000;
+// two sensors for the alarm watch mode
+static WatchSource g_watch_source;
+static Measurement g_watch(g_watch_source);
+
+// runs a conversion and the read of the sample after a tick interval
+static sample_t watchTick(void)
+{
+    hostAdvance(g_watch.getMeasInterval());
+    sample_t sample = {};
+    g_watch.meas();
+    CHECK(g_watch.readSample(sample));
+    g_watch.processSample(sample);
+    return sample;
+}
+
+// processes a raw value of the sensor [1/16 °C]
+static void addSample(int16_t raw)
+{
+    sample_t sample = {};
+    sample.time = g_sample_time;
+    sample.valid = 1;
+    sample.raw[0] = raw;
+    g_meas.processSample(sample);
+    g_sample_time += 1000;
+}
+
+// processes the raw values of the two sensors of the governor, raw1 < 0: no value of sensor 1
+static void addGovernorSample(int16_t raw0, int16_t raw1, uint32_t step)
+{
+    g_governor_time += step;
+    sample_t sample = {};
+    sample.time = g_governor_time;
+    sample.valid = raw1 < 0 ? 1 : 3;
+    sample.raw[0] = raw0;
+    sample.raw[1] = raw1;
+    g_governor.processSample(sample);
+}
+
+static void testWindow(void)
+{
+    // 21.0, 21.0625 .. 21.25 °C
+    for (int16_t raw = 336; raw <= 340; raw++)
+    {
+        addSample(raw);
+    }
+    CHECK_EQUAL(5, g_meas.getWindowSamples());
+    CHECK_EQUAL(2113, g_meas.getValue());
+    measQuality_t quality = g_meas.getQuality();
+    CHECK_EQUAL(2100, quality.min);
+    CHECK_EQUAL(2125, quality.max);
+    CHECK_EQUAL(9, quality.stddev);
+    CHECK_EQUAL(5, quality.valid);
+    CHECK_EQUAL(0, quality.rejected);
+
+    // an empty window returns the last value
+    g_meas.restartAverage();
+    CHECK_EQUAL(0, g_meas.getWindowSamples());
+    CHECK_EQUAL(2125, g_meas.getValue());
+}
+
+static void testErrorValues(void)
+{
+    uint32_t rejected = g_meas.getRejectedSamples();
+    addSample(340);
+    // disconnected sensor and the power on value after a brown out
+    addSample(-127 * 16);
+    addSample(85 * 16);
+    addSample(340);
+    CHECK_EQUAL(2, g_meas.getWindowSamples());
+    CHECK_EQUAL(2, g_meas.getQuality().rejected);
+    CHECK_EQUAL(rejected + 2, g_meas.getRejectedSamples());
+    CHECK_EQUAL(1, g_meas.getHealth().power_on);
+    CHECK_EQUAL(2125, g_meas.getQuality().max);
+    g_meas.restartAverage();
+}
+
+static void testSpike(void)
+{
+    // a single spike of +20 °C is removed by the sample filter
+    for (int i = 0; i < 10; i++)
+    {
+        addSample(i == 5 ? 340 + 20 * 16 : 340);
+    }
+    CHECK_EQUAL(10, g_meas.getWindowSamples());
+    CHECK_EQUAL(2125, g_meas.getQuality().max);
+    CHECK_EQUAL(2125, g_meas.getValue());
+    g_meas.restartAverage();
+}
+
+static void testAlarm(void)
+{
+    // the integer part of the temperature is compared with the thresholds
+    g_meas.setAlarm(true, 10, 30);
+    addSample(29 * 16 + 15);
+    CHECK(!g_meas.getAlarm().active);
+    addSample(30 * 16);
+    CHECK(g_meas.getAlarm().active);
+    addSample(30 * 16 + 8);
+    CHECK_EQUAL(1, g_meas.getAlarm().events);
+    addSample(25 * 16);
+    CHECK(!g_meas.getAlarm().active);
+    g_meas.setAlarm(false, 0, 0);
+    addSample(-40 * 16);
+    CHECK(!g_meas.getAlarm().active);
+    CHECK_EQUAL(1, g_meas.getAlarm().events);
+}
+
+static void testGovernorLevels(void)
+{
+    // a stable temperature slows down the sampling level by level, the
+    // second sample sets the reference of the stable band
+    CHECK(GovernorLevel_t::NORMAL == g_governor.getGovernorLevel());
+    addGovernorSample(320, 320, 1000);
+    addGovernorSample(320, 320, 1000);
+    CHECK(GovernorLevel_t::NORMAL == g_governor.getGovernorLevel());
+    for (int i = 0; i < GOVERNOR_STABLE_SAMPLES; i++)
+    {
+        addGovernorSample(320, 320, 1000);
+    }
+    CHECK(GovernorLevel_t::STABLE == g_governor.getGovernorLevel());
+    for (int i = 0; i < GOVERNOR_STABLE_SAMPLES; i++)
+    {
+        addGovernorSample(320, 320, 1000);
+    }
+    CHECK(GovernorLevel_t::IDLE == g_governor.getGovernorLevel());
+    CHECK_EQUAL(TIME_MEASUREMENT_DISTANCE * 1000 * 4, g_governor.getMeasInterval());
+    for (int i = 0; i < GOVERNOR_STABLE_SAMPLES; i++)
+    {
+        addGovernorSample(320, 320, 1000);
+    }
+    CHECK(GovernorLevel_t::IDLE == g_governor.getGovernorLevel());
+
+    // a fast change: 1 °C in 3 s
+    for (int16_t raw = 320; raw <= 336; raw += 4)
+    {
+        addGovernorSample(raw, 320, 1000);
+    }
+    CHECK(GovernorLevel_t::FAST == g_governor.getGovernorLevel());
+    CHECK(g_governor.getRateOfChange() >= GOVERNOR_FAST_RATE);
+    CHECK_EQUAL(TIME_MEASUREMENT_DISTANCE * 1000 / 3, g_governor.getMeasInterval());
+
+    // a slow change, but outside of the stable band: 0.25 °C/min
+    for (int i = 1; i <= 3; i++)
+    {
+        addGovernorSample(336 + 4 * i, 320, 60000);
+    }
+    CHECK(GovernorLevel_t::NORMAL == g_governor.getGovernorLevel());
+    CHECK(g_governor.getRateOfChange() < GOVERNOR_FAST_RATE);
+}
+
+static void testGovernorRate(void)
+{
+    // sensor 1 has no value for 2 min, its change of 0.25 °C is slow: the
+    // rate is measured since its own last value, not since the last sample
+    for (int i = 0; i <= 2 * GOVERNOR_STABLE_SAMPLES; i++)
+    {
+        addGovernorSample(340, 320, 1000);
+    }
+    CHECK(GovernorLevel_t::NORMAL != g_governor.getGovernorLevel());
+    for (int i = 0; i < 119; i++)
+    {
+        addGovernorSample(340, -1, 1000);
+    }
+    addGovernorSample(340, 324, 1000);
+    CHECK(GovernorLevel_t::FAST != g_governor.getGovernorLevel());
+    CHECK(g_governor.getRateOfChange() < GOVERNOR_FAST_RATE);
+}
+
+static void testAlarmWatch(void)
+{
+    // the thresholds are written with the next conversion, a sensor without
+    // alarm gets the limits
+    g_watch.begin();
+    g_watch.setAlarm(true, 10, 30, 0);
+    g_watch.setAlarmWatch(true, 60000);
+    CHECK_EQUAL(ALARM_WATCH_INTERVAL, g_watch.getMeasInterval());
+    sample_t sample = watchTick();
+    CHECK_EQUAL(2, g_watch_source.m_config_writes);
+    CHECK_EQUAL(30, g_watch_source.m_registers[0][0]);
+    CHECK_EQUAL(10, g_watch_source.m_registers[0][1]);
+    CHECK_EQUAL(0x7F, g_watch_source.m_registers[0][2]);
+    CHECK_EQUAL(INT8_MAX, (int8_t)g_watch_source.m_registers[1][0]);
+    CHECK_EQUAL(INT8_MIN, (int8_t)g_watch_source.m_registers[1][1]);
+    // the first tick is a full read of all sensors
+    CHECK(!sample.alarm_search);
+    CHECK_EQUAL(3, sample.valid);
+    CHECK_EQUAL(2, g_watch_source.m_reads);
+
+    // without alarm the ticks are searches only, one interval before the end
+    // of the full read interval all sensors are read again
+    uint32_t searches = g_watch.getAlarmSearches();
+    for (int i = 0; i < 10; i++)
+    {
+        sample = watchTick();
+        CHECK(sample.alarm_search);
+        CHECK_EQUAL(0, sample.valid);
+    }
+    CHECK_EQUAL(searches + 10, g_watch.getAlarmSearches());
+    CHECK_EQUAL(2, g_watch_source.m_reads);
+    sample = watchTick();
+    CHECK(!sample.alarm_search);
+    CHECK_EQUAL(4, g_watch_source.m_reads);
+    CHECK_EQUAL(2, g_watch_source.m_config_writes);
+
+    // a sensor with an alarm answers the search and is read alone
+    g_watch_source.m_raw[0] = 31 * 16;
+    sample = watchTick();
+    CHECK(sample.alarm_search);
+    CHECK_EQUAL(1, sample.alarm);
+    CHECK_EQUAL(1, sample.valid);
+    CHECK_EQUAL(5, g_watch_source.m_reads);
+    CHECK(g_watch.getAlarm(0).active);
+    CHECK_EQUAL(1, g_watch.getAlarm(0).events);
+    // the alarm ends if the sensor does not answer the search any more
+    g_watch_source.m_raw[0] = 20 * 16;
+    sample = watchTick();
+    CHECK_EQUAL(0, sample.alarm);
+    CHECK(!g_watch.getAlarm(0).active);
+
+    // a sensor reset restores TH/TL from its EEPROM, here without alarm: the
+    // sensor does not answer the searches, the full read finds it and the
+    // thresholds are written again
+    g_watch_source.m_registers[0][0] = 0x7F;
+    g_watch_source.m_registers[0][1] = 0x80;
+    while (watchTick().alarm_search)
+    {
+    }
+    CHECK_EQUAL(2, g_watch_source.m_config_writes);
+    watchTick();
+    CHECK_EQUAL(4, g_watch_source.m_config_writes);
+    CHECK_EQUAL(30, g_watch_source.m_registers[0][0]);
+    CHECK_EQUAL(10, g_watch_source.m_registers[0][1]);
+
+    // without the watch mode each tick reads all sensors, the governor sets the interval
+    g_watch.setAlarmWatch(false, 60000);
+    CHECK_EQUAL(TIME_MEASUREMENT_DISTANCE * 1000, g_watch.getMeasInterval());
+    searches = g_watch.getAlarmSearches();
+    uint32_t reads = g_watch_source.m_reads;
+    for (int i = 0; i < 5; i++)
+    {
+        sample = watchTick();
+        CHECK(!sample.alarm_search);
+        CHECK_EQUAL(3, sample.valid);
+    }
+    CHECK_EQUAL(searches, g_watch.getAlarmSearches());
+    CHECK_EQUAL(reads + 10, g_watch_source.m_reads);
+
+    // switched on again: the next tick is a full read
+    g_watch.setAlarmWatch(true, 60000);
+    CHECK(!watchTick().alarm_search);
+    CHECK(watchTick().alarm_search);
+}
+
+int main()
+{
+    hostSetSerialOutput(false);
+    g_meas.begin();
+    CHECK_EQUAL(1, g_meas.getSensorCount());
+    testWindow();
+    testErrorValues();
+    testSpike();
+    testAlarm();
+    testAlarmWatch();
+    g_governor.begin();
+    CHECK_EQUAL(2, g_governor.getSensorCount());
+    testGovernorLevels();
+    testGovernorRate();
+    return TEST_RESULT();
+}
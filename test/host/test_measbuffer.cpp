@@ -0,0 +1,155 @@
+/*
+ * File         test/host/test_measbuffer.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Tests of the timestamp search of the measurement buffer: empty
+ *              buffer, wrapped buffer and the repeated hour of local time;
+ *              deadband and heartbeat of the stored values.
+ */
+
+#include "hostcontrol.h"
+#include "measbuffer.hpp"
+#include "parameter.hpp"
+#include "unittest.h"
+
+
+// parameter list of the host, see shim/hostparameter.cpp
+extern ParameterList_t g_host_parameter;
+
+static const time_t START_TIME = 1600000000;
+static const time_t VALUE_INTERVAL = 360;
+
+static void testEmpty(void)
+{
+    CHECK_EQUAL(0, findMeasValue(START_TIME));
+    CHECK_EQUAL(0, getMeasStatistics(0, 0).count);
+    CHECK_EQUAL(0, getMeasStatistics(START_TIME, START_TIME + 3600).count);
+}
+
+static void testWrap(void)
+{
+    // the oldest values are dropped, offset 0 is the oldest value
+    time_t time = START_TIME;
+    for (int extra = 0; extra < 100; time += VALUE_INTERVAL)
+    {
+        storeMeasValue(measValue_t{time, (int16_t)((time - START_TIME) / VALUE_INTERVAL), {}});
+        extra += g_ringbuffer.readFirst().timestamp > START_TIME;
+    }
+    time_t first = g_ringbuffer.readFirst().timestamp;
+    int16_t first_value = (int16_t)((first - START_TIME) / VALUE_INTERVAL);
+
+    CHECK_EQUAL(0, findMeasValue(START_TIME));
+    CHECK_EQUAL(0, findMeasValue(first));
+    CHECK_EQUAL(1, findMeasValue(first + 1));
+    CHECK_EQUAL(g_ringbuffer.size() - 1, findMeasValue(g_ringbuffer.readLast().timestamp));
+    CHECK_EQUAL(g_ringbuffer.size(), findMeasValue(g_ringbuffer.readLast().timestamp + 1));
+    // values behind the physical end of the buffer
+    for (size_t offset = 0; offset < g_ringbuffer.size(); offset += 97)
+    {
+        CHECK_EQUAL(offset, findMeasValue(first + (time_t)offset * VALUE_INTERVAL));
+    }
+
+    aggregate_t stats = getMeasStatistics(first + 5 * VALUE_INTERVAL, first + 14 * VALUE_INTERVAL);
+    CHECK_EQUAL(10, stats.count);
+    CHECK_EQUAL(first_value + 5, stats.min);
+    CHECK_EQUAL(first_value + 14, stats.max);
+    // from > to
+    CHECK_EQUAL(0, getMeasStatistics(first + 9 * VALUE_INTERVAL, first).count);
+}
+
+static void testRepeatedHour(void)
+{
+    // end of the daylight saving time: the local time jumps back one hour
+    time_t last = g_ringbuffer.readLast().timestamp;
+    time_t back = last + VALUE_INTERVAL - 3600;
+    for (time_t time = back; time <= last + 3600; time += VALUE_INTERVAL)
+    {
+        storeMeasValue(measValue_t{time, 0, {}});
+    }
+    size_t size = g_ringbuffer.size();
+
+    // the times outside of the repeated hour are found exactly
+    CHECK_EQUAL(size - 30, findMeasValue(back));
+    CHECK_EQUAL(size - 10, findMeasValue(last + 1));
+    CHECK_EQUAL(size, findMeasValue(last + 3600 + 1));
+    // a time inside of it is found in one of the passes
+    time_t middle = back + 5 * VALUE_INTERVAL;
+    size_t offset = findMeasValue(middle);
+    CHECK(offset == size - 30 + 5 || offset == size - 20 + 5);
+    CHECK_EQUAL(middle, g_ringbuffer.readFirst(offset).timestamp);
+    CHECK(g_ringbuffer.readFirst(offset - 1).timestamp < middle);
+    // the window around the repeated hour contains both passes
+    CHECK_EQUAL(30, getMeasStatistics(back, last + 3600).count);
+}
+
+// values added to the measurement buffer, the buffer may be full
+static size_t addedValues(void)
+{
+    return getFirstValueNumber(0) + g_ringbuffer.size();
+}
+
+static void testDeadband(void)
+{
+    g_host_parameter.store_deadband = 0.5;
+    g_host_parameter.store_heartbeat = 60;
+    time_t time = g_ringbuffer.readLast().timestamp + VALUE_INTERVAL;
+    size_t added = addedValues();
+    uint32_t skipped = getSkippedValues();
+
+    // a change against the last stored value is stored
+    CHECK(storeWindowValue(0, measValue_t{time, 2000, {}}));
+    // changes below the deadband are skipped
+    CHECK(!storeWindowValue(0, measValue_t{time + VALUE_INTERVAL, 2010, {}}));
+    CHECK(!storeWindowValue(0, measValue_t{time + 2 * VALUE_INTERVAL, 2049, {}}));
+    CHECK(!storeWindowValue(0, measValue_t{time + 3 * VALUE_INTERVAL, 1951, {}}));
+    CHECK_EQUAL(added + 1, addedValues());
+    CHECK_EQUAL(skipped + 3, getSkippedValues());
+
+    // the last skipped value is stored before the changed value
+    time += 4 * VALUE_INTERVAL;
+    CHECK(storeWindowValue(0, measValue_t{time, 2050, {}}));
+    CHECK_EQUAL(added + 3, addedValues());
+    measValue_t before = g_ringbuffer.readFirst(g_ringbuffer.size() - 2);
+    CHECK_EQUAL(time - VALUE_INTERVAL, before.timestamp);
+    CHECK_EQUAL(1951, before.temperature);
+    CHECK_EQUAL(time, g_ringbuffer.readLast().timestamp);
+    CHECK_EQUAL(2050, g_ringbuffer.readLast().temperature);
+
+    // the heartbeat is measured from the last stored value, the skipped
+    // values are not stored again
+    added = addedValues();
+    time_t heartbeat = time + 3600;
+    size_t stored = 0;
+    for (time += VALUE_INTERVAL; time <= heartbeat; time += VALUE_INTERVAL)
+    {
+        stored += storeWindowValue(0, measValue_t{time, 2051, {}});
+    }
+    CHECK_EQUAL(1, stored);
+    CHECK_EQUAL(added + 1, addedValues());
+    CHECK_EQUAL(heartbeat, g_ringbuffer.readLast().timestamp);
+    CHECK(!storeWindowValue(0, measValue_t{time, 2051, {}}));
+
+    // a deadband of 0 stores all values
+    g_host_parameter.store_deadband = 0.0;
+    added = addedValues();
+    skipped = getSkippedValues();
+    for (int i = 1; i <= 5; i++)
+    {
+        CHECK(storeWindowValue(0, measValue_t{time + i * VALUE_INTERVAL, 2051, {}}));
+    }
+    CHECK_EQUAL(added + 5, addedValues());
+    CHECK_EQUAL(skipped, getSkippedValues());
+}
+
+int main()
+{
+    hostSetFsRoot(".host_build/fs_test_measbuffer", true);
+    hostSetSerialOutput(false);
+    initMeasBuffer();
+    restoreMeasBuffer();
+    testEmpty();
+    testWrap();
+    testRepeatedHour();
+    testDeadband();
+    return TEST_RESULT();
+}
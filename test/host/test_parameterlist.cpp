@@ -0,0 +1,86 @@
+/*
+ * File         test/host/test_parameterlist.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Tests of the per sensor parameter lists: entries of the list
+ *              and the parsing of valid and malformed alarm thresholds.
+ */
+
+#include <cstring>
+
+#include "parameterlist.h"
+#include "unittest.h"
+
+
+// parses the entry of a sensor, low and high are -1 if it is not valid
+static bool parse(const char *list, uint8_t sensor, int &low, int &high)
+{
+    int8_t low_value = -1;
+    int8_t high_value = -1;
+    bool valid = parseSensorAlarm(list, sensor, low_value, high_value);
+    low = valid ? low_value : -1;
+    high = valid ? high_value : -1;
+    return valid;
+}
+
+static void testListEntry(void)
+{
+    const char *list = "0.5,,-1.25";
+    CHECK(getListEntry(list, 0) == list);
+    CHECK_EQUAL(0, std::strcmp(getListEntry(list, 1), ",-1.25"));
+    CHECK_EQUAL(0, std::strcmp(getListEntry(list, 2), "-1.25"));
+    CHECK(getListEntry(list, 3) == nullptr);
+    CHECK_EQUAL(0, std::strcmp(getListEntry("", 0), ""));
+    CHECK(getListEntry("", 1) == nullptr);
+}
+
+static void testValidAlarms(void)
+{
+    int low, high;
+    CHECK(parse("10:30", 0, low, high));
+    CHECK_EQUAL(10, low);
+    CHECK_EQUAL(30, high);
+    CHECK(parse("10:30,-20:-5", 1, low, high));
+    CHECK_EQUAL(-20, low);
+    CHECK_EQUAL(-5, high);
+    // a sensor without thresholds between two sensors with thresholds
+    CHECK(!parse("10:30,,0:4", 1, low, high));
+    CHECK(parse("10:30,,0:4", 2, low, high));
+    CHECK_EQUAL(0, low);
+    CHECK_EQUAL(4, high);
+    // limited to the range of the sensor
+    CHECK(parse("-100:200", 0, low, high));
+    CHECK_EQUAL(-55, low);
+    CHECK_EQUAL(125, high);
+    CHECK(parse("+5:+6", 0, low, high));
+}
+
+static void testMalformedAlarms(void)
+{
+    int low, high;
+    const char *malformed[] = {
+        "", ",", ":", "10", "10:", ":30", "-5:", "x:30", "10:x", "10:30x", "10x:30",
+        "10:30:40", "10;30", "10 :30", "10:30 ", "1.5:30", "10,30",
+        // low >= high, also after the limitation
+        "30:10", "20:20", "130:140", "-60:-56",
+    };
+    for (const char *list : malformed)
+    {
+        CHECK(!parse(list, 0, low, high));
+    }
+    // behind the end of the list
+    CHECK(!parse("10:30", 1, low, high));
+    CHECK(!parse("10:30,", 1, low, high));
+    // a malformed entry does not affect the others
+    CHECK(!parse("10:,0:4", 0, low, high));
+    CHECK(parse("10:,0:4", 1, low, high));
+    CHECK(parse(",,0:4", 2, low, high));
+}
+
+int main()
+{
+    testListEntry();
+    testValidAlarms();
+    testMalformedAlarms();
+    return TEST_RESULT();
+}
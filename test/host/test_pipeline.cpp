@@ -0,0 +1,100 @@
+/*
+ * File         test/host/test_pipeline.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Runs the measurement pipeline with a trace for two simulated
+ *              days: sensor enumeration in setup(), timer driven sampling,
+ *              averages of the store windows, flash log and archive.
+ */
+
+#include "archive.h"
+#include "flashlog.h"
+#include "pipeline.h"
+#include "unittest.h"
+
+
+// sensor 0 steps through 20.0 .. 20.1875 °C, sensor 1 is constant with a dropout in each 10th record
+static void writeTrace(void)
+{
+    File file = LittleFS.open(MEAS_TRACE_FILE, "w");
+    file.print("time,sensor 0,sensor 1\n");
+    for (int i = 0; i < 1000; i++)
+    {
+        String line = String(i) + "," + String(20.0 + 0.0625 * (i % 4), 4) + "," + (i % 10 ? "25.5" : "") + "\n";
+        file.print(line);
+    }
+    file.close();
+}
+
+int main()
+{
+    // the trace is written after the static initialization, the sensors are enumerated by begin()
+    hostSetFsRoot(".host_build/fs_test_pipeline", true);
+    hostSetSerialOutput(false);
+    writeTrace();
+    CHECK_EQUAL(1, g_temp_meas.getSensorCount());
+
+    // a heap below the reserve gets the minimum buffer, not a buffer without memory
+    hostSetMaxFreeBlock(MEASBUFFER_HEAP_RESERVE / 2);
+    CHECK(initMeasBuffer());
+#ifndef MEASBUFFER_COMPRESSED
+    // the compressed buffer is static, the heap is used by the additional sensors only
+    CHECK_EQUAL(RINGBUFFER_MIN_SIZE, g_ringbuffer.content());
+#endif
+    hostSetMaxFreeBlock(40 * 1024);
+
+    beginPipeline(1600000000);
+    CHECK_EQUAL(2, g_temp_meas.getSensorCount());
+    CHECK(g_ringbuffer.isEmpty());
+    // the first store of an empty buffer waits for a processed sample
+    CHECK_EQUAL(0, g_temp_meas.getWindowSamples());
+
+    runPipeline(2 * 86400);
+    saveMeasBuffer();
+
+    // a store window each MEASURMENT_DOMAIN seconds, the first with the first sample
+    CHECK_EQUAL(2 * 86400 / MEASURMENT_DOMAIN, g_pipeline_stats.stored);
+    CHECK_EQUAL(g_pipeline_stats.stored, g_ringbuffer.size());
+    CHECK(g_pipeline_stats.samples >= 2 * 86400 / (TIME_MEASUREMENT_DISTANCE * 4));
+    CHECK_EQUAL(0, g_sampler.getDroppedSamples());
+
+    // the windows hold the mean of the steps, the dropouts of sensor 1 are not averaged;
+    // the compressed buffer does not keep the quality
+    size_t errors = 0;
+    for (const measValue_t &value : g_ringbuffer)
+    {
+        errors += value.temperature < 2000 || value.temperature > 2019;
+#ifndef MEASBUFFER_COMPRESSED
+        errors += value.quality.valid == 0;
+#endif
+    }
+    CHECK_EQUAL(0, errors);
+    CHECK_EQUAL(1600000000, g_ringbuffer.readFirst().timestamp);
+#ifndef MEASBUFFER_COMPRESSED
+    CHECK_EQUAL(1, g_ringbuffer.readFirst().quality.valid);
+#endif
+    CHECK_EQUAL(1600000000 + (g_ringbuffer.size() - 1) * MEASURMENT_DOMAIN, g_ringbuffer.readLast().timestamp);
+    // the first record of sensor 1 is a dropout, its buffer starts with the next store window
+    SensorBuffer_t *buffer = getSensorBuffer(1);
+    CHECK(buffer && buffer->size() == g_ringbuffer.size() - 1);
+    errors = 0;
+    for (const measValue_t &value : *buffer)
+    {
+        errors += value.temperature != 2550;
+    }
+    CHECK_EQUAL(0, errors);
+    aggregate_t stats = getSensorStatistics(1, 0, 0);
+    CHECK_EQUAL(buffer->size(), stats.count);
+    CHECK_EQUAL(2550, stats.min);
+    CHECK_EQUAL(2550, stats.max);
+    time_t from = buffer->readFirst().timestamp;
+    CHECK_EQUAL(10, getSensorStatistics(1, from, from + 9 * MEASURMENT_DOMAIN).count);
+    CHECK(g_temp_meas.getHealth(1).disconnects > 0);
+    CHECK_EQUAL(0, g_temp_meas.getHealth(0).disconnects);
+
+    // one flash log page per FLASHLOG_PAGE_VALUES values, the last page is written by saveMeasBuffer()
+    CHECK_EQUAL((g_ringbuffer.size() + FLASHLOG_PAGE_VALUES - 1) / FLASHLOG_PAGE_VALUES, g_flashlog.getPageWrites());
+    CHECK(LittleFS.exists(FLASHLOG_DIRECTORY));
+    CHECK_EQUAL(2, g_archive.getSealedDays());
+    return TEST_RESULT();
+}
@@ -0,0 +1,145 @@
+/*
+ * File         test/host/test_responsewriter.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Tests of the streaming response writer: chunks, a step larger
+ *              than the buffer with blocking writes and the re-rendered
+ *              printf() text, the lowest free heap within a chunk.
+ */
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include "hostcontrol.h"
+#include "responsewriter.h"
+#include "unittest.h"
+#include "WiFiClient.h"
+
+
+// sizes of the chunks behind the HTTP header, the data are appended to body
+static std::string dechunk(const std::string &response, std::string &sizes)
+{
+    std::string body;
+    size_t pos = response.find("\r\n\r\n") + 4;
+    while (pos < response.size())
+    {
+        size_t data = response.find("\r\n", pos);
+        size_t length = std::strtoul(response.c_str() + pos, nullptr, 16);
+        sizes += std::to_string(length) + " ";
+        body.append(response, data + 2, length);
+        pos = data + 2 + length + 2;
+    }
+    return body;
+}
+
+// sends the response like the web server
+static void sendAll(ResponseWriter &out)
+{
+    while (!out.send())
+    {
+    }
+}
+
+static void testChunks(void)
+{
+    std::shared_ptr<HostConnection> connection = std::make_shared<HostConnection>();
+    connection->window = 1 << 20;
+    WiFiClient client(connection);
+    ResponseWriter out;
+    out.begin(&client, "text/plain");
+    CHECK_EQUAL(0, connection->response.find("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n"));
+    out.print(F("temperature ")).printTemp(-505, 2).print(' ').print(-12).print(' ').print(34u);
+    out.endStep();
+    sendAll(out);
+    out.print("end");
+    out.end();
+    sendAll(out);
+
+    std::string sizes;
+    CHECK(dechunk(connection->response, sizes) == "temperature -5.05 -12 34end");
+    CHECK(sizes == "24 3 0 ");
+    CHECK_EQUAL(27, out.size());
+    CHECK_EQUAL(0, out.getBlockingWrites());
+}
+
+static void testOverflow(void)
+{
+    std::shared_ptr<HostConnection> connection = std::make_shared<HostConnection>();
+    connection->window = 1 << 20;
+    WiFiClient client(connection);
+    ResponseWriter out;
+    out.begin(&client, "text/plain");
+
+    // a printf() text that does not fit is sent behind the buffer with a
+    // blocking write, the text is written again into the empty buffer
+    std::string first(HTTP_BLOCK_SIZE - 24, 'a');
+    std::string second(100, 'b');
+    out.print(first.c_str());
+    out.printf("%s", second.c_str());
+    CHECK_EQUAL(1, out.getBlockingWrites());
+    CHECK(connection->response.find(std::string("3E8\r\n") + first + "\r\n") != std::string::npos);
+
+    // a text of the RAM larger than the buffer is sent in parts
+    std::string third(2 * HTTP_BLOCK_SIZE + 10, 'c');
+    out.print(third.c_str());
+    CHECK_EQUAL(3, out.getBlockingWrites());
+
+    // a printf() text larger than the buffer is cut
+    std::string fourth(HTTP_BLOCK_SIZE + 10, 'd');
+    out.printf("%s", fourth.c_str());
+    CHECK_EQUAL(4, out.getBlockingWrites());
+    out.end();
+    sendAll(out);
+
+    std::string sizes;
+    std::string body = dechunk(connection->response, sizes);
+    CHECK(body == first + second + third + fourth.substr(0, HTTP_BLOCK_SIZE));
+    CHECK(sizes == "1000 1024 1024 110 1024 0 ");
+    CHECK_EQUAL(body.size(), out.size());
+}
+
+static void testMinFreeHeap(void)
+{
+    std::shared_ptr<HostConnection> connection = std::make_shared<HostConnection>();
+    connection->window = 1 << 20;
+    WiFiClient client(connection);
+    ResponseWriter out;
+    hostSetMaxFreeBlock(32000);
+    out.begin(&client, "text/plain");
+    CHECK_EQUAL(36000, out.getMinFreeHeap());
+
+    // a low heap during a printf() within the chunk, the heap is free again
+    // at the end of the chunk
+    out.print("value ");
+    hostSetMaxFreeBlock(16000);
+    out.printf("%.3f", 1.25);
+    hostSetMaxFreeBlock(32000);
+    out.endStep();
+    sendAll(out);
+    CHECK_EQUAL(18000, out.getMinFreeHeap());
+
+    // a low heap during the blocking write of a step larger than the buffer
+    std::string text(HTTP_BLOCK_SIZE + 10, 'x');
+    out.print(text.substr(0, HTTP_BLOCK_SIZE).c_str());
+    hostSetMaxFreeBlock(8000);
+    out.print(text.substr(HTTP_BLOCK_SIZE).c_str());
+    hostSetMaxFreeBlock(32000);
+    out.end();
+    sendAll(out);
+    CHECK_EQUAL(9000, out.getMinFreeHeap());
+
+    // a new response starts with the current heap
+    out.begin(&client, "text/plain");
+    CHECK_EQUAL(36000, out.getMinFreeHeap());
+    hostSetMaxFreeBlock(40 * 1024);
+}
+
+int main()
+{
+    hostSetSerialOutput(false);
+    testChunks();
+    testOverflow();
+    testMinFreeHeap();
+    return TEST_RESULT();
+}
@@ -0,0 +1,114 @@
+/*
+ * File         test/host/test_ringbuffer.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Tests of the RingBuffer: spans and iterators of a wrapped
+ *              buffer, the overflow policies, external storage and a heap
+ *              buffer without memory.
+ */
+
+#include <algorithm>
+#include <vector>
+
+#include "miniringbuffer.hpp"
+#include "unittest.h"
+
+
+static void testSpans(void)
+{
+    RingBuffer<int, 5> buffer(0);
+    CHECK_EQUAL(0, buffer.firstSpan().size + buffer.secondSpan().size);
+    for (int i = 1; i <= 7; i++)
+    {
+        buffer.add(i);
+    }
+
+    // 3..7, the head is at index 2
+    CHECK_EQUAL(3, buffer.firstSpan().size);
+    CHECK_EQUAL(3, buffer.firstSpan().data[0]);
+    CHECK_EQUAL(2, buffer.secondSpan().size);
+    CHECK_EQUAL(7, buffer.secondSpan().data[1]);
+
+    int expected = 3;
+    for (int value : buffer)
+    {
+        CHECK_EQUAL(expected++, value);
+    }
+    CHECK_EQUAL(3, std::lower_bound(buffer.begin(), buffer.end(), 6).offset());
+    // offsets outside of the buffer wrap
+    CHECK_EQUAL(4, buffer.readFirst(6));
+}
+
+// elements given to the evict handler
+static std::vector<int> g_evicted;
+
+static void evictHandler(const int &value)
+{
+    g_evicted.push_back(value);
+}
+
+static void testOverflowPolicies(void)
+{
+    // a full buffer rejects the new elements, the oldest are kept
+    RingBuffer<int, 4, OverflowReject> reject(0);
+    for (int i = 1; i <= 4; i++)
+    {
+        CHECK(reject.add(i));
+    }
+    CHECK(!reject.add(5));
+    CHECK_EQUAL(4, reject.size());
+    CHECK_EQUAL(1, reject.readFirst());
+    CHECK_EQUAL(4, reject.readLast());
+
+    // the oldest element is given to the handler before it is overwritten
+    RingBuffer<int, 3, OverflowCallback<int>> callback(0);
+    callback.setEvictHandler(&evictHandler);
+    for (int i = 1; i <= 7; i++)
+    {
+        CHECK(callback.add(i));
+    }
+    CHECK(g_evicted == std::vector<int>({1, 2, 3, 4}));
+    CHECK_EQUAL(5, callback.readFirst());
+    CHECK_EQUAL(7, callback.readLast());
+    // no handler: the element is overwritten only
+    callback.setEvictHandler(nullptr);
+    CHECK(callback.add(8));
+    CHECK_EQUAL(4, g_evicted.size());
+    CHECK_EQUAL(6, callback.readFirst());
+}
+
+static void testExternalStorage(void)
+{
+    int memory[6];
+    RingBuffer<int, 8, OverflowOverwrite, ExternalStorage> buffer(0);
+    CHECK(!buffer.add(1));
+    CHECK(!buffer.assign(memory, 9));
+    CHECK(buffer.assign(memory, 6));
+    for (int i = 1; i <= 8; i++)
+    {
+        buffer.add(i);
+    }
+    CHECK_EQUAL(6, buffer.size());
+    CHECK_EQUAL(3, buffer.readFirst());
+    CHECK_EQUAL(8, memory[1]);
+}
+
+static void testNoMemory(void)
+{
+    RingBuffer<int, 100, OverflowOverwrite, HeapStorage> buffer(0);
+    CHECK_EQUAL(0, buffer.content());
+    CHECK(!buffer.add(1));
+    CHECK_EQUAL(0, buffer.size());
+    // no division by the capacity 0
+    CHECK_EQUAL(0, buffer.slot(5));
+    CHECK(buffer.begin() == buffer.end());
+}
+
+int main()
+{
+    testSpans();
+    testOverflowPolicies();
+    testExternalStorage();
+    testNoMemory();
+    return TEST_RESULT();
+}
@@ -0,0 +1,96 @@
+/*
+ * File         test/host/test_rollup.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Tests of the rollup tiers: rounded average and the close of
+ *              the day with the first value of the next day.
+ */
+
+#include "hostcontrol.h"
+#include "measbuffer.hpp"
+#include "rollup.hpp"
+#include "unittest.h"
+
+
+// 2020-01-01 00:00:00
+static const time_t START_TIME = 1577836800;
+
+static void testAverage(void)
+{
+    // 20.005 °C is rounded, not truncated
+    RollupTier<4> tier(3600);
+    tier.add(START_TIME, 2000);
+    tier.add(START_TIME + 360, 2001);
+    CHECK_EQUAL(2001, tier.current().avg);
+    tier.add(START_TIME + 3600, -2000);
+    tier.add(START_TIME + 3960, -2001);
+    CHECK_EQUAL(-2001, tier.current().avg);
+    tier.add(START_TIME + 4320, -2001);
+    CHECK_EQUAL(-2001, tier.current().avg);
+
+    // the weighted average of the closed periods
+    RollupTier<4> daily(24 * 3600);
+    daily.add(rollupValue_t{(uint32_t)START_TIME, 1000, 1000, 1000}, 2);
+    daily.add(rollupValue_t{(uint32_t)START_TIME + 3600, 1001, 1001, 1001}, 1);
+    CHECK_EQUAL(1000, daily.current().avg);
+    daily.add(rollupValue_t{(uint32_t)START_TIME + 7200, 1003, 1003, 1003}, 1);
+    CHECK_EQUAL(1001, daily.current().avg);
+}
+
+static void testClose(void)
+{
+    RollupTier<4> tier(24 * 3600);
+    CHECK(!tier.close(START_TIME));
+    tier.add(START_TIME + 3600, 1000);
+    CHECK(!tier.close(START_TIME + 24 * 3600 - 1));
+    CHECK(tier.close(START_TIME + 24 * 3600));
+    CHECK_EQUAL(1, tier.size());
+    CHECK_EQUAL(1, tier.closedCount());
+    CHECK(!tier.hasCurrent());
+    CHECK(!tier.close(START_TIME + 24 * 3600));
+}
+
+static void testDayClose(void)
+{
+    // values every 6 minutes, the temperature is the hour of the day
+    time_t time = START_TIME;
+    for (; time < START_TIME + 24 * 3600; time += 360)
+    {
+        storeMeasValue(measValue_t{time, (int16_t)(time % (24 * 3600) / 3600 * 100), {}});
+    }
+    CHECK_EQUAL(23, g_rollup_hourly.size());
+    CHECK_EQUAL(0, g_rollup_daily.size());
+
+    // the first value of the next day closes the day with all of its hours
+    storeMeasValue(measValue_t{time, 0, {}});
+    CHECK_EQUAL(24, g_rollup_hourly.size());
+    CHECK_EQUAL(1, g_rollup_daily.size());
+    rollupValue_t day = g_rollup_daily.readLast();
+    CHECK_EQUAL(START_TIME, day.timestamp);
+    CHECK_EQUAL(0, day.min);
+    CHECK_EQUAL(2300, day.max);
+    CHECK_EQUAL(1150, day.avg);
+    CHECK_EQUAL(240, g_rollup_daily.closedCount());
+    CHECK(!g_rollup_daily.hasCurrent());
+
+    // the first hour of the next day starts the next day
+    for (time += 360; time <= START_TIME + 25 * 3600; time += 360)
+    {
+        storeMeasValue(measValue_t{time, 100, {}});
+    }
+    CHECK_EQUAL(1, g_rollup_daily.size());
+    CHECK(g_rollup_daily.hasCurrent());
+    CHECK_EQUAL(START_TIME + 24 * 3600, g_rollup_daily.current().timestamp);
+}
+
+int main()
+{
+    hostSetFsRoot(".host_build/fs_test_rollup", true);
+    hostSetSerialOutput(false);
+    initMeasBuffer();
+    restoreMeasBuffer();
+    testAverage();
+    testClose();
+    testDayClose();
+    return TEST_RESULT();
+}
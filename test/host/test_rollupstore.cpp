@@ -0,0 +1,121 @@
+/*
+ * File         test/host/test_rollupstore.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Tests of the saved rollup tiers: save and load, CRC error,
+ *              values of the flash log restore that are already in the tiers.
+ */
+
+#include <LittleFS.h>
+#include <vector>
+
+#include "measbuffer.hpp"
+#include "rollupstore.h"
+#include "unittest.h"
+#include "hostcontrol.h"
+
+
+// midnight UTC, three stored days close two days
+static const time_t START_TIME = 1599955200;
+
+// copy of the closed periods and the current period of a tier
+template <size_t _NSIZE>
+static std::vector<rollupValue_t> readTier(RollupTier<_NSIZE> &tier)
+{
+    std::vector<rollupValue_t> values;
+    for (size_t i = 0; i < tier.size(); i++)
+    {
+        values.push_back(tier.readFirst(i));
+    }
+    values.push_back(tier.current());
+    return values;
+}
+
+static bool isEqual(const std::vector<rollupValue_t> &a, const std::vector<rollupValue_t> &b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        if (a[i].timestamp != b[i].timestamp || a[i].avg != b[i].avg || a[i].min != b[i].min || a[i].max != b[i].max)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// stores a value each 360 sec with a daily temperature cycle
+static time_t storeDays(time_t start, uint32_t days)
+{
+    time_t timestamp = start;
+    for (uint32_t i = 0; i < days * 240; i++, timestamp += 360)
+    {
+        measValue_t value = {timestamp, (int16_t)(2000 + (i % 240) * 2), {}};
+        value.quality.valid = 1;
+        storeMeasValue(value);
+    }
+    return timestamp;
+}
+
+static void testSaveLoad(void)
+{
+    time_t next = storeDays(START_TIME, 3);
+    CHECK_EQUAL(next - 360, g_rollup_store.getLastValue());
+    // a save per closed day
+    CHECK_EQUAL(2, g_rollup_store.getSaves());
+    CHECK(g_rollup_store.save());
+    CHECK(LittleFS.exists(ROLLUP_FILE));
+    CHECK(!LittleFS.exists(ROLLUP_TEMP_FILE));
+
+    std::vector<rollupValue_t> hourly = readTier(g_rollup_hourly);
+    std::vector<rollupValue_t> daily = readTier(g_rollup_daily);
+    CHECK_EQUAL(3 * 24, hourly.size());
+    CHECK_EQUAL(3, daily.size());
+    g_rollup_hourly.clear();
+    g_rollup_daily.clear();
+
+    CHECK(g_rollup_store.load());
+    CHECK(isEqual(hourly, readTier(g_rollup_hourly)));
+    CHECK(isEqual(daily, readTier(g_rollup_daily)));
+
+    // the values of the flash log restore up to the saved time are already in the tiers
+    measValue_t old_value = {next - 720, 4000, {}};
+    storeMeasValue(old_value);
+    CHECK(isEqual(hourly, readTier(g_rollup_hourly)));
+    measValue_t new_value = {next, 4000, {}};
+    storeMeasValue(new_value);
+    CHECK_EQUAL(4000, g_rollup_hourly.current().max);
+    CHECK_EQUAL(next, g_rollup_store.getLastValue());
+}
+
+static void testCrcError(void)
+{
+    CHECK(g_rollup_store.save());
+    File file = LittleFS.open(ROLLUP_FILE, "r+");
+    file.seek(file.size() - 2);
+    uint8_t data = file.read() ^ 0x01;
+    file.seek(file.size() - 2);
+    file.write(&data, 1);
+    file.close();
+
+    // a damaged file is not used, the tiers are empty
+    CHECK(!g_rollup_store.load());
+    CHECK_EQUAL(0, g_rollup_hourly.size());
+    CHECK_EQUAL(0, g_rollup_daily.size());
+
+    LittleFS.remove(ROLLUP_FILE);
+    CHECK(!g_rollup_store.load());
+}
+
+int main()
+{
+    hostSetFsRoot(".host_build/fs_test_rollupstore", true);
+    hostSetSerialOutput(false);
+    initMeasBuffer();
+    testSaveLoad();
+    testCrcError();
+    return TEST_RESULT();
+}
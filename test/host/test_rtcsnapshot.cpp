@@ -0,0 +1,113 @@
+/*
+ * File         test/host/test_rtcsnapshot.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Tests of the RTC snapshot: save and restore, CRC check,
+ *              reset reason and a restart before the buffer is restored.
+ */
+
+#include <TimeLib.h>
+#include <user_interface.h>
+
+#include "hostcontrol.h"
+#include "measbuffer.hpp"
+#include "rtcsnapshot.h"
+#include "unittest.h"
+
+
+static const time_t START_TIME = 1600000000;
+
+static void storeValues(time_t first, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        storeMeasValue(measValue_t{first + (time_t)i * 360, (int16_t)(2000 + i), {}});
+    }
+}
+
+// flips a bit of the snapshot in the RTC memory
+static void corruptSnapshot(uint32_t word)
+{
+    uint32_t data;
+    ESP.rtcUserMemoryRead(RTCSNAPSHOT_OFFSET + word, &data, sizeof(data));
+    data ^= 0x100;
+    ESP.rtcUserMemoryWrite(RTCSNAPSHOT_OFFSET + word, &data, sizeof(data));
+}
+
+static void testSaveBeforeRestore(void)
+{
+    // a WiFi timeout in setup() is before the restore, the snapshot of the
+    // last run is kept
+    uint32_t pattern[4] = {1, 2, 3, 4};
+    ESP.rtcUserMemoryWrite(RTCSNAPSHOT_OFFSET, pattern, sizeof(pattern));
+    CHECK(!isMeasBufferRestored());
+    saveMeasBuffer();
+    uint32_t data[4];
+    ESP.rtcUserMemoryRead(RTCSNAPSHOT_OFFSET, data, sizeof(data));
+    CHECK_EQUAL(1, data[0]);
+    CHECK_EQUAL(4, data[3]);
+}
+
+static void testRestore(void)
+{
+    storeValues(START_TIME, 40);
+    setTime(START_TIME + 40 * 360);
+    saveMeasBuffer();
+
+    // the restarted logger has lost the newest values
+    g_ringbuffer.clear();
+    storeValues(START_TIME, 30);
+    hostSetResetReason(REASON_SOFT_RESTART);
+    time_t utc_time = 0;
+    CHECK(g_rtc_snapshot.restore(utc_time));
+    CHECK(g_rtc_snapshot.isWarmStart());
+    CHECK(utc_time >= START_TIME + 40 * 360);
+    CHECK(utc_time <= START_TIME + 40 * 360 + 2);
+    CHECK_EQUAL(40, g_ringbuffer.size());
+    CHECK_EQUAL(START_TIME + 39 * 360, g_ringbuffer.readLast().timestamp);
+    CHECK_EQUAL(2039, g_ringbuffer.readLast().temperature);
+
+    // the snapshot is used only once
+    CHECK(!g_rtc_snapshot.restore(utc_time));
+    CHECK(!g_rtc_snapshot.isWarmStart());
+}
+
+static void testInvalidSnapshot(void)
+{
+    // a bit error in a value
+    saveMeasBuffer();
+    corruptSnapshot(20);
+    time_t utc_time = 0;
+    CHECK(!g_rtc_snapshot.restore(utc_time));
+
+    // the RTC memory is not valid after a power on or an external reset
+    saveMeasBuffer();
+    hostSetResetReason(REASON_DEFAULT_RST);
+    CHECK(!g_rtc_snapshot.restore(utc_time));
+    hostSetResetReason(REASON_EXT_SYS_RST);
+    CHECK(!g_rtc_snapshot.restore(utc_time));
+    // .. but after an exception
+    hostSetResetReason(REASON_EXCEPTION_RST);
+    CHECK(g_rtc_snapshot.restore(utc_time));
+
+    // a snapshot without a valid time restores the values, not the time
+    g_ringbuffer.clear();
+    storeValues(START_TIME, 30);
+    g_rtc_snapshot.save(false);
+    g_ringbuffer.clear();
+    CHECK(!g_rtc_snapshot.restore(utc_time));
+    CHECK_EQUAL(RTCSNAPSHOT_VALUES, g_ringbuffer.size());
+}
+
+int main()
+{
+    hostSetFsRoot(".host_build/fs_test_rtcsnapshot", true);
+    hostSetSerialOutput(false);
+    testSaveBeforeRestore();
+    initMeasBuffer();
+    restoreMeasBuffer();
+    CHECK(isMeasBufferRestored());
+    testRestore();
+    testInvalidSnapshot();
+    return TEST_RESULT();
+}
@@ -0,0 +1,93 @@
+/*
+ * File         test/host/test_sampler.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Tests of the timer driven sampling: the SPSC queue and the
+ *              jitter of the ticks over an interval change.
+ */
+
+#include "hostcontrol.h"
+#include "sampler.h"
+#include "spscqueue.hpp"
+#include "unittest.h"
+
+
+static void testQueue(void)
+{
+    SpscQueue<uint32_t, 8> queue;
+    uint32_t value = 0;
+    CHECK_EQUAL(7, queue.content());
+    CHECK(!queue.pop(value));
+
+    // one element is kept free, the 8th element is dropped
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        CHECK_EQUAL(i < 7, queue.push(i));
+    }
+    CHECK_EQUAL(7, queue.size());
+    CHECK_EQUAL(1, queue.dropped());
+    for (uint32_t i = 0; i < 7; i++)
+    {
+        CHECK(queue.pop(value));
+        CHECK_EQUAL(i, value);
+    }
+    CHECK(!queue.pop(value));
+    CHECK_EQUAL(0, queue.size());
+
+    // the indexes wrap, the order is kept
+    uint32_t next_push = 100;
+    uint32_t next_pop = 100;
+    bool ordered = true;
+    for (int round = 0; round < 100; round++)
+    {
+        for (int i = 0; i < round % 7 + 1; i++)
+        {
+            queue.push(next_push++);
+        }
+        CHECK_EQUAL(round % 7 + 1, queue.size());
+        while (queue.pop(value))
+        {
+            ordered = ordered && value == next_pop++;
+        }
+    }
+    CHECK(ordered);
+    CHECK_EQUAL(next_push, next_pop);
+    CHECK_EQUAL(1, queue.dropped());
+}
+
+static void testJitter(void)
+{
+    // the ticks at their due time have no jitter; micros() 0 is no tick
+    hostAdvance(1);
+    g_sampler.begin(1000);
+    hostAdvance(5000);
+    CHECK_EQUAL(0, g_sampler.getMaxJitter());
+    CHECK_EQUAL(0, g_sampler.getMeanJitter());
+
+    // a tick 2 ms late: a longer and a shorter interval
+    hostSetTickerLatency(2000);
+    hostAdvance(1000);
+    hostSetTickerLatency(0);
+    hostAdvance(1000);
+    CHECK_EQUAL(2000, g_sampler.getMaxJitter());
+    // 4000 us of 7 intervals
+    CHECK_EQUAL(571, g_sampler.getMeanJitter());
+
+    // the statistics are kept over an interval change, the first interval
+    // after the change is not measured
+    g_sampler.setInterval(2000);
+    CHECK_EQUAL(2000, g_sampler.getInterval());
+    CHECK_EQUAL(2000, g_sampler.getMaxJitter());
+    hostAdvance(4000);
+    CHECK_EQUAL(2000, g_sampler.getMaxJitter());
+    CHECK_EQUAL(500, g_sampler.getMeanJitter());
+}
+
+int main()
+{
+    hostSetFsRoot(".host_build/fs_test_sampler", true);
+    hostSetSerialOutput(false);
+    testQueue();
+    testJitter();
+    return TEST_RESULT();
+}
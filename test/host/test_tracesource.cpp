@@ -0,0 +1,137 @@
+/*
+ * File         test/host/test_tracesource.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Tests of the TraceSource: CSV and binary format, dropouts,
+ *              read ahead in loop() and replay restart at the trace end.
+ */
+
+#include <LittleFS.h>
+
+#include "tracesource.h"
+#include "unittest.h"
+
+
+// temperature of a sensor after a conversion, INT16_MIN: no presence pulse
+static int16_t readRaw(TraceSource &source, const SerialCode_t &code)
+{
+    uint8_t scratchpad[9];
+    if (!source.readScratchPad(code, scratchpad))
+    {
+        return INT16_MIN;
+    }
+    CHECK_EQUAL(SensorSource::crc8(scratchpad, 8), scratchpad[8]);
+    return (int16_t)(scratchpad[0] | scratchpad[1] << 8);
+}
+
+static void testCsvTrace(void)
+{
+    File file = LittleFS.open("/room.csv", "w");
+    file.print("time,living room,cellar\n# recorded 2026-10-01\n1600000000,21.5,12.0\n1600000015,21.5625,\n"
+               "1600000030,,12.125\n");
+    file.close();
+
+    // the file is opened by begin(), not by the constructor
+    TraceSource source("/room.csv");
+    SerialCode_t codes[MEAS_MAX_SENSORS];
+    CHECK_EQUAL(2, source.begin(codes, MEAS_MAX_SENSORS));
+
+    source.startConversion();
+    CHECK_EQUAL(21.5 * 16, readRaw(source, codes[0]));
+    CHECK_EQUAL(12.0 * 16, readRaw(source, codes[1]));
+
+    // an empty field is a dropout
+    source.readAhead();
+    source.startConversion();
+    CHECK_EQUAL(21.5625 * 16, readRaw(source, codes[0]));
+    CHECK_EQUAL(INT16_MIN, readRaw(source, codes[1]));
+    source.readAhead();
+    source.startConversion();
+    CHECK_EQUAL(INT16_MIN, readRaw(source, codes[0]));
+    CHECK_EQUAL(12.125 * 16, readRaw(source, codes[1]));
+    CHECK_EQUAL(3, source.getRecords());
+    CHECK_EQUAL(0, source.getRewinds());
+
+    // the trace is started again at its end
+    source.readAhead();
+    source.startConversion();
+    CHECK_EQUAL(21.5 * 16, readRaw(source, codes[0]));
+    CHECK_EQUAL(1, source.getRewinds());
+}
+
+static void testBinaryTrace(void)
+{
+    // the format is found by the header, not by the file name
+    File file = LittleFS.open("/cold.csv", "w");
+    const uint8_t header[] = {'T', 'R', 'C', '1', 3, 0, 0, 0};
+    file.write(header, sizeof(header));
+    const int16_t records[][3] = {{64, 80, -16}, {65, TraceSource::TRACE_DROPOUT, -17}};
+    for (const int16_t *record : records)
+    {
+        uint32_t time = 1600000000;
+        file.write((const uint8_t *)&time, sizeof(time));
+        file.write((const uint8_t *)record, 3 * sizeof(int16_t));
+    }
+    file.close();
+
+    TraceSource source("/cold.csv");
+    SerialCode_t codes[2];
+    // the sensors above max_count are skipped
+    CHECK_EQUAL(2, source.begin(codes, 2));
+    source.startConversion();
+    CHECK_EQUAL(64, readRaw(source, codes[0]));
+    CHECK_EQUAL(80, readRaw(source, codes[1]));
+    source.readAhead();
+    source.startConversion();
+    CHECK_EQUAL(65, readRaw(source, codes[0]));
+    CHECK_EQUAL(INT16_MIN, readRaw(source, codes[1]));
+}
+
+static void testReadAhead(void)
+{
+    File file = LittleFS.open("/steps.csv", "w");
+    file.print("0,10.0\n1,11.0\n2,12.0\n");
+    file.close();
+
+    TraceSource source("/steps.csv");
+    SerialCode_t codes[1];
+    CHECK_EQUAL(1, source.begin(codes, 1));
+    source.startConversion();
+    CHECK_EQUAL(10 * 16, readRaw(source, codes[0]));
+
+    // a conversion without a read ahead keeps the last values
+    source.startConversion();
+    CHECK_EQUAL(10 * 16, readRaw(source, codes[0]));
+    CHECK_EQUAL(1, source.getRepeats());
+
+    // a record is read once, a second read ahead waits for the conversion
+    source.readAhead();
+    source.readAhead();
+    source.startConversion();
+    CHECK_EQUAL(11 * 16, readRaw(source, codes[0]));
+    source.readAhead();
+    source.startConversion();
+    CHECK_EQUAL(12 * 16, readRaw(source, codes[0]));
+    CHECK_EQUAL(1, source.getRepeats());
+}
+
+static void testMissingTrace(void)
+{
+    TraceSource source("/missing.csv");
+    SerialCode_t codes[1];
+    CHECK_EQUAL(0, source.begin(codes, 1));
+    source.readAhead();
+    source.startConversion();
+    CHECK_EQUAL(0, source.getRecords());
+}
+
+int main()
+{
+    hostSetFsRoot(".host_build/fs_test_tracesource", true);
+    hostSetSerialOutput(false);
+    testCsvTrace();
+    testBinaryTrace();
+    testReadAhead();
+    testMissingTrace();
+    return TEST_RESULT();
+}
@@ -0,0 +1,255 @@
+/*
+ * File         test/host/test_webserver.cpp
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Tests of the web server: chunked responses, time window
+ *              parameters, slow clients, refused clients, timeouts and rows
+ *              continued over the steps.
+ */
+
+#include <cstdlib>
+#include <string>
+
+#include "hostcontrol.h"
+#include "measbuffer.hpp"
+#include "traces.h"
+#include "timehelper.h"
+#include "unittest.h"
+#include "webserver.hpp"
+#include "WiFiClient.h"
+
+
+// runs the server until the response is complete, the window is refilled
+// with each loop pass
+static void runServer(HostConnection &connection, size_t window)
+{
+    for (int pass = 0; pass < 100000 && connection.server_open; pass++)
+    {
+        connection.window = window;
+        g_prj_web_server.processClient();
+    }
+}
+
+// body of a chunked response, empty if the response is not complete
+static std::string dechunk(const std::string &response)
+{
+    size_t header_end = response.find("\r\n\r\n");
+    if (header_end == std::string::npos)
+    {
+        return std::string();
+    }
+    std::string body;
+    size_t pos = header_end + 4;
+    for (;;)
+    {
+        // chunk: size line, data, CRLF
+        size_t data = response.find("\r\n", pos);
+        size_t length = std::strtoul(response.c_str() + pos, nullptr, 16);
+        if (data == std::string::npos || data + 2 + length + 2 > response.size())
+        {
+            return std::string();
+        }
+        if (!length)
+        {
+            return body;
+        }
+        body.append(response, data + 2, length);
+        pos = data + 2 + length + 2;
+    }
+}
+
+static void testResponse(void)
+{
+    int pages = g_prj_web_server.getRequestedPages();
+    std::shared_ptr<HostConnection> connection = hostConnect("GET /stats?range=24 HTTP/1.1\r\n\r\n", 1 << 20);
+    runServer(*connection, 1 << 20);
+    CHECK(!connection->server_open);
+    CHECK_EQUAL(0, connection->response.find("HTTP/1.1 200 OK\r\n"));
+    CHECK(connection->response.find("application/json") != std::string::npos);
+    std::string body = dechunk(connection->response);
+    CHECK_EQUAL('{', body[0]);
+    CHECK(body.find("\"count\"") != std::string::npos);
+    CHECK(body.find("{\"sensor\":\"") == 0);
+    CHECK_EQUAL(pages + 1, g_prj_web_server.getRequestedPages());
+
+    // an unknown page gets the page of the unknown requests
+    std::shared_ptr<HostConnection> unknown = hostConnect("GET /unknown HTTP/1.1\r\n\r\n", 1 << 20);
+    runServer(*unknown, 1 << 20);
+    CHECK_EQUAL(0, unknown->response.find("HTTP/1.1 404 Not Found\r\n"));
+    CHECK(!dechunk(unknown->response).empty());
+
+    // a page of an unknown sensor, too
+    std::shared_ptr<HostConnection> sensor = hostConnect("GET /stats?sensor=0123456789abcdef HTTP/1.1\r\n\r\n", 1 << 20);
+    runServer(*sensor, 1 << 20);
+    CHECK_EQUAL(0, sensor->response.find("HTTP/1.1 404 Not Found\r\n"));
+    CHECK(dechunk(sensor->response).find("\"count\"") == std::string::npos);
+}
+
+// body of the response of a request
+static std::string request(const char *text)
+{
+    std::shared_ptr<HostConnection> connection = hostConnect(text, 1 << 20);
+    runServer(*connection, 1 << 20);
+    return dechunk(connection->response);
+}
+
+static void testTimeParameters(void)
+{
+    CHECK_EQUAL(1600000000, convertIso8601ToEpoch("1600000000"));
+    CHECK_EQUAL(1614556800, convertIso8601ToEpoch("2021-03-01"));
+    CHECK_EQUAL(1614601845, convertIso8601ToEpoch("2021-03-01T12%3A30%3A45"));
+    CHECK_EQUAL(1614601845, convertIso8601ToEpoch("2021-03-01+12:30:45"));
+    // not valid dates
+    CHECK_EQUAL(0, convertIso8601ToEpoch("2021-02-30"));
+    CHECK_EQUAL(0, convertIso8601ToEpoch("2021-13-01"));
+    CHECK_EQUAL(0, convertIso8601ToEpoch("2021-03-01 24:00"));
+    CHECK_EQUAL(0, convertIso8601ToEpoch("1969-12-31"));
+    CHECK_EQUAL(0, convertIso8601ToEpoch("2021-03"));
+    CHECK_EQUAL(0, convertIso8601ToEpoch("today"));
+
+    // a not valid time is no limit
+    std::string all = request("GET /stats HTTP/1.1\r\n\r\n");
+    CHECK(all.find("\"count\":1000,") != std::string::npos);
+    CHECK(request("GET /stats?from=2021-02-30 HTTP/1.1\r\n\r\n") == all);
+
+    // from > to
+    time_t first = g_ringbuffer.readFirst().timestamp;
+    time_t last = g_ringbuffer.readLast().timestamp;
+    std::string inverted = "GET /stats?from=" + std::to_string(last) + "&to=" + std::to_string(first) + " HTTP/1.1\r\n\r\n";
+    CHECK(request(inverted.c_str()).find("\"count\":0}") != std::string::npos);
+    std::string window = "GET /stats?from=" + std::to_string(first) + "&to=" + std::to_string(first + 3600) + " HTTP/1.1\r\n\r\n";
+    CHECK(request(window.c_str()).find("\"count\":11,") != std::string::npos);
+
+    // a range larger than the buffer has all values, no overflow
+    CHECK(request("GET /stats?range=100000 HTTP/1.1\r\n\r\n").find("\"count\":1000,") != std::string::npos);
+    CHECK(request("GET /stats?range=2147483647 HTTP/1.1\r\n\r\n").find("\"count\":1000,") != std::string::npos);
+    CHECK(request("GET /stats?range=-5 HTTP/1.1\r\n\r\n") == all);
+}
+
+static void testSlowClient(void)
+{
+    // the response of a client with a small window is the same
+    std::shared_ptr<HostConnection> fast = hostConnect("GET /measval.js HTTP/1.1\r\n\r\n", 1 << 20);
+    runServer(*fast, 1 << 20);
+    std::shared_ptr<HostConnection> slow = hostConnect("GET /measval.js HTTP/1.1\r\n\r\n", 100);
+    runServer(*slow, 100);
+    std::string body = dechunk(fast->response);
+    CHECK(body.size() > 10000);
+    CHECK(body == dechunk(slow->response));
+}
+
+static void testConnections(void)
+{
+    // the connections are served in parallel, a client above the limit is refused
+    uint32_t refused = g_prj_web_server.getRefusedClients();
+    std::shared_ptr<HostConnection> connections[WEB_MAX_CONNECTIONS + 1];
+    for (std::shared_ptr<HostConnection> &connection : connections)
+    {
+        connection = hostConnect("GET /measval.js HTTP/1.1\r\n\r\n", 100);
+        g_prj_web_server.processClient();
+    }
+    CHECK_EQUAL(refused + 1, g_prj_web_server.getRefusedClients());
+    CHECK(!connections[WEB_MAX_CONNECTIONS]->server_open);
+    CHECK(connections[WEB_MAX_CONNECTIONS]->response.empty());
+    for (size_t i = 0; i < WEB_MAX_CONNECTIONS; i++)
+    {
+        CHECK(connections[i]->server_open);
+        CHECK(!connections[i]->response.empty());
+    }
+    for (size_t i = 0; i < WEB_MAX_CONNECTIONS; i++)
+    {
+        runServer(*connections[i], 100);
+        CHECK(!dechunk(connections[i]->response).empty());
+    }
+
+    // a client that closes the connection during the response frees it
+    std::shared_ptr<HostConnection> closed = hostConnect("GET /measval.js HTTP/1.1\r\n\r\n", 100);
+    g_prj_web_server.processClient();
+    closed->client_open = false;
+    g_prj_web_server.processClient();
+    CHECK(!closed->server_open);
+}
+
+static void testTimeout(void)
+{
+    // a request line without end is stopped after WEB_REQUEST_TIMEOUT
+    uint32_t timeouts = g_prj_web_server.getTimeouts();
+    std::shared_ptr<HostConnection> connection = hostConnect("GET /measv", 1 << 20);
+    g_prj_web_server.processClient();
+    hostAdvance(WEB_REQUEST_TIMEOUT / 2);
+    g_prj_web_server.processClient();
+    CHECK(connection->server_open);
+    hostAdvance(WEB_REQUEST_TIMEOUT);
+    g_prj_web_server.processClient();
+    CHECK(!connection->server_open);
+    CHECK(connection->response.empty());
+    CHECK_EQUAL(timeouts + 1, g_prj_web_server.getTimeouts());
+
+    // a client that does not take a step of the response within WEB_SEND_TIMEOUT
+    std::shared_ptr<HostConnection> stalled = hostConnect("GET /measval.js HTTP/1.1\r\n\r\n", 100);
+    g_prj_web_server.processClient();
+    g_prj_web_server.processClient();
+    CHECK(!stalled->response.empty());
+    stalled->window = 0;
+    hostAdvance(WEB_SEND_TIMEOUT + 1000);
+    g_prj_web_server.processClient();
+    CHECK(!stalled->server_open);
+    CHECK_EQUAL(timeouts + 2, g_prj_web_server.getTimeouts());
+}
+
+// amount of JSON rows of a measval.js body
+static size_t countRows(const std::string &body)
+{
+    size_t rows = 0;
+    for (size_t pos = body.find("\r\n["); pos != std::string::npos; pos = body.find("\r\n[", pos + 1))
+    {
+        rows++;
+    }
+    return rows;
+}
+
+static void testRepeatedTimestamps(void)
+{
+    // local time repeats at the end of the daylight saving time, the rows
+    // with the same timestamp are continued over the steps
+    time_t last = g_ringbuffer.readLast().timestamp;
+    for (int i = 0; i < 50; i++)
+    {
+        storeMeasValue(measValue_t{last + 360, (int16_t)(2000 + i), {}});
+    }
+    std::shared_ptr<HostConnection> connection = hostConnect("GET /measval.js?range=1 HTTP/1.1\r\n\r\n", 100);
+    for (int pass = 0; pass < 10; pass++)
+    {
+        connection->window = 100;
+        g_prj_web_server.processClient();
+    }
+    CHECK(connection->server_open);
+
+    // a value stored during the response does not move the time window
+    storeMeasValue(measValue_t{last + 3 * 3600, 2100, {}});
+    runServer(*connection, 100);
+    std::string body = dechunk(connection->response);
+    CHECK_EQUAL(10 + 50 + 1, countRows(body));
+    CHECK(body.find("20.49") != std::string::npos);
+}
+
+int main()
+{
+    hostSetFsRoot(".host_build/fs_test_webserver", true);
+    hostSetSerialOutput(false);
+    initMeasBuffer();
+    restoreMeasBuffer();
+    // a range of an empty buffer
+    CHECK(request("GET /stats?range=24 HTTP/1.1\r\n\r\n").find("\"count\":0}") != std::string::npos);
+    for (const traceValue_t &value : generateTrace(Trace_t::ROOM, 1000, 360))
+    {
+        storeMeasValue(measValue_t{value.timestamp, value.temperature, {}});
+    }
+    testResponse();
+    testTimeParameters();
+    testSlowClient();
+    testConnections();
+    testTimeout();
+    testRepeatedTimestamps();
+    return TEST_RESULT();
+}
@@ -0,0 +1,119 @@
+/*
+ * File         test/host/traces.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Reproducible temperature traces of the host tests and
+ *              benchmarks, the values are quantized like a DS18B20 with
+ *              12 bit (1/16 °C) and stored in 1/100 °C.
+ *              - ROOM: living room, daily cycle of 3 °C, slow drift
+ *              - COLD_STORAGE: cold storage room at 4 °C, the compressor
+ *                cycles every 40 min, long flat periods
+ *              - OUTDOOR: daily cycle of 10 °C and weather changes
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+
+
+enum class Trace_t
+{
+    ROOM,
+    COLD_STORAGE,
+    OUTDOOR
+};
+
+// element of a trace
+typedef struct
+{
+    time_t timestamp;
+    int16_t temperature; // [1/100 °C]
+} traceValue_t;
+
+/// name of a trace for the benchmark output
+inline const char *getTraceName(Trace_t trace)
+{
+    switch (trace)
+    {
+    case Trace_t::ROOM:
+        return "room";
+    case Trace_t::COLD_STORAGE:
+        return "cold storage";
+    default:
+        return "outdoor";
+    }
+}
+
+/// xorshift generator, the traces are equal on each run
+class TraceRandom
+{
+private:
+    uint32_t m_state;
+
+public:
+    TraceRandom(uint32_t seed) : m_state{seed ? seed : 1} {}
+
+    uint32_t next(void)
+    {
+        m_state ^= m_state << 13;
+        m_state ^= m_state >> 17;
+        m_state ^= m_state << 5;
+        return m_state;
+    }
+
+    /// uniform value -1.0..1.0
+    double uniform(void)
+    {
+        return (next() & 0xffff) / 32767.5 - 1.0;
+    }
+};
+
+/**
+ * @brief Generates a trace of equidistant values
+ *
+ * @param trace kind of the trace
+ * @param count amount of values
+ * @param interval distance of the values [sec]
+ * @param start timestamp of the first value
+ * @return std::vector<traceValue_t> trace values
+ */
+inline std::vector<traceValue_t> generateTrace(Trace_t trace, size_t count, uint32_t interval = 360,
+                                               time_t start = 1600000000)
+{
+    std::vector<traceValue_t> values;
+    values.reserve(count);
+    TraceRandom random(12345);
+    double weather = 0.0;
+    for (size_t i = 0; i < count; i++)
+    {
+        time_t timestamp = start + (time_t)(i * interval);
+        double day = 2.0 * M_PI * (timestamp % 86400) / 86400.0;
+        double celsius;
+        switch (trace)
+        {
+        case Trace_t::ROOM:
+            celsius = 21.0 + 1.5 * std::sin(day) + 0.5 * std::sin(2.0 * M_PI * i / 5000.0);
+            break;
+        case Trace_t::COLD_STORAGE:
+            // saw tooth of the compressor, cooled down in 10 min
+            {
+                uint32_t cycle = timestamp % 2400;
+                celsius = cycle < 600 ? 5.0 - cycle / 600.0 : 4.0 + (cycle - 600) / 1800.0;
+            }
+            break;
+        default:
+            weather += 0.05 * random.uniform();
+            weather *= 0.999;
+            celsius = 12.0 + 5.0 * std::sin(day) + 20.0 * weather;
+            break;
+        }
+        // sensor noise and the 12 bit quantization
+        celsius += 0.04 * random.uniform();
+        double sixteenth = std::round(celsius * 16.0);
+        values.push_back({timestamp, (int16_t)std::lround(sixteenth * 100.0 / 16.0)});
+    }
+    return values;
+}
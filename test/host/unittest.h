@@ -0,0 +1,54 @@
+/*
+ * File         test/host/unittest.h
+ * Author       Heiko Klausing (h dot klausing at gmx dot de)
+ * Created      2026-10-17
+ * Note         Checks of the host tests, a test program prints the failed
+ *              checks and returns a nonzero exit code if a check failed.
+ *
+ *    Usage:    int main()
+ *              {
+ *                  CHECK(buffer.isEmpty());
+ *                  CHECK_EQUAL(1600000000L, (long)buffer.readFirst().timestamp);
+ *                  return TEST_RESULT();
+ *              }
+ */
+
+#pragma once
+
+#include <cstdio>
+
+
+static unsigned int g_checks = 0;
+static unsigned int g_failed_checks = 0;
+
+/// checks a condition
+#define CHECK(condition)                                                        \
+    do                                                                          \
+    {                                                                           \
+        g_checks++;                                                             \
+        if (!(condition))                                                       \
+        {                                                                       \
+            g_failed_checks++;                                                  \
+            std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+        }                                                                       \
+    } while (0)
+
+/// checks two integer values, both values are printed if they differ
+#define CHECK_EQUAL(expected, actual)                                           \
+    do                                                                          \
+    {                                                                           \
+        long long expected_value = (long long)(expected);                       \
+        long long actual_value = (long long)(actual);                           \
+        g_checks++;                                                             \
+        if (expected_value != actual_value)                                     \
+        {                                                                       \
+            g_failed_checks++;                                                  \
+            std::printf("%s:%d: %s: got %lld, want %lld\n", __FILE__, __LINE__, \
+                        #actual, actual_value, expected_value);                 \
+        }                                                                       \
+    } while (0)
+
+/// prints the summary, result of main()
+#define TEST_RESULT()                                                           \
+    (std::printf("%s: %u checks, %u failed\n", __FILE__, g_checks, g_failed_checks), \
+     g_failed_checks ? 1 : 0)